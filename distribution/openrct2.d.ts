@@ -5283,12 +5283,40 @@ declare global {
 
     interface Profiler {
         getData(): ProfiledFunction[];
+        /**
+         * Gets the current value of every metric, keyed by metric name.
+         * Unlike the profiled functions, metrics are always recorded.
+         */
+        getMetrics(): { [name: string]: Metric };
         start(): void;
         stop(): void;
         reset(): void;
         readonly enabled: boolean;
     }
 
+    type Metric = CounterMetric | GaugeMetric | HistogramMetric;
+
+    interface CounterMetric {
+        readonly type: "counter";
+        readonly value: number;
+    }
+
+    interface GaugeMetric {
+        readonly type: "gauge";
+        readonly value: number;
+    }
+
+    interface HistogramMetric {
+        readonly type: "histogram";
+        readonly count: number;
+        readonly min: number;
+        readonly max: number;
+        readonly mean: number;
+        readonly p50: number;
+        readonly p90: number;
+        readonly p99: number;
+    }
+
     interface ProfiledFunction {
         readonly name: string;
         readonly callCount: number;
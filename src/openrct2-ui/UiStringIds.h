@@ -418,6 +418,7 @@ namespace OpenRCT2
         STR_WEATHER_NATURE_CHEATS_TIP = 6666,
         STR_YEAR = 6196,
         STR_CHEAT_IGNORE_PRICE_TIP = 6660,
+        STR_CHEAT_FOOTPATH_GRAPH_PATHFINDING_TIP = 6711,
 
         // Window: Cheats -- weather
         STR_SUNNY = 5719,
@@ -0,0 +1,224 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace OpenRCT2::Ui
+{
+    /**
+     * The sorted items of a list window, e.g. the guests, staff or rides it shows.
+     *
+     * Each item keeps the sort key it was added with, such as its formatted name. A refresh walks the entities and
+     * keeps the items that are still listed with their key unchanged, so only new and changed items have their key
+     * computed and are sorted into place. The items can be filtered afterwards without losing their keys, so items that
+     * are filtered out do not have their key computed again when they are shown.
+     *
+     * @tparam TId An identifier with ToUnderlying(), e.g. EntityId or RideId.
+     * @tparam TKey The sort key stored with each item.
+     */
+    template<typename TId, typename TKey> class ListModel
+    {
+    public:
+        using CompareFunc = bool (*)(const TKey& a, const TKey& b);
+
+        struct Item
+        {
+            TId Id;
+            TKey Key;
+        };
+
+    private:
+        static constexpr uint32_t kNoIndex = std::numeric_limits<uint32_t>::max();
+
+        CompareFunc _compare{};
+        std::vector<Item> _items;
+        // The index in _items of each identifier, and whether the current refresh keeps it.
+        std::vector<uint32_t> _indices;
+        std::vector<bool> _kept;
+        std::vector<Item> _added;
+        // Whether each identifier is filtered out, and the indices in _items of the items shown in order.
+        std::vector<bool> _hidden;
+        std::vector<uint32_t> _shown;
+
+    public:
+        explicit ListModel(CompareFunc compare)
+            : _compare(compare)
+        {
+        }
+
+        // The number of items shown.
+        size_t size() const
+        {
+            return _shown.size();
+        }
+
+        bool empty() const
+        {
+            return _shown.empty();
+        }
+
+        // Returns the shown item at index.
+        const Item& operator[](size_t index) const
+        {
+            return _items[_shown[index]];
+        }
+
+        void Clear()
+        {
+            _items.clear();
+            _indices.clear();
+            _kept.clear();
+            _added.clear();
+            _hidden.clear();
+            _shown.clear();
+        }
+
+        // Changes the order of the items, sorting them again.
+        void SetCompare(CompareFunc compare)
+        {
+            if (_compare == compare)
+                return;
+
+            _compare = compare;
+            std::stable_sort(_items.begin(), _items.end(), GetItemCompare());
+            UpdateIndices();
+            UpdateShown();
+        }
+
+        // Returns the key of the listed item, or nullptr if it is not listed. Items that are filtered out are listed.
+        const TKey* Find(TId id) const
+        {
+            const auto index = GetIndex(id);
+            return index != kNoIndex ? &_items[index].Key : nullptr;
+        }
+
+        /**
+         * Starts a refresh. Every item that is still listed must be passed to Keep or Add before EndUpdate, the others
+         * are removed.
+         */
+        void BeginUpdate()
+        {
+            _kept.assign(_indices.size(), false);
+            _added.clear();
+        }
+
+        // Keeps the listed item with its current key.
+        void Keep(TId id)
+        {
+            const auto underlying = static_cast<size_t>(id.ToUnderlying());
+            if (underlying < _kept.size() && _indices[underlying] != kNoIndex)
+                _kept[underlying] = true;
+        }
+
+        // Lists a new item, or replaces the key of a listed one.
+        void Add(TId id, TKey&& key)
+        {
+            const auto underlying = static_cast<size_t>(id.ToUnderlying());
+            if (underlying < _kept.size())
+                _kept[underlying] = false;
+            _added.push_back({ id, std::move(key) });
+        }
+
+        // Removes the items that were not kept and sorts the added ones into place. All items are shown again.
+        void EndUpdate()
+        {
+            auto itRemoved = std::remove_if(_items.begin(), _items.end(), [this](const Item& item) {
+                const auto underlying = static_cast<size_t>(item.Id.ToUnderlying());
+                return !_kept[underlying];
+            });
+            _items.erase(itRemoved, _items.end());
+
+            if (!_added.empty())
+            {
+                const auto compare = GetItemCompare();
+                std::stable_sort(_added.begin(), _added.end(), compare);
+
+                const auto numKept = static_cast<std::ptrdiff_t>(_items.size());
+                _items.insert(
+                    _items.end(), std::make_move_iterator(_added.begin()), std::make_move_iterator(_added.end()));
+                std::inplace_merge(_items.begin(), _items.begin() + numKept, _items.end(), compare);
+                _added.clear();
+            }
+            UpdateIndices();
+            _hidden.clear();
+            UpdateShown();
+        }
+
+        // Shows only the listed items that pred returns true for, until the next update.
+        template<typename TPredicate> void Filter(TPredicate&& pred)
+        {
+            _hidden.assign(_indices.size(), false);
+            for (const auto& item : _items)
+            {
+                if (!pred(item))
+                    _hidden[static_cast<size_t>(item.Id.ToUnderlying())] = true;
+            }
+            UpdateShown();
+        }
+
+        /**
+         * Returns the range [first, last) of the shown items in rows of the given height that are at least partly
+         * inside the vertical range [top, bottom) of the scroll area, relative to the first item.
+         */
+        std::pair<size_t, size_t> GetVisibleRange(int32_t top, int32_t bottom, int32_t rowHeight) const
+        {
+            const auto first = static_cast<size_t>(std::max(0, top / rowHeight));
+            const auto last = static_cast<size_t>(std::max(0, (bottom + rowHeight - 1) / rowHeight));
+            return { std::min(first, _shown.size()), std::min(last, _shown.size()) };
+        }
+
+    private:
+        auto GetItemCompare() const
+        {
+            return [compare = _compare](const Item& a, const Item& b) {
+                if (compare(a.Key, b.Key))
+                    return true;
+                if (compare(b.Key, a.Key))
+                    return false;
+                return a.Id.ToUnderlying() < b.Id.ToUnderlying();
+            };
+        }
+
+        uint32_t GetIndex(TId id) const
+        {
+            const auto underlying = static_cast<size_t>(id.ToUnderlying());
+            return underlying < _indices.size() ? _indices[underlying] : kNoIndex;
+        }
+
+        void UpdateIndices()
+        {
+            std::fill(_indices.begin(), _indices.end(), kNoIndex);
+            for (size_t i = 0; i < _items.size(); i++)
+            {
+                const auto underlying = static_cast<size_t>(_items[i].Id.ToUnderlying());
+                if (underlying >= _indices.size())
+                    _indices.resize(underlying + 1, kNoIndex);
+                _indices[underlying] = static_cast<uint32_t>(i);
+            }
+        }
+
+        void UpdateShown()
+        {
+            _shown.clear();
+            for (size_t i = 0; i < _items.size(); i++)
+            {
+                const auto underlying = static_cast<size_t>(_items[i].Id.ToUnderlying());
+                if (underlying >= _hidden.size() || !_hidden[underlying])
+                    _shown.push_back(static_cast<uint32_t>(i));
+            }
+        }
+    };
+} // namespace OpenRCT2::Ui
@@ -132,6 +132,7 @@ enum WindowCheatsWidgetIdx
     WIDX_GUEST_IGNORE_PRICE,
     WIDX_DISABLE_VANDALISM,
     WIDX_DISABLE_LITTERING,
+    WIDX_GUEST_FOOTPATH_GRAPH_PATHFINDING,
 
     WIDX_STAFF_GROUP = WIDX_TAB_CONTENT,
     WIDX_STAFF_SPEED,
@@ -272,11 +273,12 @@ static Widget window_cheats_guests_widgets[] =
     MakeWidget({ 11, 300+15+6-3}, CHEAT_BUTTON, WindowWidgetType::Button,   WindowColour::Secondary, STR_SHOP_ITEM_PLURAL_BALLOON                                    ), // give guests balloons
     MakeWidget({127, 300+15+6-3}, CHEAT_BUTTON, WindowWidgetType::Button,   WindowColour::Secondary, STR_SHOP_ITEM_PLURAL_UMBRELLA                                   ), // give guests umbrellas
 
-    MakeWidget({  5, 342+6}, {238,  85},    WindowWidgetType::Groupbox, WindowColour::Secondary, STR_GUEST_BEHAVIOUR                                             ), // Guests behaviour group frame
+    MakeWidget({  5, 342+6}, {238, 102},    WindowWidgetType::Groupbox, WindowColour::Secondary, STR_GUEST_BEHAVIOUR                                             ), // Guests behaviour group frame
     MakeWidget({ 11, 363+1}, CHEAT_CHECK,   WindowWidgetType::Checkbox, WindowColour::Secondary, STR_CHEAT_IGNORE_INTENSITY,      STR_CHEAT_IGNORE_INTENSITY_TIP ), // guests ignore intensity
     MakeWidget({ 11, 380+1}, CHEAT_CHECK,   WindowWidgetType::Checkbox, WindowColour::Secondary, STR_CHEAT_IGNORE_PRICE,          STR_CHEAT_IGNORE_PRICE_TIP     ), // guests ignore price
     MakeWidget({ 11, 397+1}, CHEAT_CHECK,   WindowWidgetType::Checkbox, WindowColour::Secondary, STR_CHEAT_DISABLE_VANDALISM,     STR_CHEAT_DISABLE_VANDALISM_TIP), // disable vandalism
     MakeWidget({ 11, 414+1}, CHEAT_CHECK,   WindowWidgetType::Checkbox, WindowColour::Secondary, STR_CHEAT_DISABLE_LITTERING,     STR_CHEAT_DISABLE_LITTERING_TIP), // disable littering
+    MakeWidget({ 11, 431+1}, CHEAT_CHECK,   WindowWidgetType::Checkbox, WindowColour::Secondary, STR_CHEAT_FOOTPATH_GRAPH_PATHFINDING, STR_CHEAT_FOOTPATH_GRAPH_PATHFINDING_TIP), // guests take shortest route
 
     kWidgetsEnd,
 };
@@ -553,6 +555,7 @@ static StringId window_cheats_page_titles[] = {
                     SetCheckboxValue(WIDX_GUEST_IGNORE_PRICE, gameState.Cheats.IgnorePrice);
                     SetCheckboxValue(WIDX_DISABLE_VANDALISM, gameState.Cheats.DisableVandalism);
                     SetCheckboxValue(WIDX_DISABLE_LITTERING, gameState.Cheats.DisableLittering);
+                    SetCheckboxValue(WIDX_GUEST_FOOTPATH_GRAPH_PATHFINDING, gameState.Cheats.FootpathGraphPathfinding);
                     break;
                 }
                 case WINDOW_CHEATS_PAGE_PARK:
@@ -1256,6 +1259,9 @@ static StringId window_cheats_page_titles[] = {
                 case WIDX_DISABLE_LITTERING:
                     CheatsSet(CheatType::DisableLittering, !gameState.Cheats.DisableLittering);
                     break;
+                case WIDX_GUEST_FOOTPATH_GRAPH_PATHFINDING:
+                    CheatsSet(CheatType::FootpathGraphPathfinding, !gameState.Cheats.FootpathGraphPathfinding);
+                    break;
             }
         }
 
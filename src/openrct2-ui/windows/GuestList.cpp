@@ -9,6 +9,7 @@
 
 #include <cmath>
 #include <openrct2-ui/interface/Dropdown.h>
+#include <openrct2-ui/interface/ListModel.h>
 #include <openrct2-ui/interface/Widget.h>
 #include <openrct2-ui/windows/Window.h>
 #include <openrct2/Context.h>
@@ -28,6 +29,8 @@
 #include <openrct2/util/Math.hpp>
 #include <openrct2/util/Util.h>
 #include <openrct2/world/Park.h>
+#include <optional>
+#include <string>
 #include <vector>
 
 namespace OpenRCT2::Ui::Windows
@@ -122,12 +125,14 @@ namespace OpenRCT2::Ui::Windows
             uint8_t Faces[58]{};
         };
 
-        struct GuestItem
+        struct GuestSortKey
         {
-            using CompareFunc = bool (*)(const GuestItem&, const GuestItem&);
-
-            EntityId Id;
-            char Name[256];
+            std::string Name;
+            // A copy of the custom name of the guest when the key was made, to notice when the guest is renamed.
+            std::optional<std::string> CustomName;
+            uint32_t PeepId{};
+            // Guests with generated names are sorted by their number, unless real names are shown.
+            bool SortById{};
         };
 
         static constexpr uint8_t SUMMARISED_GUEST_ROW_HEIGHT = kScrollableRowHeight + 11;
@@ -150,7 +155,10 @@ namespace OpenRCT2::Ui::Windows
         uint32_t _lastFindGroupsWait{};
         std::vector<GuestGroup> _groups;
 
-        std::vector<GuestItem> _guestList;
+        ListModel<EntityId, GuestSortKey> _guestList{ CompareGuestSortKey };
+        bool _guestListRealNames{};
+        // Whether each guest passed the group and tracking filters in the last refresh.
+        std::vector<bool> _guestListFiltered;
         std::optional<size_t> _highlightedIndex;
 
         uint32_t _tabAnimationIndex{};
@@ -277,6 +285,13 @@ namespace OpenRCT2::Ui::Windows
             InvalidateWidget(WIDX_TAB_1 + static_cast<int32_t>(_selectedTab));
         }
 
+        void OnLanguageChange() override
+        {
+            // Generated names are formatted in the new language.
+            _guestList.Clear();
+            RefreshList();
+        }
+
         void OnMouseUp(WidgetIndex widgetIndex) override
         {
             switch (widgetIndex)
@@ -555,20 +570,15 @@ namespace OpenRCT2::Ui::Windows
             {
                 case TabId::Individual:
                 {
-                    auto i = screenCoords.y / kScrollableRowHeight;
-                    i += static_cast<int32_t>(_selectedPage * GUESTS_PER_PAGE);
-                    for (const auto& guestItem : _guestList)
+                    auto i = static_cast<size_t>(screenCoords.y / kScrollableRowHeight);
+                    i += _selectedPage * GUESTS_PER_PAGE;
+                    if (i < _guestList.size())
                     {
-                        if (i == 0)
+                        auto guest = GetEntity<Guest>(_guestList[i].Id);
+                        if (guest != nullptr)
                         {
-                            auto guest = GetEntity<Guest>(guestItem.Id);
-                            if (guest != nullptr)
-                            {
-                                GuestOpen(guest);
-                            }
-                            break;
+                            GuestOpen(guest);
                         }
-                        i--;
                     }
                     break;
                 }
@@ -617,31 +627,50 @@ namespace OpenRCT2::Ui::Windows
             }
             else
             {
-                _guestList.clear();
+                // The names of guests without a custom name change when real names are switched on or off.
+                const bool realNames = (GetGameState().Park.Flags & PARK_FLAGS_SHOW_REAL_GUEST_NAMES) != 0;
+                if (realNames != _guestListRealNames)
+                {
+                    _guestList.Clear();
+                    _guestListRealNames = realNames;
+                }
 
+                // Every guest in the park keeps its key, so only the guests that were not in the park before or were
+                // renamed have their name formatted. The filters then only choose which of them are shown.
+                _guestListFiltered.assign(_guestListFiltered.size(), false);
+                _guestList.BeginUpdate();
                 for (auto peep : EntityList<Guest>())
                 {
                     EntitySetFlashing(peep, false);
                     if (peep->OutsideOfPark)
                         continue;
+
+                    const auto* key = _guestList.Find(peep->Id);
+                    if (key != nullptr && key->PeepId == peep->PeepId && IsSameCustomName(key->CustomName, *peep))
+                        _guestList.Keep(peep->Id);
+                    else
+                        _guestList.Add(peep->Id, GetGuestSortKey(*peep, realNames));
+
                     if (_selectedFilter)
                     {
                         if (!IsPeepInFilter(*peep))
                             continue;
                         EntitySetFlashing(peep, true);
                     }
-                    if (!GuestShouldBeVisible(*peep))
+                    if (_trackingOnly && !(peep->PeepFlags & PEEP_FLAGS_TRACKING))
                         continue;
 
-                    auto& item = _guestList.emplace_back();
-                    item.Id = peep->Id;
-
-                    Formatter ft;
-                    peep->FormatNameTo(ft);
-                    OpenRCT2::FormatStringLegacy(item.Name, sizeof(item.Name), STR_STRINGID, ft.Data());
+                    const auto underlying = static_cast<size_t>(peep->Id.ToUnderlying());
+                    if (underlying >= _guestListFiltered.size())
+                        _guestListFiltered.resize(underlying + 1, false);
+                    _guestListFiltered[underlying] = true;
                 }
-
-                std::sort(_guestList.begin(), _guestList.end(), GetGuestCompareFunc());
+                _guestList.EndUpdate();
+                _guestList.Filter([this](const auto& item) {
+                    const auto underlying = static_cast<size_t>(item.Id.ToUnderlying());
+                    return underlying < _guestListFiltered.size() && _guestListFiltered[underlying]
+                        && IsNameInFilter(item.Key.Name);
+                });
             }
         }
 
@@ -664,68 +693,70 @@ namespace OpenRCT2::Ui::Windows
 
         void DrawScrollIndividual(DrawPixelInfo& dpi)
         {
-            size_t index = 0;
-            auto y = static_cast<int32_t>(_selectedPage) * -GUEST_PAGE_HEIGHT;
-            for (const auto& guestItem : _guestList)
+            // Only draw the rows of the current page that are inside the scroll control.
+            const auto pageTop = static_cast<int32_t>(_selectedPage) * GUEST_PAGE_HEIGHT;
+            auto [first, last] = _guestList.GetVisibleRange(
+                pageTop + dpi.y, pageTop + dpi.y + dpi.height, kScrollableRowHeight);
+            first = std::max(first, _selectedPage * GUESTS_PER_PAGE);
+            last = std::min(last, (_selectedPage + 1) * GUESTS_PER_PAGE);
+
+            for (size_t index = first; index < last; index++)
             {
-                // Check if y is beyond the scroll control
-                if (y + kScrollableRowHeight + 1 >= -0x7FFF && y + kScrollableRowHeight + 1 > dpi.y && y < 0x7FFF
-                    && y < dpi.y + dpi.height)
-                {
-                    // Highlight backcolour and text colour (format)
-                    StringId format = STR_BLACK_STRING;
-                    if (index == _highlightedIndex)
-                    {
-                        GfxFilterRect(dpi, { 0, y, 800, y + kScrollableRowHeight - 1 }, FilterPaletteID::PaletteDarken1);
-                        format = STR_WINDOW_COLOUR_2_STRINGID;
-                    }
+                const auto& guestItem = _guestList[index];
+                const auto y = static_cast<int32_t>(index) * kScrollableRowHeight - pageTop;
 
-                    // Guest name
-                    auto peep = GetEntity<Guest>(guestItem.Id);
-                    if (peep == nullptr)
-                    {
-                        continue;
-                    }
-                    auto ft = Formatter();
-                    peep->FormatNameTo(ft);
-                    DrawTextEllipsised(dpi, { 0, y }, 113, format, ft);
+                // Highlight backcolour and text colour (format)
+                StringId format = STR_BLACK_STRING;
+                if (index == _highlightedIndex)
+                {
+                    GfxFilterRect(dpi, { 0, y, 800, y + kScrollableRowHeight - 1 }, FilterPaletteID::PaletteDarken1);
+                    format = STR_WINDOW_COLOUR_2_STRINGID;
+                }
 
-                    switch (_selectedView)
-                    {
-                        case GuestViewType::Actions:
-                            // Guest face
-                            GfxDrawSprite(dpi, ImageId(GetPeepFaceSpriteSmall(peep)), { 118, y + 1 });
+                // Guest name
+                auto peep = GetEntity<Guest>(guestItem.Id);
+                if (peep == nullptr)
+                {
+                    continue;
+                }
+                auto ft = Formatter();
+                ft.Add<StringId>(STR_STRING);
+                ft.Add<const char*>(guestItem.Key.Name.c_str());
+                DrawTextEllipsised(dpi, { 0, y }, 113, format, ft);
 
-                            // Tracking icon
-                            if (peep->PeepFlags & PEEP_FLAGS_TRACKING)
-                                GfxDrawSprite(dpi, ImageId(STR_ENTER_SELECTION_SIZE), { 112, y + 1 });
+                switch (_selectedView)
+                {
+                    case GuestViewType::Actions:
+                        // Guest face
+                        GfxDrawSprite(dpi, ImageId(GetPeepFaceSpriteSmall(peep)), { 118, y + 1 });
+
+                        // Tracking icon
+                        if (peep->PeepFlags & PEEP_FLAGS_TRACKING)
+                            GfxDrawSprite(dpi, ImageId(STR_ENTER_SELECTION_SIZE), { 112, y + 1 });
+
+                        // Action
+                        ft = Formatter();
+                        peep->FormatActionTo(ft);
+                        DrawTextEllipsised(dpi, { 133, y }, 314, format, ft);
+                        break;
+                    case GuestViewType::Thoughts:
+                        // For each thought
+                        for (const auto& thought : peep->Thoughts)
+                        {
+                            if (thought.type == PeepThoughtType::None)
+                                break;
+                            if (thought.freshness == 0)
+                                continue;
+                            if (thought.freshness > 5)
+                                break;
 
-                            // Action
                             ft = Formatter();
-                            peep->FormatActionTo(ft);
-                            DrawTextEllipsised(dpi, { 133, y }, 314, format, ft);
-                            break;
-                        case GuestViewType::Thoughts:
-                            // For each thought
-                            for (const auto& thought : peep->Thoughts)
-                            {
-                                if (thought.type == PeepThoughtType::None)
-                                    break;
-                                if (thought.freshness == 0)
-                                    continue;
-                                if (thought.freshness > 5)
-                                    break;
-
-                                ft = Formatter();
-                                PeepThoughtSetFormatArgs(&thought, ft);
-                                DrawTextEllipsised(dpi, { 118, y }, 329, format, ft, { FontStyle::Small });
-                                break;
-                            }
+                            PeepThoughtSetFormatArgs(&thought, ft);
+                            DrawTextEllipsised(dpi, { 118, y }, 329, format, ft, { FontStyle::Small });
                             break;
-                    }
+                        }
+                        break;
                 }
-                y += kScrollableRowHeight;
-                index++;
             }
         }
 
@@ -781,25 +812,9 @@ namespace OpenRCT2::Ui::Windows
             }
         }
 
-        bool GuestShouldBeVisible(const Guest& peep)
+        bool IsNameInFilter(std::string_view name) const
         {
-            if (_trackingOnly && !(peep.PeepFlags & PEEP_FLAGS_TRACKING))
-                return false;
-
-            if (!_filterName.empty())
-            {
-                char name[256]{};
-
-                Formatter ft;
-                peep.FormatNameTo(ft);
-                OpenRCT2::FormatStringLegacy(name, sizeof(name), STR_STRINGID, ft.Data());
-                if (!String::Contains(name, _filterName.c_str(), true))
-                {
-                    return false;
-                }
-            }
-
-            return true;
+            return _filterName.empty() || String::Contains(name, _filterName, true);
         }
 
         bool IsPeepInFilter(const Guest& peep)
@@ -933,35 +948,42 @@ namespace OpenRCT2::Ui::Windows
             }
         }
 
-        template<bool TRealNames> static bool CompareGuestItem(const GuestItem& a, const GuestItem& b)
+        static std::optional<std::string> GetCustomName(const Peep& peep)
         {
-            const auto* peepA = GetEntity<Peep>(a.Id);
-            const auto* peepB = GetEntity<Peep>(b.Id);
-            if (peepA != nullptr && peepB != nullptr)
-            {
-                // Compare types
-                if (peepA->Type != peepB->Type)
-                {
-                    return static_cast<int32_t>(peepA->Type) < static_cast<int32_t>(peepB->Type);
-                }
+            if (peep.Name == nullptr)
+                return std::nullopt;
+            return std::string(peep.Name);
+        }
 
-                // Compare name
-                if constexpr (!TRealNames)
-                {
-                    if (peepA->Name == nullptr && peepB->Name == nullptr)
-                    {
-                        // Simple ID comparison for when both peeps use a number or a generated name
-                        return peepA->PeepId < peepB->PeepId;
-                    }
-                }
-            }
-            return StrLogicalCmp(a.Name, b.Name) < 0;
+        // Compares the contents, the name may since have been freed and another allocated at the same address.
+        static bool IsSameCustomName(const std::optional<std::string>& customName, const Peep& peep)
+        {
+            if (peep.Name == nullptr)
+                return !customName.has_value();
+            return customName.has_value() && *customName == peep.Name;
+        }
+
+        static GuestSortKey GetGuestSortKey(const Guest& peep, bool realNames)
+        {
+            GuestSortKey key;
+            key.CustomName = GetCustomName(peep);
+            key.PeepId = peep.PeepId;
+            key.SortById = !realNames && peep.Name == nullptr;
+
+            Formatter ft;
+            peep.FormatNameTo(ft);
+            key.Name = OpenRCT2::FormatStringIDLegacy(STR_STRINGID, ft.Data());
+            return key;
         }
 
-        static GuestItem::CompareFunc GetGuestCompareFunc()
+        static bool CompareGuestSortKey(const GuestSortKey& a, const GuestSortKey& b)
         {
-            return GetGameState().Park.Flags & PARK_FLAGS_SHOW_REAL_GUEST_NAMES ? CompareGuestItem<true>
-                                                                                : CompareGuestItem<false>;
+            if (a.SortById && b.SortById)
+            {
+                // Simple ID comparison for when both peeps use a number or a generated name
+                return a.PeepId < b.PeepId;
+            }
+            return StrLogicalCmp(a.Name.c_str(), b.Name.c_str()) < 0;
         }
     };
 
@@ -22,6 +22,7 @@
 #include <openrct2/actions/PeepSpawnPlaceAction.h>
 #include <openrct2/actions/SurfaceSetStyleAction.h>
 #include <openrct2/audio/audio.h>
+#include <openrct2/core/JobPool.h>
 #include <openrct2/entity/EntityList.h>
 #include <openrct2/entity/EntityRegistry.h>
 #include <openrct2/entity/Staff.h>
@@ -32,10 +33,13 @@
 #include <openrct2/ride/Vehicle.h>
 #include <openrct2/sprites.h>
 #include <openrct2/world/Footpath.h>
+#include <openrct2/world/MapChanges.h>
 #include <openrct2/world/Scenery.h>
 #include <openrct2/world/Surface.h>
 #include <openrct2/world/tile_element/EntranceElement.h>
 #include <openrct2/world/tile_element/Slope.h>
+#include <memory>
+#include <utility>
 #include <vector>
 
 namespace OpenRCT2::Ui::Windows
@@ -202,6 +206,9 @@ namespace OpenRCT2::Ui::Windows
         MapColour(PALETTE_INDEX_0),                     // TILE_ELEMENT_TYPE_BANNER
     };
 
+    // Builds the whole minimap image in bands of tile rows.
+    static std::unique_ptr<JobPool> _miniMapJobs;
+
     namespace MapFlashingFlags
     {
         constexpr uint16_t FlashGuests = (1 << 1);
@@ -212,10 +219,10 @@ namespace OpenRCT2::Ui::Windows
     class MapWindow final : public Window
     {
         uint8_t _rotation;
-        uint32_t _currentLine;
         uint16_t _landRightsToolSize;
         int32_t _firstColumnWidth;
         std::vector<uint8_t> _mapImageData;
+        std::vector<TileCoordsXY> _changedTiles;
 
         bool _mapWidthAndHeightLinked = true;
         bool _recalculateScrollbars = false;
@@ -265,6 +272,9 @@ namespace OpenRCT2::Ui::Windows
         {
             _mapImageData.clear();
             _mapImageData.shrink_to_fit();
+            _changedTiles.clear();
+            _changedTiles.shrink_to_fit();
+            MapChanges::StopTracking();
 
             if (isToolActive(classification, number))
             {
@@ -324,6 +334,7 @@ namespace OpenRCT2::Ui::Windows
                         list_information_type = 0;
                         _recalculateScrollbars = true;
                         ResetMaxWindowDimensions();
+                        InitMap();
                     }
             }
         }
@@ -376,8 +387,7 @@ namespace OpenRCT2::Ui::Windows
                 CentreMapOnViewPoint();
             }
 
-            for (int32_t i = 0; i < 16; i++)
-                SetMapPixels();
+            UpdateMapPixels();
 
             Invalidate();
 
@@ -710,7 +720,9 @@ namespace OpenRCT2::Ui::Windows
         {
             _mapImageData.resize(getMiniMapWidth() * getMiniMapWidth());
             std::fill(_mapImageData.begin(), _mapImageData.end(), PALETTE_INDEX_10);
-            _currentLine = 0;
+
+            MapChanges::StartTracking();
+            UpdateMapPixels();
         }
 
         void CentreMapOnViewPoint()
@@ -781,68 +793,107 @@ namespace OpenRCT2::Ui::Windows
             GameActions::Execute(&decreaseMapSizeAction);
         }
 
-        void SetMapPixels()
+        // Recolours the tiles that changed since the last update, or every tile after the whole map changed.
+        void UpdateMapPixels()
         {
-            int32_t x = 0, y = 0, dx = 0, dy = 0;
+            if (!MapChanges::TakeChangedTiles(_changedTiles))
+            {
+                SetAllMapPixels();
+                return;
+            }
 
-            int32_t pos = (_currentLine * (getMiniMapWidth() - 1)) + getPracticalMapSize() - 1;
-            auto destinationPosition = ScreenCoordsXY{ pos % getMiniMapWidth(), pos / getMiniMapWidth() };
-            auto destination = _mapImageData.data() + (destinationPosition.y * getMiniMapWidth()) + destinationPosition.x;
-            switch (GetCurrentRotation())
+            for (const auto& tilePos : _changedTiles)
             {
-                case 0:
-                    x = _currentLine * kCoordsXYStep;
-                    y = 0;
-                    dx = 0;
-                    dy = kCoordsXYStep;
+                SetMapPixel(tilePos);
+            }
+        }
+
+        void SetAllMapPixels()
+        {
+            constexpr int32_t kRowsPerBand = 16;
+            if (_miniMapJobs == nullptr)
+            {
+                _miniMapJobs = std::make_unique<JobPool>();
+            }
+
+            // Every tile has its own pixels, so the bands can be coloured at the same time.
+            const auto mapSize = getPracticalMapSize();
+            for (int32_t bandBegin = 0; bandBegin < mapSize; bandBegin += kRowsPerBand)
+            {
+                const int32_t bandEnd = std::min(bandBegin + kRowsPerBand, mapSize);
+                _miniMapJobs->AddTask([this, bandBegin, bandEnd, mapSize]() {
+                    for (int32_t y = bandBegin; y < bandEnd; y++)
+                    {
+                        for (int32_t x = 0; x < mapSize; x++)
+                        {
+                            SetMapPixel({ x, y });
+                        }
+                    }
+                });
+            }
+            _miniMapJobs->Join();
+        }
+
+        void SetMapPixel(const TileCoordsXY& tilePos)
+        {
+            const auto mapSize = getPracticalMapSize();
+            if (tilePos.x < 0 || tilePos.y < 0 || tilePos.x >= mapSize || tilePos.y >= mapSize)
+                return;
+
+            const auto coords = tilePos.ToCoordsXY();
+            if (MapIsEdge(coords))
+                return;
+
+            uint16_t colour = 0;
+            switch (selected_tab)
+            {
+                case PAGE_PEEPS:
+                    colour = GetPixelColourPeep(coords);
                     break;
-                case 1:
-                    x = getMaxTileStartXY();
-                    y = _currentLine * kCoordsXYStep;
-                    dx = -kCoordsXYStep;
-                    dy = 0;
+                case PAGE_RIDES:
+                    colour = GetPixelColourRide(coords);
                     break;
+            }
+
+            // Each tile is drawn as two pixels side by side, the right one where TransformToMapCoords puts entities.
+            const auto rotatedPos = RotateTileCoords(tilePos);
+            const auto pixelPos = ScreenCoordsXY{ mapSize - 1 - rotatedPos.x + rotatedPos.y, rotatedPos.x + rotatedPos.y };
+            auto destination = _mapImageData.data() + (pixelPos.y * getMiniMapWidth()) + pixelPos.x;
+            destination[0] = (colour >> 8) & 0xFF;
+            destination[1] = colour;
+        }
+
+        // Rotates the tile position with the main viewport, the inverse of UnrotateTileCoords.
+        TileCoordsXY RotateTileCoords(const TileCoordsXY& tilePos) const
+        {
+            const auto maxTile = getPracticalMapSize() - 1;
+            switch (GetCurrentRotation())
+            {
+                case 1:
+                    return { tilePos.y, maxTile - tilePos.x };
                 case 2:
-                    x = getPracticalMapSizeBig() - ((_currentLine + 1) * kCoordsXYStep);
-                    y = getMaxTileStartXY();
-                    dx = 0;
-                    dy = -kCoordsXYStep;
-                    break;
+                    return { maxTile - tilePos.x, maxTile - tilePos.y };
                 case 3:
-                    x = 0;
-                    y = getPracticalMapSizeBig() - ((_currentLine + 1) * kCoordsXYStep);
-                    dx = kCoordsXYStep;
-                    dy = 0;
-                    break;
+                    return { maxTile - tilePos.y, tilePos.x };
+                default:
+                    return tilePos;
             }
+        }
 
-            for (int32_t i = 0; i < getPracticalMapSize(); i++)
+        TileCoordsXY UnrotateTileCoords(const TileCoordsXY& rotatedPos) const
+        {
+            const auto maxTile = getPracticalMapSize() - 1;
+            switch (GetCurrentRotation())
             {
-                if (!MapIsEdge({ x, y }))
-                {
-                    uint16_t colour = 0;
-                    switch (selected_tab)
-                    {
-                        case PAGE_PEEPS:
-                            colour = GetPixelColourPeep({ x, y });
-                            break;
-                        case PAGE_RIDES:
-                            colour = GetPixelColourRide({ x, y });
-                            break;
-                    }
-                    destination[0] = (colour >> 8) & 0xFF;
-                    destination[1] = colour;
-                }
-                x += dx;
-                y += dy;
-
-                destinationPosition.x++;
-                destinationPosition.y++;
-                destination = _mapImageData.data() + (destinationPosition.y * getMiniMapWidth()) + destinationPosition.x;
+                case 1:
+                    return { maxTile - rotatedPos.y, rotatedPos.x };
+                case 2:
+                    return { maxTile - rotatedPos.x, maxTile - rotatedPos.y };
+                case 3:
+                    return { rotatedPos.y, maxTile - rotatedPos.x };
+                default:
+                    return rotatedPos;
             }
-            _currentLine++;
-            if (_currentLine >= static_cast<uint32_t>(getPracticalMapSize()))
-                _currentLine = 0;
         }
 
         uint16_t GetPixelColourPeep(const CoordsXY& c)
@@ -950,16 +1001,74 @@ namespace OpenRCT2::Ui::Windows
 
         void PaintPeepOverlay(DrawPixelInfo& dpi, const ScreenCoordsXY& offset)
         {
-            auto flashColour = GetGuestFlashColour();
-            for (auto guest : EntityList<Guest>())
+            const auto guestFlashColour = GetGuestFlashColour();
+            const auto staffFlashColour = GetStaffFlashColour();
+
+            // Only look up the peeps on the visible tiles when there are fewer of those than peeps.
+            const auto [tileMin, tileMax] = GetVisibleTileRange(dpi, offset);
+            const auto numVisibleTiles = static_cast<int64_t>(tileMax.x - tileMin.x + 1) * (tileMax.y - tileMin.y + 1);
+            const auto numPeeps = GetEntityListCount(EntityType::Guest) + GetEntityListCount(EntityType::Staff);
+            if (numVisibleTiles >= numPeeps)
             {
-                DrawMapPeepPixel(guest, flashColour, dpi, offset);
+                for (auto guest : EntityList<Guest>())
+                {
+                    DrawMapPeepPixel(guest, guestFlashColour, dpi, offset);
+                }
+                for (auto staff : EntityList<Staff>())
+                {
+                    DrawMapPeepPixel(staff, staffFlashColour, dpi, offset);
+                }
+                return;
             }
-            flashColour = GetStaffFlashColour();
-            for (auto staff : EntityList<Staff>())
+
+            for (int32_t y = tileMin.y; y <= tileMax.y; y++)
             {
-                DrawMapPeepPixel(staff, flashColour, dpi, offset);
+                for (int32_t x = tileMin.x; x <= tileMax.x; x++)
+                {
+                    for (auto guest : EntityTileList<Guest>(TileCoordsXY{ x, y }.ToCoordsXY()))
+                    {
+                        DrawMapPeepPixel(guest, guestFlashColour, dpi, offset);
+                    }
+                }
             }
+            for (int32_t y = tileMin.y; y <= tileMax.y; y++)
+            {
+                for (int32_t x = tileMin.x; x <= tileMax.x; x++)
+                {
+                    for (auto staff : EntityTileList<Staff>(TileCoordsXY{ x, y }.ToCoordsXY()))
+                    {
+                        DrawMapPeepPixel(staff, staffFlashColour, dpi, offset);
+                    }
+                }
+            }
+        }
+
+        /**
+         * Returns the smallest and largest tile position of the tiles that are drawn in the part of the minimap that
+         * the DPI covers, with a margin of one tile.
+         */
+        std::pair<TileCoordsXY, TileCoordsXY> GetVisibleTileRange(const DrawPixelInfo& dpi, const ScreenCoordsXY& offset)
+        {
+            const auto mapSize = getPracticalMapSize();
+            const auto left = dpi.x - offset.x;
+            const auto top = dpi.y - offset.y;
+            const auto right = left + dpi.width;
+            const auto bottom = top + dpi.height;
+
+            // Invert the pixel position of TransformToMapCoords for the corners of the DPI.
+            const auto rotatedMin = TileCoordsXY{ (top - right + mapSize) / 2 - 1, (top + left - mapSize) / 2 - 1 };
+            const auto rotatedMax = TileCoordsXY{ (bottom - left + mapSize) / 2 + 1, (bottom + right - mapSize) / 2 + 1 };
+            const auto cornerA = UnrotateTileCoords(rotatedMin);
+            const auto cornerB = UnrotateTileCoords(rotatedMax);
+
+            const auto& gameState = GetGameState();
+            const auto maxX = gameState.MapSize.x - 1;
+            const auto maxY = gameState.MapSize.y - 1;
+            const auto tileMin = TileCoordsXY{ std::clamp(std::min(cornerA.x, cornerB.x), 0, maxX),
+                                               std::clamp(std::min(cornerA.y, cornerB.y), 0, maxY) };
+            const auto tileMax = TileCoordsXY{ std::clamp(std::max(cornerA.x, cornerB.x), 0, maxX),
+                                               std::clamp(std::max(cornerA.y, cornerB.y), 0, maxY) };
+            return { tileMin, tileMax };
         }
 
         void DrawMapPeepPixel(Peep* peep, const uint8_t flashColour, DrawPixelInfo& dpi, const ScreenCoordsXY& offset)
@@ -11,6 +11,7 @@
 
 #include <iterator>
 #include <openrct2-ui/interface/Dropdown.h>
+#include <openrct2-ui/interface/ListModel.h>
 #include <openrct2-ui/interface/Widget.h>
 #include <openrct2-ui/windows/Window.h>
 #include <openrct2/Context.h>
@@ -163,12 +164,13 @@ namespace OpenRCT2::Ui::Windows
         bool _quickDemolishMode = false;
         int32_t _windowRideListInformationType = INFORMATION_TYPE_STATUS;
 
-        struct RideListEntry
+        struct RideSortKey
         {
-            RideId Id;
             u8string Name;
+            // The value of the information the list is sorted by, if not by name.
+            int64_t Value{};
         };
-        std::vector<RideListEntry> _rideList;
+        ListModel<RideId, RideSortKey> _rideList{ CompareRideSortKeyName };
 
     public:
         void OnOpen() override
@@ -545,9 +547,10 @@ namespace OpenRCT2::Ui::Windows
                 dpi, { dpiCoords, dpiCoords + ScreenCoordsXY{ dpi.width, dpi.height } },
                 ColourMapA[colours[1].colour].mid_light);
 
-            auto y = 0;
-            for (size_t i = 0; i < _rideList.size(); i++)
+            const auto [first, last] = _rideList.GetVisibleRange(dpi.y, dpi.y + dpi.height, kScrollableRowHeight);
+            for (size_t i = first; i < last; i++)
             {
+                const auto y = static_cast<int32_t>(i) * kScrollableRowHeight;
                 StringId format = STR_BLACK_STRING;
                 if (_quickDemolishMode)
                     format = STR_RED_STRINGID;
@@ -568,7 +571,8 @@ namespace OpenRCT2::Ui::Windows
 
                 // Ride name
                 auto ft = Formatter();
-                ridePtr->FormatNameTo(ft);
+                ft.Add<StringId>(STR_STRING);
+                ft.Add<const char*>(_rideList[i].Key.Name.c_str());
                 DrawTextEllipsised(dpi, { 0, y - 1 }, 159, format, ft);
 
                 // Ride information
@@ -747,7 +751,6 @@ namespace OpenRCT2::Ui::Windows
                     ft.Add<StringId>(formatSecondary);
                 }
                 DrawTextEllipsised(dpi, { 160, y - 1 }, 157, format, ft);
-                y += kScrollableRowHeight;
             }
         }
 
@@ -756,6 +759,12 @@ namespace OpenRCT2::Ui::Windows
             RefreshList();
         }
 
+        void OnLanguageChange() override
+        {
+            // Default ride names are formatted in the new language.
+            RefreshList();
+        }
+
     private:
         /**
          *
@@ -787,155 +796,96 @@ namespace OpenRCT2::Ui::Windows
                 dpi, ImageId(sprite_idx), windowPos + ScreenCoordsXY{ widgets[WIDX_TAB_3].left, widgets[WIDX_TAB_3].top });
         }
 
-        /**
-         * Used in RefreshList() to handle the sorting of the list.
-         * Uses a lambda function (predicate) as exit criteria for the algorithm.
-         */
-        template<typename TSortPred> void SortListByPredicate(const TSortPred& pred)
+        static bool CompareRideSortKeyName(const RideSortKey& a, const RideSortKey& b)
         {
-            std::sort(_rideList.begin(), _rideList.end(), [&pred](const auto& lhs, const auto& rhs) {
-                const Ride* rideLhs = GetRide(lhs.Id);
-                const Ride* rideRhs = GetRide(rhs.Id);
-                if (rideLhs == nullptr || rideRhs == nullptr)
-                {
-                    return false;
-                }
-                return !pred(*rideLhs, *rideRhs);
-            });
+            return StrLogicalCmp(a.Name.c_str(), b.Name.c_str()) < 0;
         }
 
-        void SortListByName()
+        static bool CompareRideSortKeyValue(const RideSortKey& a, const RideSortKey& b)
         {
-            std::sort(_rideList.begin(), _rideList.end(), [](const auto& lhs, const auto& rhs) {
-                return !(0 <= StrLogicalCmp(lhs.Name.c_str(), rhs.Name.c_str()));
-            });
+            // Highest first
+            return a.Value > b.Value;
         }
 
-        /**
-         *
-         *  rct2: 0x006B39A8
-         */
-        void RefreshList()
+        int64_t GetRideSortValue(const Ride& ride) const
         {
-            _rideList.clear();
-            for (auto& rideRef : GetRideManager())
-            {
-                if (rideRef.GetClassification() != static_cast<RideClassification>(page)
-                    || (rideRef.status == RideStatus::Closed && !RideHasAnyTrackElements(rideRef)))
-                {
-                    continue;
-                }
-
-                if (rideRef.window_invalidate_flags & RIDE_INVALIDATE_RIDE_LIST)
-                {
-                    rideRef.window_invalidate_flags &= ~RIDE_INVALIDATE_RIDE_LIST;
-                }
-
-                RideListEntry entry{};
-                entry.Id = rideRef.id;
-                entry.Name = rideRef.GetName();
-
-                _rideList.push_back(std::move(entry));
-            }
-
             switch (list_information_type)
             {
-                case INFORMATION_TYPE_STATUS:
-                    SortListByName();
-                    break;
                 case INFORMATION_TYPE_POPULARITY:
-                    SortListByPredicate([](const Ride& thisRide, const Ride& otherRide) -> bool {
-                        return thisRide.popularity * 4 <= otherRide.popularity * 4;
-                    });
-                    break;
+                    return ride.popularity * 4;
                 case INFORMATION_TYPE_SATISFACTION:
-                    SortListByPredicate([](const Ride& thisRide, const Ride& otherRide) -> bool {
-                        return thisRide.satisfaction * 5 <= otherRide.satisfaction * 5;
-                    });
-                    break;
+                    return ride.satisfaction * 5;
                 case INFORMATION_TYPE_PROFIT:
-                    SortListByPredicate([](const Ride& thisRide, const Ride& otherRide) -> bool {
-                        return thisRide.profit <= otherRide.profit;
-                    });
-                    break;
+                    return ride.profit;
                 case INFORMATION_TYPE_TOTAL_CUSTOMERS:
-                    SortListByPredicate([](const Ride& thisRide, const Ride& otherRide) -> bool {
-                        return thisRide.total_customers <= otherRide.total_customers;
-                    });
-                    break;
+                    return ride.total_customers;
                 case INFORMATION_TYPE_TOTAL_PROFIT:
-                    SortListByPredicate([](const Ride& thisRide, const Ride& otherRide) -> bool {
-                        return thisRide.total_profit <= otherRide.total_profit;
-                    });
-                    break;
+                    return ride.total_profit;
                 case INFORMATION_TYPE_CUSTOMERS:
-                    SortListByPredicate([](const Ride& thisRide, const Ride& otherRide) -> bool {
-                        return RideCustomersPerHour(thisRide) <= RideCustomersPerHour(otherRide);
-                    });
-                    break;
+                    return RideCustomersPerHour(ride);
                 case INFORMATION_TYPE_AGE:
-                    SortListByPredicate([](const Ride& thisRide, const Ride& otherRide) -> bool {
-                        return thisRide.build_date <= otherRide.build_date;
-                    });
-                    break;
+                    return ride.build_date;
                 case INFORMATION_TYPE_INCOME:
-                    SortListByPredicate([](const Ride& thisRide, const Ride& otherRide) -> bool {
-                        return thisRide.income_per_hour <= otherRide.income_per_hour;
-                    });
-                    break;
+                    return ride.income_per_hour;
                 case INFORMATION_TYPE_RUNNING_COST:
-                    SortListByPredicate([](const Ride& thisRide, const Ride& otherRide) -> bool {
-                        return thisRide.upkeep_cost <= otherRide.upkeep_cost;
-                    });
-                    break;
+                    return ride.upkeep_cost;
                 case INFORMATION_TYPE_QUEUE_LENGTH:
-                    SortListByPredicate([](const Ride& thisRide, const Ride& otherRide) -> bool {
-                        return thisRide.GetTotalQueueLength() <= otherRide.GetTotalQueueLength();
-                    });
-                    break;
+                    return ride.GetTotalQueueLength();
                 case INFORMATION_TYPE_QUEUE_TIME:
-                    SortListByPredicate([](const Ride& thisRide, const Ride& otherRide) -> bool {
-                        return thisRide.GetMaxQueueTime() <= otherRide.GetMaxQueueTime();
-                    });
-                    break;
+                    return ride.GetMaxQueueTime();
                 case INFORMATION_TYPE_RELIABILITY:
-                    SortListByPredicate([](const Ride& thisRide, const Ride& otherRide) -> bool {
-                        return thisRide.reliability_percentage <= otherRide.reliability_percentage;
-                    });
-                    break;
+                    return ride.reliability_percentage;
                 case INFORMATION_TYPE_DOWN_TIME:
-                    SortListByPredicate([](const Ride& thisRide, const Ride& otherRide) -> bool {
-                        return thisRide.downtime <= otherRide.downtime;
-                    });
-                    break;
+                    return ride.downtime;
                 case INFORMATION_TYPE_GUESTS_FAVOURITE:
-                    SortListByPredicate([](const Ride& thisRide, const Ride& otherRide) -> bool {
-                        return thisRide.guests_favourite <= otherRide.guests_favourite;
-                    });
-                    break;
+                    return ride.guests_favourite;
                 case INFORMATION_TYPE_EXCITEMENT:
-                    SortListByPredicate([](const Ride& thisRide, const Ride& otherRide) -> bool {
-                        const auto leftValue = thisRide.ratings.isNull() ? kRideRatingUndefined : thisRide.ratings.excitement;
-                        const auto rightValue = otherRide.ratings.isNull() ? kRideRatingUndefined
-                                                                           : otherRide.ratings.excitement;
-                        return leftValue <= rightValue;
-                    });
-                    break;
+                    return ride.ratings.isNull() ? kRideRatingUndefined : ride.ratings.excitement;
                 case INFORMATION_TYPE_INTENSITY:
-                    SortListByPredicate([](const Ride& thisRide, const Ride& otherRide) -> bool {
-                        const auto leftValue = thisRide.ratings.isNull() ? kRideRatingUndefined : thisRide.ratings.intensity;
-                        const auto rightValue = otherRide.ratings.isNull() ? kRideRatingUndefined : otherRide.ratings.intensity;
-                        return leftValue <= rightValue;
-                    });
-                    break;
+                    return ride.ratings.isNull() ? kRideRatingUndefined : ride.ratings.intensity;
                 case INFORMATION_TYPE_NAUSEA:
-                    SortListByPredicate([](const Ride& thisRide, const Ride& otherRide) -> bool {
-                        const auto leftValue = thisRide.ratings.isNull() ? kRideRatingUndefined : thisRide.ratings.nausea;
-                        const auto rightValue = otherRide.ratings.isNull() ? kRideRatingUndefined : otherRide.ratings.nausea;
-                        return leftValue <= rightValue;
-                    });
-                    break;
+                    return ride.ratings.isNull() ? kRideRatingUndefined : ride.ratings.nausea;
+                default:
+                    return 0;
+            }
+        }
+
+        /**
+         *
+         *  rct2: 0x006B39A8
+         */
+        void RefreshList()
+        {
+            _rideList.SetCompare(
+                list_information_type == INFORMATION_TYPE_STATUS ? CompareRideSortKeyName : CompareRideSortKeyValue);
+
+            // Only the rides that are new or whose sort key changed are sorted into place.
+            _rideList.BeginUpdate();
+            for (auto& rideRef : GetRideManager())
+            {
+                if (rideRef.GetClassification() != static_cast<RideClassification>(page)
+                    || (rideRef.status == RideStatus::Closed && !RideHasAnyTrackElements(rideRef)))
+                {
+                    continue;
+                }
+
+                if (rideRef.window_invalidate_flags & RIDE_INVALIDATE_RIDE_LIST)
+                {
+                    rideRef.window_invalidate_flags &= ~RIDE_INVALIDATE_RIDE_LIST;
+                }
+
+                RideSortKey key{ rideRef.GetName(), GetRideSortValue(rideRef) };
+                const auto* listedKey = _rideList.Find(rideRef.id);
+                if (listedKey != nullptr && listedKey->Name == key.Name && listedKey->Value == key.Value)
+                {
+                    _rideList.Keep(rideRef.id);
+                }
+                else
+                {
+                    _rideList.Add(rideRef.id, std::move(key));
+                }
             }
+            _rideList.EndUpdate();
 
             selected_list_item = -1;
             Invalidate();
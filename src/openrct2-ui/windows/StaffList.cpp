@@ -11,6 +11,7 @@
 #include <openrct2-ui/UiContext.h>
 #include <openrct2-ui/input/InputManager.h>
 #include <openrct2-ui/interface/Dropdown.h>
+#include <openrct2-ui/interface/ListModel.h>
 #include <openrct2-ui/interface/Viewport.h>
 #include <openrct2-ui/interface/ViewportQuery.h>
 #include <openrct2-ui/interface/Widget.h>
@@ -37,6 +38,8 @@
 #include <openrct2/windows/Intent.h>
 #include <openrct2/world/Footpath.h>
 #include <openrct2/world/Park.h>
+#include <optional>
+#include <string>
 #include <vector>
 
 namespace OpenRCT2::Ui::Windows
@@ -101,13 +104,16 @@ namespace OpenRCT2::Ui::Windows
             StringId ActionHire;
         };
 
-        struct StaffEntry
+        struct StaffSortKey
         {
-            EntityId Id;
             u8string Name;
+            // A copy of the custom name of the staff member when the key was made, to notice when they are renamed.
+            std::optional<std::string> CustomName;
+            uint32_t PeepId{};
         };
 
-        std::vector<StaffEntry> _staffList;
+        ListModel<EntityId, StaffSortKey> _staffList{ CompareStaffSortKey };
+        bool _staffListRealNames{};
         bool _quickFireMode{};
         std::optional<size_t> _highlightedIndex{};
         int32_t _selectedTab{};
@@ -352,30 +358,25 @@ namespace OpenRCT2::Ui::Windows
 
         void OnScrollMouseDown(int32_t scrollIndex, const ScreenCoordsXY& screenCoords) override
         {
-            int32_t i = screenCoords.y / kScrollableRowHeight;
-            for (const auto& entry : _staffList)
+            const auto i = static_cast<size_t>(screenCoords.y / kScrollableRowHeight);
+            if (i >= _staffList.size())
+                return;
+
+            const auto& entry = _staffList[i];
+            if (_quickFireMode)
+            {
+                auto staffFireAction = StaffFireAction(entry.Id);
+                GameActions::Execute(&staffFireAction);
+            }
+            else
             {
-                if (i == 0)
+                auto peep = GetEntity<Staff>(entry.Id);
+                if (peep != nullptr)
                 {
-                    if (_quickFireMode)
-                    {
-                        auto staffFireAction = StaffFireAction(entry.Id);
-                        GameActions::Execute(&staffFireAction);
-                    }
-                    else
-                    {
-                        auto peep = GetEntity<Staff>(entry.Id);
-                        if (peep != nullptr)
-                        {
-                            auto intent = Intent(WindowClass::Peep);
-                            intent.PutExtra(INTENT_EXTRA_PEEP, peep);
-                            ContextOpenIntent(&intent);
-                        }
-                    }
-                    break;
+                    auto intent = Intent(WindowClass::Peep);
+                    intent.PutExtra(INTENT_EXTRA_PEEP, peep);
+                    ContextOpenIntent(&intent);
                 }
-
-                i--;
             }
         }
 
@@ -392,76 +393,68 @@ namespace OpenRCT2::Ui::Windows
             const int32_t actionColumnSize = nonIconSpace * 0.58;
             const int32_t actionOffset = widgets[WIDX_STAFF_LIST_LIST].right - actionColumnSize - 15;
 
-            auto y = 0;
-            size_t i = 0;
-            for (const auto& entry : _staffList)
+            const auto [first, last] = _staffList.GetVisibleRange(dpi.y, dpi.y + dpi.height, kScrollableRowHeight);
+            for (size_t i = first; i < last; i++)
             {
-                if (y > dpi.y + dpi.height)
+                const auto& entry = _staffList[i];
+                const auto y = static_cast<int32_t>(i) * kScrollableRowHeight;
+
+                const auto* peep = GetEntity<Staff>(entry.Id);
+                if (peep == nullptr)
                 {
-                    break;
+                    continue;
                 }
 
-                if (y + 11 >= dpi.y)
+                StringId format = STR_BLACK_STRING;
+                if (_quickFireMode)
+                    format = STR_RED_STRINGID;
+
+                if (i == _highlightedIndex)
                 {
-                    const auto* peep = GetEntity<Staff>(entry.Id);
-                    if (peep == nullptr)
-                    {
-                        continue;
-                    }
+                    GfxFilterRect(dpi, { 0, y, 800, y + (kScrollableRowHeight - 1) }, FilterPaletteID::PaletteDarken1);
 
-                    StringId format = STR_BLACK_STRING;
+                    format = STR_WINDOW_COLOUR_2_STRINGID;
                     if (_quickFireMode)
-                        format = STR_RED_STRINGID;
-
-                    if (i == _highlightedIndex)
-                    {
-                        GfxFilterRect(dpi, { 0, y, 800, y + (kScrollableRowHeight - 1) }, FilterPaletteID::PaletteDarken1);
+                        format = STR_LIGHTPINK_STRINGID;
+                }
 
-                        format = STR_WINDOW_COLOUR_2_STRINGID;
-                        if (_quickFireMode)
-                            format = STR_LIGHTPINK_STRINGID;
-                    }
+                auto ft = Formatter();
+                ft.Add<StringId>(STR_STRING);
+                ft.Add<const char*>(entry.Key.Name.c_str());
+                DrawTextEllipsised(dpi, { 0, y }, nameColumnSize, format, ft);
 
-                    auto ft = Formatter();
-                    peep->FormatNameTo(ft);
-                    DrawTextEllipsised(dpi, { 0, y }, nameColumnSize, format, ft);
+                ft = Formatter();
+                peep->FormatActionTo(ft);
+                DrawTextEllipsised(dpi, { actionOffset, y }, actionColumnSize, format, ft);
 
-                    ft = Formatter();
-                    peep->FormatActionTo(ft);
-                    DrawTextEllipsised(dpi, { actionOffset, y }, actionColumnSize, format, ft);
+                // True if a patrol path is set for the worker
+                if (peep->HasPatrolArea())
+                {
+                    GfxDrawSprite(dpi, ImageId(SPR_STAFF_PATROL_PATH), { nameColumnSize + 5, y });
+                }
 
-                    // True if a patrol path is set for the worker
-                    if (peep->HasPatrolArea())
-                    {
-                        GfxDrawSprite(dpi, ImageId(SPR_STAFF_PATROL_PATH), { nameColumnSize + 5, y });
-                    }
+                auto staffOrderIcon_x = nameColumnSize + 20;
+                if (peep->AssignedStaffType != StaffType::Entertainer)
+                {
+                    auto staffOrders = peep->StaffOrders;
+                    auto staffOrderSprite = GetStaffOrderBaseSprite(GetSelectedStaffType());
 
-                    auto staffOrderIcon_x = nameColumnSize + 20;
-                    if (peep->AssignedStaffType != StaffType::Entertainer)
+                    while (staffOrders != 0)
                     {
-                        auto staffOrders = peep->StaffOrders;
-                        auto staffOrderSprite = GetStaffOrderBaseSprite(GetSelectedStaffType());
-
-                        while (staffOrders != 0)
+                        if (staffOrders & 1)
                         {
-                            if (staffOrders & 1)
-                            {
-                                GfxDrawSprite(dpi, ImageId(staffOrderSprite), { staffOrderIcon_x, y });
-                            }
-                            staffOrders = staffOrders >> 1;
-                            staffOrderIcon_x += 9;
-                            // TODO: Remove sprite ID addition
-                            staffOrderSprite++;
+                            GfxDrawSprite(dpi, ImageId(staffOrderSprite), { staffOrderIcon_x, y });
                         }
-                    }
-                    else
-                    {
-                        GfxDrawSprite(dpi, ImageId(GetEntertainerCostumeSprite(peep->AnimationGroup)), { staffOrderIcon_x, y });
+                        staffOrders = staffOrders >> 1;
+                        staffOrderIcon_x += 9;
+                        // TODO: Remove sprite ID addition
+                        staffOrderSprite++;
                     }
                 }
-
-                y += kScrollableRowHeight;
-                i++;
+                else
+                {
+                    GfxDrawSprite(dpi, ImageId(GetEntertainerCostumeSprite(peep->AnimationGroup)), { staffOrderIcon_x, y });
+                }
             }
         }
 
@@ -498,8 +491,15 @@ namespace OpenRCT2::Ui::Windows
 
         void RefreshList()
         {
-            _staffList.clear();
+            // The names of staff without a custom name change when real names are switched on or off.
+            const bool realNames = (GetGameState().Park.Flags & PARK_FLAGS_SHOW_REAL_STAFF_NAMES) != 0;
+            if (realNames != _staffListRealNames)
+            {
+                _staffList.Clear();
+                _staffListRealNames = realNames;
+            }
 
+            _staffList.BeginUpdate();
             for (auto* peep : EntityList<Staff>())
             {
                 EntitySetFlashing(peep, false);
@@ -507,20 +507,48 @@ namespace OpenRCT2::Ui::Windows
                 {
                     EntitySetFlashing(peep, true);
 
-                    StaffEntry entry;
-                    entry.Id = peep->Id;
-                    entry.Name = peep->GetName();
-
-                    _staffList.push_back(std::move(entry));
+                    const auto* key = _staffList.Find(peep->Id);
+                    if (key != nullptr && key->PeepId == peep->PeepId && IsSameCustomName(key->CustomName, *peep))
+                    {
+                        _staffList.Keep(peep->Id);
+                    }
+                    else
+                    {
+                        _staffList.Add(peep->Id, { peep->GetName(), GetCustomName(*peep), peep->PeepId });
+                    }
                 }
             }
+            _staffList.EndUpdate();
+        }
 
-            std::sort(_staffList.begin(), _staffList.end(), [](const auto& a, const auto& b) {
-                return StrLogicalCmp(a.Name.c_str(), b.Name.c_str()) < 0;
-            });
+        void OnLanguageChange() override
+        {
+            // Generated names are formatted in the new language.
+            _staffList.Clear();
+            RefreshList();
         }
 
     private:
+        static std::optional<std::string> GetCustomName(const Peep& peep)
+        {
+            if (peep.Name == nullptr)
+                return std::nullopt;
+            return std::string(peep.Name);
+        }
+
+        // Compares the contents, the name may since have been freed and another allocated at the same address.
+        static bool IsSameCustomName(const std::optional<std::string>& customName, const Peep& peep)
+        {
+            if (peep.Name == nullptr)
+                return !customName.has_value();
+            return customName.has_value() && *customName == peep.Name;
+        }
+
+        static bool CompareStaffSortKey(const StaffSortKey& a, const StaffSortKey& b)
+        {
+            return StrLogicalCmp(a.Name.c_str(), b.Name.c_str()) < 0;
+        }
+
         /**
          * Hires a new staff member of the given type.
          */
@@ -32,6 +32,7 @@
 #include <openrct2/ui/UiContext.h>
 #include <openrct2/ui/WindowManager.h>
 #include <openrct2/windows/Intent.h>
+#include <openrct2/world/ConstructionClearance.h>
 #include <openrct2/world/Park.h>
 #include <openrct2/world/Surface.h>
 #include <openrct2/world/tile_element/Slope.h>
@@ -705,6 +706,8 @@ namespace OpenRCT2::Ui::Windows
 
         GameActions::Result FindValidTrackDesignPlaceHeight(CoordsXYZ& loc, uint32_t newFlags)
         {
+            // The queries do not change the map, so every height tried can share the clearance summaries.
+            ClearanceQueryScope clearanceScope;
             GameActions::Result res;
             for (int32_t i = 0; i < 7; i++, loc.z += kCoordsZStep)
             {
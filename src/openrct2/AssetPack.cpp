@@ -144,6 +144,16 @@ public:
         return ObjectAsset(_zipPath, path);
     }
 
+    const ObjectBundleEntry* GetBundleEntry() override
+    {
+        return nullptr;
+    }
+
+    ObjectBundleEntry* GetNewBundleEntry() override
+    {
+        return nullptr;
+    }
+
     void LogVerbose(ObjectError code, const utf8* text) override
     {
     }
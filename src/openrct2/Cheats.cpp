@@ -45,6 +45,7 @@ void CheatsReset()
     gameState.Cheats.BuildInPauseMode = false;
     gameState.Cheats.IgnoreRideIntensity = false;
     gameState.Cheats.IgnorePrice = false;
+    gameState.Cheats.FootpathGraphPathfinding = false;
     gameState.Cheats.DisableVandalism = false;
     gameState.Cheats.DisableLittering = false;
     gameState.Cheats.NeverendingMarketing = false;
@@ -116,6 +117,7 @@ void CheatsSerialise(DataSerialiser& ds)
         CheatEntrySerialise(ds, CheatType::MakeDestructible, gameState.Cheats.MakeAllDestructible, count);
         CheatEntrySerialise(ds, CheatType::SetStaffSpeed, gameState.Cheats.SelectedStaffSpeed, count);
         CheatEntrySerialise(ds, CheatType::IgnorePrice, gameState.Cheats.IgnorePrice, count);
+        CheatEntrySerialise(ds, CheatType::FootpathGraphPathfinding, gameState.Cheats.FootpathGraphPathfinding, count);
 
         // Remember current position and update count.
         uint64_t endOffset = stream.GetPosition();
@@ -172,6 +174,9 @@ void CheatsSerialise(DataSerialiser& ds)
                 case CheatType::IgnorePrice:
                     ds << gameState.Cheats.IgnorePrice;
                     break;
+                case CheatType::FootpathGraphPathfinding:
+                    ds << gameState.Cheats.FootpathGraphPathfinding;
+                    break;
                 case CheatType::DisableVandalism:
                     ds << gameState.Cheats.DisableVandalism;
                     break;
@@ -260,6 +265,8 @@ const char* CheatsGetName(CheatType cheatType)
             return LanguageGetString(STR_CHEAT_IGNORE_INTENSITY);
         case CheatType::IgnorePrice:
             return LanguageGetString(STR_CHEAT_IGNORE_PRICE);
+        case CheatType::FootpathGraphPathfinding:
+            return LanguageGetString(STR_CHEAT_FOOTPATH_GRAPH_PATHFINDING);
         case CheatType::DisableVandalism:
             return LanguageGetString(STR_CHEAT_DISABLE_VANDALISM);
         case CheatType::DisableLittering:
@@ -31,6 +31,7 @@ struct CheatsState
     bool BuildInPauseMode;
     bool IgnoreRideIntensity;
     bool IgnorePrice;
+    bool FootpathGraphPathfinding;
     bool DisableVandalism;
     bool DisableLittering;
     bool NeverendingMarketing;
@@ -105,6 +106,7 @@ enum class CheatType : int32_t
     AllowSpecialColourSchemes,
     RemoveParkFences,
     IgnorePrice,
+    FootpathGraphPathfinding,
     Count,
 };
 
@@ -59,6 +59,7 @@
 #include "park/ParkFile.h"
 #include "platform/Crash.h"
 #include "platform/Platform.h"
+#include "profiling/Metrics.h"
 #include "profiling/Profiling.h"
 #include "rct2/RCT2.h"
 #include "ride/TrackData.h"
@@ -149,6 +150,7 @@ namespace OpenRCT2
         float _realtimeAccumulator = 0.0f;
         float _timeScale = 1.0f;
         bool _variableFrame = false;
+        Timer _metricsExportTimer;
 
         // If set, will end the OpenRCT2 game loop. Intentionally private to this module so that the flag can not be set back to
         // false.
@@ -1280,6 +1282,26 @@ namespace OpenRCT2
             {
                 RunFixedFrame(deltaTime);
             }
+
+            Metrics::Update();
+            ExportMetricsIfDue();
+        }
+
+        void ExportMetricsIfDue()
+        {
+            const auto& networkConfig = Config::Get().network;
+            if (networkConfig.MetricsExportPath.empty())
+                return;
+
+            const auto interval = std::max(1, networkConfig.MetricsExportInterval);
+            if (_metricsExportTimer.GetElapsedTime().count() < interval)
+                return;
+
+            _metricsExportTimer.Restart();
+            if (!Metrics::ExportJson(networkConfig.MetricsExportPath))
+            {
+                LOG_WARNING("Unable to export metrics to '%s'", networkConfig.MetricsExportPath.c_str());
+            }
         }
 
         void UpdateTimeAccumulators(float deltaTime)
@@ -1366,9 +1388,15 @@ namespace OpenRCT2
         {
             PROFILED_FUNCTION();
 
+            static auto& paintStructsMetric = Metrics::GetCounter("paint.structs");
+            static auto& paintStructsPerFrameMetric = Metrics::GetHistogram("paint.structs_per_frame");
+            const auto paintStructsBefore = paintStructsMetric.GetValue();
+
             _drawingEngine->BeginDraw();
             _painter->Paint(*_drawingEngine);
             _drawingEngine->EndDraw();
+
+            paintStructsPerFrameMetric.Record(static_cast<double>(paintStructsMetric.GetValue() - paintStructsBefore));
         }
 
         void Tick()
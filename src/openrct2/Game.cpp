@@ -321,6 +321,9 @@ void GameFixSaveVars()
 
     FixPeepsWithInvalidRideReference();
 
+    // Link the guests in ride queues to the guests behind them
+    RideRebuildQueues();
+
     FixInvalidSurfaces();
 
     ResearchFix();
@@ -16,10 +16,12 @@
 #include "ReplayManager.h"
 #include "actions/GameAction.h"
 #include "config/Config.h"
+#include "core/Timer.hpp"
 #include "entity/EntityTweener.h"
 #include "entity/PatrolArea.h"
 #include "interface/Screenshot.h"
 #include "platform/Platform.h"
+#include "profiling/Metrics.h"
 #include "profiling/Profiling.h"
 #include "ride/Vehicle.h"
 #include "scenes/title/TitleScene.h"
@@ -35,6 +37,11 @@ namespace OpenRCT2
 {
     static auto _gameState = std::make_unique<GameState_t>();
 
+    // At higher game speeds a tick runs several updates. When they take longer than this the rest are deferred to
+    // the following ticks, so that frames are still drawn and input is handled while the game catches up.
+    static constexpr float kGameSpeedUpdateBudget = kGameUpdateTimeMS * 0.75f;
+    static uint32_t _deferredUpdates;
+
     GameState_t& GetGameState()
     {
         return *_gameState;
@@ -103,6 +110,7 @@ namespace OpenRCT2
 
         // Normal game play will update only once every kGameUpdateTimeMS
         uint32_t numUpdates = 1;
+        uint32_t numCatchUpUpdates = 0;
 
         // 0x006E3AEC // screen_game_process_mouse_input();
         ScreenshotCheck();
@@ -131,8 +139,21 @@ namespace OpenRCT2
             {
                 // Update more often if game speed is above normal.
                 numUpdates = 1 << (gGameSpeed - 1);
+
+                // Catch up on deferred updates, at most doubling the updates of this tick.
+                numCatchUpUpdates = std::min(_deferredUpdates, numUpdates);
+                numUpdates += numCatchUpUpdates;
             }
         }
+        _deferredUpdates -= numCatchUpUpdates;
+
+        // Deferred updates are only caught up on while the game runs faster than normal
+        static auto& droppedUpdatesMetric = Metrics::GetCounter("game.dropped_updates");
+        if (_deferredUpdates != 0 && (gGameSpeed == 1 || NetworkGetMode() == NETWORK_MODE_CLIENT))
+        {
+            droppedUpdatesMetric.Add(_deferredUpdates);
+            _deferredUpdates = 0;
+        }
 
         bool isPaused = GameIsPaused();
         if (NetworkGetMode() == NETWORK_MODE_SERVER && Config::Get().network.PauseServerIfNoClients)
@@ -147,6 +168,9 @@ namespace OpenRCT2
         bool didRunSingleFrame = false;
         if (isPaused)
         {
+            // Keep the deferred updates for when the game is unpaused
+            _deferredUpdates += numCatchUpUpdates;
+
             if (gDoSingleUpdate && NetworkGetMode() == NETWORK_MODE_NONE)
             {
                 didRunSingleFrame = true;
@@ -181,6 +205,8 @@ namespace OpenRCT2
         }
 
         // Update the game one or more times
+        static auto& deferredUpdatesMetric = Metrics::GetCounter("game.deferred_updates");
+        Timer updatesTimer;
         for (uint32_t i = 0; i < numUpdates; i++)
         {
             gameStateUpdateLogic();
@@ -203,6 +229,21 @@ namespace OpenRCT2
             isPaused |= GameIsPaused();
             if (isPaused)
                 break;
+
+            const auto remainingUpdates = numUpdates - (i + 1);
+            if (gGameSpeed > 1 && remainingUpdates > 0 && NetworkGetMode() != NETWORK_MODE_CLIENT
+                && updatesTimer.GetElapsedTime().count() >= kGameSpeedUpdateBudget)
+            {
+                // Carry at most a second of updates over, so that a game that can never keep up does not fall
+                // further and further behind.
+                const auto maxDeferredUpdates = (1u << (gGameSpeed - 1)) * kGameUpdateFPS;
+                const auto room = maxDeferredUpdates > _deferredUpdates ? maxDeferredUpdates - _deferredUpdates : 0;
+                const auto numDeferred = std::min(remainingUpdates, room);
+                _deferredUpdates += numDeferred;
+                deferredUpdatesMetric.Add(numDeferred);
+                droppedUpdatesMetric.Add(remainingUpdates - numDeferred);
+                break;
+            }
         }
 
         NetworkFlush();
@@ -242,6 +283,10 @@ namespace OpenRCT2
     {
         PROFILED_FUNCTION();
 
+        static auto& ticksMetric = Metrics::GetCounter("game.ticks");
+        static auto& tickTimeMetric = Metrics::GetHistogram("game.tick_time_ms");
+        Timer tickTimer;
+
         gInUpdateCode = true;
 
         gScreenAge++;
@@ -300,6 +345,7 @@ namespace OpenRCT2
         ScenarioUpdate(gameState);
         ClimateUpdate();
         MapUpdateTiles();
+        MapUpdateTileElementCompaction();
 
         // Temporarily remove provisional paths to prevent peep from interacting with them
         auto removeProvisionalIntent = Intent(INTENT_ACTION_REMOVE_PROVISIONAL_ELEMENTS);
@@ -356,5 +402,8 @@ namespace OpenRCT2
 #endif
 
         gInUpdateCode = false;
+
+        ticksMetric.Add();
+        tickTimeMetric.Record(tickTimer.GetElapsedTime().count() * 1000.0);
     }
 } // namespace OpenRCT2
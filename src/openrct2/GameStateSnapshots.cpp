@@ -10,6 +10,7 @@
 #include "GameStateSnapshots.h"
 
 #include "Diagnostic.h"
+#include "GameState.h"
 #include "core/CircularBuffer.h"
 #include "entity/Balloon.h"
 #include "entity/Duck.h"
@@ -23,8 +24,12 @@
 #include "entity/Staff.h"
 #include "ride/Vehicle.h"
 
+#include <bit>
+#include <cstring>
+
 static constexpr size_t MaximumGameStateSnapshots = 32;
 static constexpr uint32_t InvalidTick = 0xFFFFFFFF;
+static constexpr size_t kEntityBitmapWords = (MAX_ENTITIES + 63) / 64;
 
 #pragma pack(push, 1)
 union EntitySnapshot
@@ -37,6 +42,7 @@ union EntitySnapshot
     }
 };
 static_assert(sizeof(EntitySnapshot) == 0x200);
+static_assert(sizeof(EntitySnapshot) == sizeof(OpenRCT2::Entity_t));
 #pragma pack(pop)
 
 struct GameStateSnapshot_t
@@ -54,6 +60,87 @@ struct GameStateSnapshot_t
     OpenRCT2::MemoryStream storedSprites;
     OpenRCT2::MemoryStream parkParameters;
 
+    // Capturing copies the entities as they are in memory, which is far cheaper than serialising them every tick.
+    // The copy is only serialised into storedSprites once the snapshot is sent, saved or compared. The buffers are
+    // kept when the snapshot is reused, so capturing does not allocate once they are large enough.
+    std::array<uint64_t, kEntityBitmapWords> capturedBitmap{};
+    // The number of captured entities in the words of the bitmap before each word.
+    std::array<uint32_t, kEntityBitmapWords> capturedRank{};
+    std::vector<EntitySnapshot> capturedEntities;
+    bool hasPendingCapture = false;
+
+    void Reset()
+    {
+        tick = InvalidTick;
+        srand0 = 0;
+        storedSprites = OpenRCT2::MemoryStream();
+        parkParameters = OpenRCT2::MemoryStream();
+        hasPendingCapture = false;
+    }
+
+    void CaptureEntities()
+    {
+        capturedBitmap.fill(0);
+        for (uint8_t type = 0; type < EnumValue(EntityType::Count); type++)
+        {
+            for (auto id : GetEntityList(static_cast<EntityType>(type)))
+            {
+                const auto index = id.ToUnderlying();
+                capturedBitmap[index / 64] |= 1uLL << (index % 64);
+            }
+        }
+
+        uint32_t numEntities = 0;
+        for (size_t i = 0; i < kEntityBitmapWords; i++)
+        {
+            capturedRank[i] = numEntities;
+            numEntities += std::popcount(capturedBitmap[i]);
+        }
+        if (capturedEntities.size() < numEntities)
+        {
+            capturedEntities.resize(numEntities);
+        }
+
+        // Copy each range of consecutive entities at once.
+        const auto& entities = OpenRCT2::GetGameState().Entities;
+        uint32_t numCopied = 0;
+        for (size_t i = 0; i < kEntityBitmapWords; i++)
+        {
+            auto bits = capturedBitmap[i];
+            while (bits != 0)
+            {
+                const auto start = std::countr_zero(bits);
+                const auto length = std::countr_one(bits >> start);
+                std::memcpy(
+                    static_cast<void*>(&capturedEntities[numCopied]), &entities[i * 64 + start],
+                    length * sizeof(EntitySnapshot));
+                numCopied += length;
+                bits &= length == 64 ? 0 : ~(((1uLL << length) - 1) << start);
+            }
+        }
+        hasPendingCapture = true;
+    }
+
+    EntitySnapshot* GetCapturedEntity(EntityId id)
+    {
+        const auto index = id.ToUnderlying();
+        const auto word = capturedBitmap[index / 64];
+        const auto bit = 1uLL << (index % 64);
+        if ((word & bit) == 0)
+            return nullptr;
+        return &capturedEntities[capturedRank[index / 64] + std::popcount(word & (bit - 1))];
+    }
+
+    // Serialises the captured entities into storedSprites, if that has not been done yet.
+    void SerialiseCapture()
+    {
+        if (!hasPendingCapture)
+            return;
+
+        SerialiseSprites([this](const EntityId index) { return GetCapturedEntity(index); }, MAX_ENTITIES, true);
+        hasPendingCapture = false;
+    }
+
     template<typename T> bool EntitySizeCheck(DataSerialiser& ds)
     {
         uint32_t size = sizeof(T);
@@ -170,7 +257,17 @@ struct GameStateSnapshots final : public IGameStateSnapshots
 
     virtual GameStateSnapshot_t& CreateSnapshot() override final
     {
-        auto snapshot = std::make_unique<GameStateSnapshot_t>();
+        // Reuse the oldest snapshot and its buffers when the history is full.
+        std::unique_ptr<GameStateSnapshot_t> snapshot;
+        if (_snapshots.size() == _snapshots.capacity())
+        {
+            snapshot = std::move(_snapshots.front());
+            snapshot->Reset();
+        }
+        else
+        {
+            snapshot = std::make_unique<GameStateSnapshot_t>();
+        }
         _snapshots.push_back(std::move(snapshot));
 
         return *_snapshots.back();
@@ -184,10 +281,7 @@ struct GameStateSnapshots final : public IGameStateSnapshots
 
     virtual void Capture(GameStateSnapshot_t& snapshot) override final
     {
-        snapshot.SerialiseSprites(
-            [](const EntityId index) { return reinterpret_cast<EntitySnapshot*>(GetEntity(index)); }, MAX_ENTITIES, true);
-
-        // LOG_INFO("Snapshot size: %u bytes", static_cast<uint32_t>(snapshot.storedSprites.GetLength()));
+        snapshot.CaptureEntities();
     }
 
     virtual const GameStateSnapshot_t* GetLinkedSnapshot(uint32_t tick) const override final
@@ -202,6 +296,15 @@ struct GameStateSnapshots final : public IGameStateSnapshots
 
     virtual void SerialiseSnapshot(GameStateSnapshot_t& snapshot, DataSerialiser& ds) const override final
     {
+        if (ds.IsSaving())
+        {
+            snapshot.SerialiseCapture();
+        }
+        else
+        {
+            snapshot.hasPendingCapture = false;
+        }
+
         ds << snapshot.tick;
         ds << snapshot.srand0;
         ds << snapshot.storedSprites;
@@ -210,6 +313,9 @@ struct GameStateSnapshots final : public IGameStateSnapshots
 
     std::vector<EntitySnapshot> BuildSpriteList(GameStateSnapshot_t& snapshot) const
     {
+        // Compare what would be sent, the captured entities also hold fields that are not serialised.
+        snapshot.SerialiseCapture();
+
         std::vector<EntitySnapshot> spriteList;
         spriteList.resize(MAX_ENTITIES);
 
@@ -52,6 +52,7 @@ namespace OpenRCT2
         CRASH,            // Contains crash dumps.
         ASSET_PACK,       // Contains asset packs.
         SCENARIO_PATCHES, // Contains scenario patches.
+        OBJECT_STORE,     // Contains packed objects referenced by saved games, by content hash.
     };
 
     enum class PATHID
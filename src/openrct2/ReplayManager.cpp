@@ -38,7 +38,10 @@
 #include "world/Park.h"
 #include "zlib.h"
 
+#include <algorithm>
+#include <array>
 #include <chrono>
+#include <limits>
 #include <memory>
 #include <vector>
 
@@ -81,6 +84,16 @@ namespace OpenRCT2
         OpenRCT2::MemoryStream data;
     };
 
+    struct ReplayKeyframe
+    {
+        uint32_t tick = 0;
+        // Commands with a lower index had been executed when the keyframe was taken.
+        uint32_t commandIndex = 0;
+        EntitiesChecksum checksum{};
+        OpenRCT2::MemoryStream parkData;
+        OpenRCT2::MemoryStream parkParams;
+    };
+
     struct ReplayRecordData
     {
         uint32_t magic;
@@ -98,15 +111,19 @@ namespace OpenRCT2
         std::vector<std::pair<uint32_t, EntitiesChecksum>> checksums;
         uint32_t checksumIndex;
         OpenRCT2::MemoryStream gameStateSnapshots;
+        std::vector<ReplayKeyframe> keyframes;
     };
 
     class ReplayManager final : public IReplayManager
     {
-        static constexpr uint16_t kReplayVersion = 10;
+        static constexpr uint16_t kReplayVersion = 11;
+        static constexpr uint16_t kReplayKeyframesVersion = 11;
         static constexpr uint32_t kReplayMagic = 0x5243524F; // ORCR.
         static constexpr int kReplayCompressionLevel = 9;
         static constexpr int kNormalRecordingChecksumTicks = 1;
         static constexpr int kSilentRecordingChecksumTicks = 40; // Same as network server
+        // A keyframe is a saved park, so seeking never has to simulate more than this many ticks.
+        static constexpr uint32_t kDefaultKeyframeIntervalTicks = 4000;
 
         enum class ReplayMode
         {
@@ -172,6 +189,13 @@ namespace OpenRCT2
                 _nextChecksumTick = currentTicks + ChecksumTicksDelta();
             }
 
+            if ((_mode == ReplayMode::RECORDING || _mode == ReplayMode::NORMALISATION) && currentTicks >= _nextKeyframeTick)
+            {
+                AddKeyframe(currentTicks);
+
+                _nextKeyframeTick = currentTicks + _keyframeIntervalTicks;
+            }
+
             if (_mode == ReplayMode::RECORDING)
             {
                 if (currentTicks >= _currentRecording->tickEnd)
@@ -204,7 +228,7 @@ namespace OpenRCT2
                 ReplayCommands();
 
                 // If we run out of commands we can just stop
-                if (_currentReplay->commands.empty())
+                if (_nextCommand == _currentReplay->commands.end())
                 {
                     StopPlayback();
                     StopRecording();
@@ -216,6 +240,26 @@ namespace OpenRCT2
             }
         }
 
+        void AddKeyframe(uint32_t tick)
+        {
+            CaptureKeyframe(_currentRecording->keyframes.emplace_back(), tick, _commandId);
+        }
+
+        void CaptureKeyframe(ReplayKeyframe& keyframe, uint32_t tick, uint32_t commandIndex)
+        {
+            keyframe.tick = tick;
+            keyframe.commandIndex = commandIndex;
+            keyframe.checksum = GetAllEntitiesChecksum();
+
+            // Objects packed into the park are added to the object repository when the start of the replay is
+            // loaded, so the keyframes do not need to carry them.
+            auto exporter = std::make_unique<ParkFileExporter>();
+            exporter->Export(GetGameState(), keyframe.parkData);
+
+            DataSerialiser parkParamsDs(true, keyframe.parkParams);
+            SerialiseParkParameters(parkParamsDs);
+        }
+
         void TakeGameStateSnapshot(MemoryStream& snapshotStream)
         {
             IGameStateSnapshots* snapshots = GetContext()->GetGameStateSnapshots();
@@ -278,10 +322,16 @@ namespace OpenRCT2
             _currentRecording = std::move(replayData);
             _recordType = rt;
             _nextChecksumTick = currentTicks + 1;
+            _nextKeyframeTick = currentTicks + _keyframeIntervalTicks;
 
             return true;
         }
 
+        virtual void SetKeyframeInterval(uint32_t ticks) override
+        {
+            _keyframeIntervalTicks = std::max<uint32_t>(ticks, 1);
+        }
+
         virtual bool StopRecording(bool discard = false) override
         {
             if (_mode != ReplayMode::RECORDING && _mode != ReplayMode::NORMALISATION)
@@ -384,6 +434,7 @@ namespace OpenRCT2
                 info.Ticks = data->tickEnd - data->tickStart;
             info.NumCommands = static_cast<uint32_t>(data->commands.size());
             info.NumChecksums = static_cast<uint32_t>(data->checksums.size());
+            info.NumKeyframes = static_cast<uint32_t>(data->keyframes.size());
 
             return true;
         }
@@ -442,7 +493,7 @@ namespace OpenRCT2
                 return false;
             }
 
-            if (!LoadReplayDataMap(*replayData))
+            if (!LoadReplayDataMap(replayData->parkData, replayData->parkParams))
             {
                 LOG_ERROR("Unable to load map.");
                 return false;
@@ -454,6 +505,7 @@ namespace OpenRCT2
 
             _currentReplay = std::move(replayData);
             _currentReplay->checksumIndex = 0;
+            _nextCommand = _currentReplay->commands.begin();
             _faultyChecksumIndex = -1;
 
             // Make sure game is not paused.
@@ -515,7 +567,237 @@ namespace OpenRCT2
             return true;
         }
 
+        virtual bool SeekPlayback(uint32_t replayTick) override
+        {
+            if (_mode != ReplayMode::PLAYING)
+                return false;
+
+            if (replayTick > _currentReplay->tickEnd - _currentReplay->tickStart)
+                return false;
+
+            const auto tick = _currentReplay->tickStart + replayTick;
+
+            // Restore the last keyframe before the tick, unless playing on from the current tick is quicker.
+            auto* keyframe = FindKeyframeBefore(tick);
+
+            const auto currentTicks = GetGameState().CurrentTicks;
+            if (tick < currentTicks || (keyframe != nullptr && keyframe->tick > currentTicks))
+            {
+                if (!RestoreKeyframe(keyframe))
+                    return false;
+            }
+
+            return PlayUntil(tick);
+        }
+
+        virtual std::vector<uint32_t> GetKeyframeTicks() const override
+        {
+            std::vector<uint32_t> ticks;
+            if (_currentReplay != nullptr)
+            {
+                for (const auto& keyframe : _currentReplay->keyframes)
+                {
+                    ticks.push_back(keyframe.tick - _currentReplay->tickStart);
+                }
+            }
+            return ticks;
+        }
+
+        virtual bool VerifyKeyframe(size_t index) override
+        {
+            if (_mode != ReplayMode::PLAYING || index >= _currentReplay->keyframes.size())
+                return false;
+
+            auto& keyframe = _currentReplay->keyframes[index];
+            if (!RestoreKeyframe(index > 0 ? &_currentReplay->keyframes[index - 1] : nullptr))
+                return false;
+            if (!PlayUntil(keyframe.tick))
+                return false;
+
+            // The keyframe was taken after the commands given before its tick had run.
+            ExecuteCommandsBefore(keyframe.commandIndex);
+
+            EntitiesChecksum checksum = GetAllEntitiesChecksum();
+            if (checksum.raw != keyframe.checksum.raw)
+            {
+                LOG_WARNING(
+                    "Different sprite checksum at keyframe %zu, tick %u ; Saved: %s, Current: %s", index, keyframe.tick,
+                    keyframe.checksum.ToString().c_str(), checksum.ToString().c_str());
+                return false;
+            }
+            return true;
+        }
+
+        virtual bool BisectReplays(
+            const std::string& fileA, const std::string& fileB, ReplayBisectResult& result) override
+        {
+            if (_mode != ReplayMode::NONE)
+                return false;
+
+            std::array<std::unique_ptr<ReplayRecordData>, 2> replays;
+            for (size_t i = 0; i < replays.size(); i++)
+            {
+                replays[i] = std::make_unique<ReplayRecordData>();
+                if (!ReadReplayData(i == 0 ? fileA : fileB, *replays[i]))
+                {
+                    LOG_ERROR("Unable to read replay data.");
+                    return false;
+                }
+            }
+
+            const auto tickStart = replays[0]->tickStart;
+            if (replays[1]->tickStart != tickStart)
+            {
+                LOG_ERROR(
+                    "The replays start at different ticks, %u and %u, they have to start from the same park.", tickStart,
+                    replays[1]->tickStart);
+                return false;
+            }
+            const auto tickEnd = std::min(replays[0]->tickEnd, replays[1]->tickEnd);
+
+            IGameStateSnapshots* snapshots = GetContext()->GetGameStateSnapshots();
+            const bool silentReplays = gSilentReplays;
+            gSilentReplays = true;
+
+            result = {};
+            bool loaded = true;
+
+            // Brings one of the replays to the tick and captures its state, keeping the state as a keyframe so that
+            // later steps of the search, which only get closer to it, can start from there.
+            auto captureAt = [&](size_t index, uint32_t tick) -> GameStateSnapshot_t& {
+                _currentReplay = std::move(replays[index]);
+                _mode = ReplayMode::PLAYING;
+
+                auto* keyframe = FindKeyframeBefore(tick);
+                loaded &= RestoreKeyframe(keyframe);
+                loaded &= PlayUntil(tick);
+                result.NumSegments++;
+
+                if (loaded && (keyframe == nullptr || keyframe->tick != tick))
+                {
+                    auto& keyframes = _currentReplay->keyframes;
+                    auto it = std::upper_bound(
+                        keyframes.begin(), keyframes.end(), tick,
+                        [](uint32_t value, const ReplayKeyframe& kf) { return value < kf.tick; });
+                    const auto commandIndex = _nextCommand != _currentReplay->commands.end()
+                        ? _nextCommand->commandIndex
+                        : std::numeric_limits<uint32_t>::max();
+                    CaptureKeyframe(*keyframes.emplace(it), tick, commandIndex);
+                }
+
+                auto& snapshot = snapshots->CreateSnapshot();
+                snapshots->Capture(snapshot);
+                snapshots->LinkSnapshot(snapshot, tick, ScenarioRandState().s0);
+
+                replays[index] = std::move(_currentReplay);
+                _mode = ReplayMode::NONE;
+                return snapshot;
+            };
+
+            auto compareAt = [&](uint32_t tick, GameStateCompareData& cmpData) {
+                auto& snapshotA = captureAt(0, tick);
+                auto& snapshotB = captureAt(1, tick);
+                cmpData = snapshots->Compare(snapshotA, snapshotB);
+                if (cmpData.srand0Left != cmpData.srand0Right)
+                    return false;
+                return std::all_of(cmpData.spriteChanges.begin(), cmpData.spriteChanges.end(), [](const auto& change) {
+                    return change.changeType == GameStateSpriteChange::EQUAL;
+                });
+            };
+
+            // Assuming the replays stay apart once they differ, search for the first tick at which they do.
+            GameStateCompareData cmpData;
+            uint32_t low = tickStart;
+            uint32_t high = tickEnd;
+            if (!compareAt(low, cmpData))
+            {
+                high = low;
+            }
+            else if (!compareAt(high, cmpData))
+            {
+                GameStateCompareData highCmpData = std::move(cmpData);
+                while (loaded && high - low > 1)
+                {
+                    const auto mid = low + (high - low) / 2;
+                    if (compareAt(mid, cmpData))
+                    {
+                        low = mid;
+                    }
+                    else
+                    {
+                        high = mid;
+                        highCmpData = std::move(cmpData);
+                    }
+                }
+                cmpData = std::move(highCmpData);
+            }
+            else
+            {
+                high = k_MaxReplayTicks;
+            }
+
+            gSilentReplays = silentReplays;
+            if (!loaded)
+                return false;
+
+            result.Diverged = high != k_MaxReplayTicks;
+            if (result.Diverged)
+            {
+                result.Tick = high - tickStart;
+                result.CompareText = snapshots->GetCompareDataText(cmpData);
+            }
+            return true;
+        }
+
     private:
+        ReplayKeyframe* FindKeyframeBefore(uint32_t tick)
+        {
+            auto& keyframes = _currentReplay->keyframes;
+            auto it = std::upper_bound(keyframes.begin(), keyframes.end(), tick, [](uint32_t value, const ReplayKeyframe& kf) {
+                return value < kf.tick;
+            });
+            return it != keyframes.begin() ? &*std::prev(it) : nullptr;
+        }
+
+        /**
+         * Loads the park saved with the keyframe, or the start of the replay when it is nullptr, and continues the
+         * playback from there.
+         */
+        bool RestoreKeyframe(ReplayKeyframe* keyframe)
+        {
+            auto& replay = *_currentReplay;
+            auto& parkData = keyframe != nullptr ? keyframe->parkData : replay.parkData;
+            auto& parkParams = keyframe != nullptr ? keyframe->parkParams : replay.parkParams;
+            if (!LoadReplayDataMap(parkData, parkParams))
+            {
+                LOG_ERROR("Unable to load keyframe.");
+                return false;
+            }
+
+            const auto tick = keyframe != nullptr ? keyframe->tick : replay.tickStart;
+            GetGameState().CurrentTicks = tick;
+
+            const ReplayCommand firstCommand(tick, nullptr, keyframe != nullptr ? keyframe->commandIndex : 0);
+            _nextCommand = replay.commands.lower_bound(firstCommand);
+
+            auto checksum = std::lower_bound(
+                replay.checksums.begin(), replay.checksums.end(), tick,
+                [](const std::pair<uint32_t, EntitiesChecksum>& entry, uint32_t value) { return entry.first < value; });
+            replay.checksumIndex = static_cast<uint32_t>(std::distance(replay.checksums.begin(), checksum));
+            return true;
+        }
+
+        // Simulates ticks until the given tick, returns false if the playback stopped before it.
+        bool PlayUntil(uint32_t tick)
+        {
+            auto& gameState = GetGameState();
+            while (_mode == ReplayMode::PLAYING && gameState.CurrentTicks < tick)
+            {
+                gameStateUpdateLogic();
+            }
+            return gameState.CurrentTicks == tick;
+        }
+
         int ChecksumTicksDelta() const
         {
             switch (_recordType)
@@ -528,17 +810,18 @@ namespace OpenRCT2
             }
         }
 
-        bool LoadReplayDataMap(ReplayRecordData& data)
+        bool LoadReplayDataMap(MemoryStream& parkData, MemoryStream& parkParams)
         {
             try
             {
-                data.parkData.SetPosition(0);
+                parkData.SetPosition(0);
+                parkParams.SetPosition(0);
 
                 auto context = GetContext();
                 auto& objManager = context->GetObjectManager();
                 auto importer = ParkImporter::CreateParkFile(context->GetObjectRepository());
 
-                auto loadResult = importer->LoadFromStream(&data.parkData, false);
+                auto loadResult = importer->LoadFromStream(&parkData, false);
                 objManager.LoadObjects(loadResult.RequiredObjects);
 
                 // TODO: Have a separate GameState and exchange once loaded.
@@ -548,7 +831,7 @@ namespace OpenRCT2
                 EntityTweener::Get().Reset();
 
                 // Load all map global variables.
-                DataSerialiser parkParamsDs(false, data.parkParams);
+                DataSerialiser parkParamsDs(false, parkParams);
                 SerialiseParkParameters(parkParamsDs);
 
                 GameLoadInit();
@@ -723,7 +1006,8 @@ namespace OpenRCT2
 
         bool Compatible(ReplayRecordData& data)
         {
-            return data.version == kReplayVersion;
+            // Replays from before keyframes were added play back the same, they can only not seek as quickly.
+            return data.version == kReplayVersion || data.version == kReplayKeyframesVersion - 1;
         }
 
         bool Serialise(DataSerialiser& serialiser, ReplayRecordData& data)
@@ -796,6 +1080,26 @@ namespace OpenRCT2
             }
 
             serialiser << data.gameStateSnapshots;
+
+            if (data.version >= kReplayKeyframesVersion)
+            {
+                uint32_t countKeyframes = static_cast<uint32_t>(data.keyframes.size());
+                serialiser << countKeyframes;
+
+                if (serialiser.IsLoading())
+                {
+                    data.keyframes.resize(countKeyframes);
+                }
+
+                for (auto& keyframe : data.keyframes)
+                {
+                    serialiser << keyframe.tick;
+                    serialiser << keyframe.commandIndex;
+                    serialiser << keyframe.checksum.raw;
+                    serialiser << keyframe.parkData;
+                    serialiser << keyframe.parkParams;
+                }
+            }
             return true;
         }
 
@@ -837,15 +1141,47 @@ namespace OpenRCT2
         }
 #endif // DISABLE_NETWORK
 
+        void ExecuteCommand(const ReplayCommand& command)
+        {
+            bool isPositionValid = false;
+
+            GameAction* action = command.action.get();
+            action->SetFlags(action->GetFlags() | GAME_COMMAND_FLAG_REPLAY);
+
+            GameActions::Result result = GameActions::Execute(action);
+            if (result.Error == GameActions::Status::Ok)
+            {
+                isPositionValid = true;
+            }
+
+            // Focus camera on event.
+            if (!gSilentReplays && isPositionValid && !result.Position.IsNull())
+            {
+                auto* mainWindow = WindowGetMain();
+                if (mainWindow != nullptr)
+                    WindowScrollToLocation(*mainWindow, result.Position);
+            }
+        }
+
+        void ExecuteCommandsBefore(uint32_t commandIndex)
+        {
+            while (_nextCommand != _currentReplay->commands.end() && _nextCommand->commandIndex < commandIndex)
+            {
+                ExecuteCommand(*_nextCommand);
+                ++_nextCommand;
+            }
+        }
+
         void ReplayCommands()
         {
             auto& replayQueue = _currentReplay->commands;
 
             const auto currentTicks = GetGameState().CurrentTicks;
 
-            while (replayQueue.begin() != replayQueue.end())
+            // Executed commands are kept, so that seeking back can run them again.
+            while (_nextCommand != replayQueue.end())
             {
-                const ReplayCommand& command = (*replayQueue.begin());
+                const ReplayCommand& command = *_nextCommand;
 
                 if (_mode == ReplayMode::PLAYING)
                 {
@@ -862,26 +1198,8 @@ namespace OpenRCT2
                     _nextReplayTick = currentTicks + 1;
                 }
 
-                bool isPositionValid = false;
-
-                GameAction* action = command.action.get();
-                action->SetFlags(action->GetFlags() | GAME_COMMAND_FLAG_REPLAY);
-
-                GameActions::Result result = GameActions::Execute(action);
-                if (result.Error == GameActions::Status::Ok)
-                {
-                    isPositionValid = true;
-                }
-
-                // Focus camera on event.
-                if (!gSilentReplays && isPositionValid && !result.Position.IsNull())
-                {
-                    auto* mainWindow = WindowGetMain();
-                    if (mainWindow != nullptr)
-                        WindowScrollToLocation(*mainWindow, result.Position);
-                }
-
-                replayQueue.erase(replayQueue.begin());
+                ExecuteCommand(command);
+                ++_nextCommand;
             }
         }
 
@@ -889,9 +1207,12 @@ namespace OpenRCT2
         ReplayMode _mode = ReplayMode::NONE;
         std::unique_ptr<ReplayRecordData> _currentRecording;
         std::unique_ptr<ReplayRecordData> _currentReplay;
+        std::multiset<ReplayCommand>::const_iterator _nextCommand;
         int32_t _faultyChecksumIndex = -1;
         uint32_t _commandId = 0;
         uint32_t _nextChecksumTick = 0;
+        uint32_t _nextKeyframeTick = 0;
+        uint32_t _keyframeIntervalTicks = kDefaultKeyframeIntervalTicks;
         uint32_t _nextReplayTick = 0;
         RecordType _recordType = RecordType::NORMAL;
     };
@@ -12,6 +12,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 class GameAction;
 
@@ -26,10 +27,23 @@ namespace OpenRCT2
         uint64_t TimeRecorded;
         uint32_t NumCommands;
         uint32_t NumChecksums;
+        uint32_t NumKeyframes;
         std::string Name;
         std::string FilePath;
     };
 
+    struct ReplayBisectResult
+    {
+        // Whether the replays differ at all, if not the other fields are not set.
+        bool Diverged;
+        // The first tick at which the replays differ, counted from their start.
+        uint32_t Tick;
+        // The number of times a replay was played from a saved state during the search.
+        uint32_t NumSegments;
+        // The differences between the entities of both replays at the tick.
+        std::string CompareText;
+    };
+
     struct IReplayManager
     {
     public:
@@ -54,12 +68,27 @@ namespace OpenRCT2
             const std::string& name, uint32_t maxTicks = k_MaxReplayTicks, RecordType rt = RecordType::NORMAL)
             = 0;
         virtual bool StopRecording(bool discard = false) = 0;
+        // Sets the number of ticks between the keyframes of the recordings started from now on.
+        virtual void SetKeyframeInterval(uint32_t ticks) = 0;
         virtual bool GetCurrentReplayInfo(ReplayRecordInfo& info) const = 0;
 
         virtual bool StartPlayback(const std::string& file) = 0;
         virtual bool IsPlaybackStateMismatching() const = 0;
         virtual bool StopPlayback() = 0;
 
+        // Moves the playback to the given tick, counted from the start of the replay, by restoring the nearest
+        // keyframe before it and simulating from there.
+        virtual bool SeekPlayback(uint32_t replayTick) = 0;
+        // Returns the ticks of the keyframes, counted from the start of the replay.
+        virtual std::vector<uint32_t> GetKeyframeTicks() const = 0;
+        // Plays from the keyframe before the given one, or the start of the replay, up to the given keyframe and
+        // returns whether the game state matches the checksum stored with it.
+        virtual bool VerifyKeyframe(size_t index) = 0;
+
+        // Binary searches for the first tick at which two replays differ. Both have to start from the same park at the
+        // same tick, otherwise this fails.
+        virtual bool BisectReplays(const std::string& fileA, const std::string& fileB, ReplayBisectResult& result) = 0;
+
         virtual bool NormaliseReplay(const std::string& inputFile, const std::string& outputFile) = 0;
     };
 
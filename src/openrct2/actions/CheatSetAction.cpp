@@ -147,6 +147,9 @@ GameActions::Result CheatSetAction::Execute() const
         case CheatType::IgnorePrice:
             gameState.Cheats.IgnorePrice = _param1 != 0;
             break;
+        case CheatType::FootpathGraphPathfinding:
+            gameState.Cheats.FootpathGraphPathfinding = _param1 != 0;
+            break;
         case CheatType::DisableVandalism:
             gameState.Cheats.DisableVandalism = _param1 != 0;
             break;
@@ -314,6 +317,8 @@ ParametersRange CheatSetAction::GetParameterRange(CheatType cheatType) const
             [[fallthrough]];
         case CheatType::IgnorePrice:
             [[fallthrough]];
+        case CheatType::FootpathGraphPathfinding:
+            [[fallthrough]];
         case CheatType::DisableVandalism:
             [[fallthrough]];
         case CheatType::DisableLittering:
@@ -708,8 +713,7 @@ void CheatSetAction::RemoveAllGuests() const
 
         for (auto& station : ride.GetStations())
         {
-            station.QueueLength = 0;
-            station.LastPeepInQueue = EntityId::GetNull();
+            station.ResetQueue();
         }
 
         for (auto trainIndex : ride.vehicles)
@@ -17,6 +17,7 @@
 #include "../management/Finance.h"
 #include "../world/Location.hpp"
 #include "../world/Map.h"
+#include "../world/TileElementsView.h"
 #include "FootpathRemoveAction.h"
 #include "LargeSceneryRemoveAction.h"
 #include "SmallSceneryRemoveAction.h"
@@ -81,6 +82,7 @@ GameActions::Result ClearAction::QueryExecute(bool executing) const
     StringId errorMessage = STR_NONE;
     money64 totalCost = 0;
 
+    bool foundLargeScenery = false;
     auto validRange = ClampRangeWithinMap(_range);
     for (int32_t y = validRange.GetTop(); y <= validRange.GetBottom(); y += kCoordsXYStep)
     {
@@ -88,7 +90,7 @@ GameActions::Result ClearAction::QueryExecute(bool executing) const
         {
             if (LocationValid({ x, y }) && MapCanClearAt({ x, y }))
             {
-                auto cost = ClearSceneryFromTile({ x, y }, executing);
+                auto cost = ClearSceneryFromTile({ x, y }, executing, foundLargeScenery);
                 if (cost != kMoney64Undefined)
                 {
                     noValidTiles = false;
@@ -103,7 +105,7 @@ GameActions::Result ClearAction::QueryExecute(bool executing) const
         }
     }
 
-    if (_itemsToClear & CLEARABLE_ITEMS::SCENERY_LARGE)
+    if (foundLargeScenery)
     {
         ResetClearLargeSceneryFlag();
     }
@@ -118,7 +120,7 @@ GameActions::Result ClearAction::QueryExecute(bool executing) const
     return result;
 }
 
-money64 ClearAction::ClearSceneryFromTile(const CoordsXY& tilePos, bool executing) const
+money64 ClearAction::ClearSceneryFromTile(const CoordsXY& tilePos, bool executing, bool& foundLargeScenery) const
 {
     // Pass down all flags.
     TileElement* tileElement = nullptr;
@@ -143,7 +145,7 @@ money64 ClearAction::ClearSceneryFromTile(const CoordsXY& tilePos, bool executin
                         auto footpathRemoveAction = FootpathRemoveAction({ tilePos, tileElement->GetBaseZ() });
                         footpathRemoveAction.SetFlags(GetFlags());
 
-                        auto res = executing ? GameActions::ExecuteNested(&footpathRemoveAction)
+                        auto res = executing ? GameActions::ExecuteNestedBatched(&footpathRemoveAction)
                                              : GameActions::QueryNested(&footpathRemoveAction);
 
                         if (res.Error == GameActions::Status::Ok)
@@ -161,7 +163,7 @@ money64 ClearAction::ClearSceneryFromTile(const CoordsXY& tilePos, bool executin
                             tileElement->AsSmallScenery()->GetEntryIndex());
                         removeSceneryAction.SetFlags(GetFlags());
 
-                        auto res = executing ? GameActions::ExecuteNested(&removeSceneryAction)
+                        auto res = executing ? GameActions::ExecuteNestedBatched(&removeSceneryAction)
                                              : GameActions::QueryNested(&removeSceneryAction);
 
                         if (res.Error == GameActions::Status::Ok)
@@ -178,7 +180,7 @@ money64 ClearAction::ClearSceneryFromTile(const CoordsXY& tilePos, bool executin
                         auto wallRemoveAction = WallRemoveAction(wallLocation);
                         wallRemoveAction.SetFlags(GetFlags());
 
-                        auto res = executing ? GameActions::ExecuteNested(&wallRemoveAction)
+                        auto res = executing ? GameActions::ExecuteNestedBatched(&wallRemoveAction)
                                              : GameActions::QueryNested(&wallRemoveAction);
 
                         if (res.Error == GameActions::Status::Ok)
@@ -195,8 +197,9 @@ money64 ClearAction::ClearSceneryFromTile(const CoordsXY& tilePos, bool executin
                             { tilePos, tileElement->GetBaseZ(), tileElement->GetDirection() },
                             tileElement->AsLargeScenery()->GetSequenceIndex());
                         removeSceneryAction.SetFlags(GetFlags() | GAME_COMMAND_FLAG_TRACK_DESIGN);
+                        foundLargeScenery = true;
 
-                        auto res = executing ? GameActions::ExecuteNested(&removeSceneryAction)
+                        auto res = executing ? GameActions::ExecuteNestedBatched(&removeSceneryAction)
                                              : GameActions::QueryNested(&removeSceneryAction);
 
                         if (res.Error == GameActions::Status::Ok)
@@ -217,22 +220,16 @@ money64 ClearAction::ClearSceneryFromTile(const CoordsXY& tilePos, bool executin
 
 void ClearAction::ResetClearLargeSceneryFlag()
 {
+    // The flag is set on every tile of the removed large scenery, which may extend beyond the cleared range.
     auto& gameState = GetGameState();
-    // TODO: Improve efficiency of this
     for (int32_t y = 0; y < gameState.MapSize.y; y++)
     {
         for (int32_t x = 0; x < gameState.MapSize.x; x++)
         {
-            auto tileElement = MapGetFirstElementAt(TileCoordsXY{ x, y });
-            do
+            for (auto* largeScenery : TileElementsView<LargeSceneryElement>(TileCoordsXY{ x, y }.ToCoordsXY()))
             {
-                if (tileElement == nullptr)
-                    break;
-                if (tileElement->GetType() == TileElementType::LargeScenery)
-                {
-                    tileElement->AsLargeScenery()->SetIsAccounted(false);
-                }
-            } while (!(tileElement++)->IsLastForTile());
+                largeScenery->SetIsAccounted(false);
+            }
         }
     }
 }
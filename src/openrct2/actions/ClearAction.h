@@ -43,7 +43,7 @@ public:
 private:
     OpenRCT2::GameActions::Result CreateResult() const;
     OpenRCT2::GameActions::Result QueryExecute(bool executing) const;
-    money64 ClearSceneryFromTile(const CoordsXY& tilePos, bool executing) const;
+    money64 ClearSceneryFromTile(const CoordsXY& tilePos, bool executing, bool& foundLargeScenery) const;
 
     /**
      * Function to clear the flag that is set to prevent cost duplication
@@ -19,6 +19,7 @@
 #include "../entity/MoneyEffect.h"
 #include "../localisation/Formatter.h"
 #include "../network/network.h"
+#include "../peep/FootpathGraph.h"
 #include "../platform/Platform.h"
 #include "../profiling/Profiling.h"
 #include "../scenario/Scenario.h"
@@ -285,6 +286,65 @@ namespace OpenRCT2::GameActions
         NetworkAppendServerLog(text);
     }
 
+    static bool IsRejectedByReplay(const GameAction* action)
+    {
+        // Some actions are not recorded in the replay.
+        const auto ignoreForReplays = (action->GetActionFlags() & GameActions::Flags::IgnoreForReplays) != 0;
+
+        // We only accept replay commands as long the replay is active.
+        auto* replayManager = OpenRCT2::GetContext()->GetReplayManager();
+        return replayManager != nullptr && (replayManager->IsReplaying() || replayManager->IsNormalising())
+            && (action->GetFlags() & GAME_COMMAND_FLAG_REPLAY) == 0 && !ignoreForReplays;
+    }
+
+    static GameActions::Result CreateRejectedByReplayResult()
+    {
+        // TODO: Introduce proper error.
+        auto result = GameActions::Result();
+        result.Error = GameActions::Status::GamePaused;
+        result.ErrorTitle = STR_RIDE_CONSTRUCTION_CANT_CONSTRUCT_THIS_HERE;
+        result.ErrorMessage = STR_CONSTRUCTION_NOT_POSSIBLE_WHILE_GAME_IS_PAUSED;
+        return result;
+    }
+
+    /**
+     * Rebuilds the footpath graph after actions that can change where guests can walk: the paths themselves, what
+     * blocks their edges and the entrances, exits and shops at their ends. Ghosts are not part of the graph.
+     */
+    static void InvalidateFootpathGraphIfAffected(const GameAction* action)
+    {
+        if (action->GetFlags() & GAME_COMMAND_FLAG_GHOST)
+            return;
+
+        switch (action->GetType())
+        {
+            case GameCommand::PlacePath:
+            case GameCommand::PlacePathLayout:
+            case GameCommand::RemovePath:
+            case GameCommand::PlaceFootpathAddition:
+            case GameCommand::RemoveFootpathAddition:
+            case GameCommand::PlaceBanner:
+            case GameCommand::RemoveBanner:
+            case GameCommand::SetBannerStyle:
+            case GameCommand::PlaceRideEntranceOrExit:
+            case GameCommand::RemoveRideEntranceOrExit:
+            case GameCommand::PlaceParkEntrance:
+            case GameCommand::RemoveParkEntrance:
+            case GameCommand::PlaceTrack:
+            case GameCommand::RemoveTrack:
+            case GameCommand::SetMazeTrack:
+            case GameCommand::PlaceMazeDesign:
+            case GameCommand::PlaceTrackDesign:
+            case GameCommand::DemolishRide:
+            case GameCommand::ModifyTile:
+            case GameCommand::ChangeMapSize:
+                PathFinding::InvalidateFootpathGraph();
+                break;
+            default:
+                break;
+        }
+    }
+
     static GameActions::Result ExecuteInternal(const GameAction* action, bool topLevel)
     {
         Guard::ArgumentNotNull(action);
@@ -296,19 +356,9 @@ namespace OpenRCT2::GameActions
         const auto ignoreForReplays = (actionFlags & GameActions::Flags::IgnoreForReplays) != 0;
 
         auto* replayManager = OpenRCT2::GetContext()->GetReplayManager();
-        if (replayManager != nullptr && (replayManager->IsReplaying() || replayManager->IsNormalising()))
+        if (IsRejectedByReplay(action))
         {
-            // We only accept replay commands as long the replay is active.
-            if ((flags & GAME_COMMAND_FLAG_REPLAY) == 0 && !ignoreForReplays)
-            {
-                // TODO: Introduce proper error.
-                auto result = GameActions::Result();
-                result.Error = GameActions::Status::GamePaused;
-                result.ErrorTitle = STR_RIDE_CONSTRUCTION_CANT_CONSTRUCT_THIS_HERE;
-                result.ErrorMessage = STR_CONSTRUCTION_NOT_POSSIBLE_WHILE_GAME_IS_PAUSED;
-
-                return result;
-            }
+            return CreateRejectedByReplayResult();
         }
 
         GameActions::Result result = QueryInternal(action, topLevel);
@@ -357,6 +407,10 @@ namespace OpenRCT2::GameActions
 
             // Execute the action, changing the game state
             result = action->Execute();
+            if (result.Error == GameActions::Status::Ok)
+            {
+                InvalidateFootpathGraphIfAffected(action);
+            }
 #ifdef ENABLE_SCRIPTING
             if (result.Error == GameActions::Status::Ok)
             {
@@ -467,6 +521,52 @@ namespace OpenRCT2::GameActions
     {
         return ExecuteInternal(action, false);
     }
+
+    static bool _nestedBatching = true;
+
+    static bool HasGameActionHooks()
+    {
+#ifdef ENABLE_SCRIPTING
+        auto& hookEngine = GetContext()->GetScriptEngine().GetHookEngine();
+        return hookEngine.HasSubscriptions(OpenRCT2::Scripting::HOOK_TYPE::ACTION_QUERY)
+            || hookEngine.HasSubscriptions(OpenRCT2::Scripting::HOOK_TYPE::ACTION_EXECUTE);
+#else
+        return false;
+#endif
+    }
+
+    GameActions::Result ExecuteNestedBatched(const GameAction* action)
+    {
+        if (!_nestedBatching || HasGameActionHooks())
+        {
+            return ExecuteInternal(action, false);
+        }
+
+        Guard::ArgumentNotNull(action);
+        if (IsRejectedByReplay(action))
+        {
+            return CreateRejectedByReplayResult();
+        }
+
+        // The same steps as ExecuteInternal takes for a nested action, without writing the action to the log. Logging
+        // serialises the action to text and appends it to the server log, which dominates when clearing or landscaping
+        // a large area one tile at a time.
+        auto result = QueryInternal(action, false);
+        if (result.Error == GameActions::Status::Ok)
+        {
+            result = action->Execute();
+            if (result.Error == GameActions::Status::Ok)
+            {
+                InvalidateFootpathGraphIfAffected(action);
+            }
+        }
+        return result;
+    }
+
+    void SetNestedBatching(bool enabled)
+    {
+        _nestedBatching = enabled;
+    }
 } // namespace OpenRCT2::GameActions
 
 const char* GameAction::GetName() const
@@ -293,4 +293,11 @@ namespace OpenRCT2::GameActions
     OpenRCT2::GameActions::Result QueryNested(const GameAction* action);
     OpenRCT2::GameActions::Result ExecuteNested(const GameAction* action);
 
+    // Executes an action nested in an action that applies many of them, e.g. to every tile of an area. Succeeds, fails
+    // and costs the same as ExecuteNested, but does not log the nested action. Plugins hooking into game actions still
+    // see every nested action.
+    OpenRCT2::GameActions::Result ExecuteNestedBatched(const GameAction* action);
+    // Makes ExecuteNestedBatched behave exactly like ExecuteNested, e.g. to compare the two in a benchmark.
+    void SetNestedBatching(bool enabled);
+
 } // namespace OpenRCT2::GameActions
@@ -144,6 +144,8 @@ GameActions::Result LandBuyRightsAction::MapBuyLandRightsForTile(const CoordsXY&
             {
                 surfaceElement->SetOwnership(OWNERSHIP_OWNED);
                 Park::UpdateFencesAroundTile(loc);
+                uint16_t baseZ = surfaceElement->GetBaseZ();
+                MapInvalidateTile({ loc, baseZ, baseZ + 16 });
             }
             res.Cost = GetGameState().LandPrice;
             return res;
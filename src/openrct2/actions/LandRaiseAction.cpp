@@ -128,7 +128,7 @@ GameActions::Result LandRaiseAction::QueryExecute(bool isExecuting) const
 
             auto landSetHeightAction = LandSetHeightAction({ x, y }, height, newSlope);
             landSetHeightAction.SetFlags(GetFlags());
-            auto result = isExecuting ? GameActions::ExecuteNested(&landSetHeightAction)
+            auto result = isExecuting ? GameActions::ExecuteNestedBatched(&landSetHeightAction)
                                       : GameActions::QueryNested(&landSetHeightAction);
             if (result.Error == GameActions::Status::Ok)
             {
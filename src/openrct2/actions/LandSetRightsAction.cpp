@@ -131,6 +131,8 @@ GameActions::Result LandSetRightsAction::MapBuyLandRightsForTile(const CoordsXY&
                 surfaceElement->SetOwnership(
                     surfaceElement->GetOwnership() & ~(OWNERSHIP_OWNED | OWNERSHIP_CONSTRUCTION_RIGHTS_OWNED));
                 Park::UpdateFencesAroundTile(loc);
+                uint16_t baseZ = surfaceElement->GetBaseZ();
+                MapInvalidateTile({ loc, baseZ, baseZ + 16 });
             }
             return res;
         case LandSetRightSetting::UnownConstructionRights:
@@ -226,6 +228,8 @@ GameActions::Result LandSetRightsAction::MapBuyLandRightsForTile(const CoordsXY&
                 }
                 surfaceElement->SetOwnership(_ownership);
                 Park::UpdateFencesAroundTile(loc);
+                uint16_t baseZ = surfaceElement->GetBaseZ();
+                MapInvalidateTile({ loc, baseZ, baseZ + 16 });
                 gMapLandRightsUpdateSuccess = true;
             }
             return res;
@@ -95,7 +95,8 @@ GameActions::Result LandSmoothAction::SmoothLandTile(
 
     auto landSetHeightAction = LandSetHeightAction(loc, targetBaseZ, slope);
     landSetHeightAction.SetFlags(GetFlags());
-    auto res = isExecuting ? GameActions::ExecuteNested(&landSetHeightAction) : GameActions::QueryNested(&landSetHeightAction);
+    auto res = isExecuting ? GameActions::ExecuteNestedBatched(&landSetHeightAction)
+                           : GameActions::QueryNested(&landSetHeightAction);
 
     return res;
 }
@@ -234,7 +235,7 @@ money64 LandSmoothAction::SmoothLandRowByEdge(
         }
         auto landSetHeightAction = LandSetHeightAction(nextLoc, targetBaseZ, slope);
         landSetHeightAction.SetFlags(GetFlags());
-        auto res = isExecuting ? GameActions::ExecuteNested(&landSetHeightAction)
+        auto res = isExecuting ? GameActions::ExecuteNestedBatched(&landSetHeightAction)
                                : GameActions::QueryNested(&landSetHeightAction);
         if (res.Error == GameActions::Status::Ok)
         {
@@ -623,13 +624,15 @@ GameActions::Result LandSmoothAction::SmoothLand(bool isExecuting) const
     {
         auto raiseLandAction = LandRaiseAction({ _coords.x, _coords.y }, validRange, selectionType);
         raiseLandAction.SetFlags(GetFlags());
-        result = isExecuting ? GameActions::ExecuteNested(&raiseLandAction) : GameActions::QueryNested(&raiseLandAction);
+        result = isExecuting ? GameActions::ExecuteNestedBatched(&raiseLandAction)
+                             : GameActions::QueryNested(&raiseLandAction);
     }
     else
     {
         auto lowerLandAction = LandLowerAction({ _coords.x, _coords.y }, validRange, selectionType);
         lowerLandAction.SetFlags(GetFlags());
-        result = isExecuting ? GameActions::ExecuteNested(&lowerLandAction) : GameActions::QueryNested(&lowerLandAction);
+        result = isExecuting ? GameActions::ExecuteNestedBatched(&lowerLandAction)
+                             : GameActions::QueryNested(&lowerLandAction);
     }
     if (result.Error != GameActions::Status::Ok)
     {
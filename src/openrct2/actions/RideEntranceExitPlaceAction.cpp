@@ -210,8 +210,7 @@ GameActions::Result RideEntranceExitPlaceAction::Execute() const
     else
     {
         station.Entrance = TileCoordsXYZD(CoordsXYZD{ _loc, z, entranceElement->GetDirection() });
-        station.LastPeepInQueue = EntityId::GetNull();
-        station.QueueLength = 0;
+        station.ResetQueue();
 
         MapAnimationCreate(MAP_ANIMATION_TYPE_RIDE_ENTRANCE, { _loc, z });
     }
@@ -98,7 +98,7 @@ GameActions::Result WaterLowerAction::QueryExecute(bool isExecuting) const
             height -= 2;
             auto waterSetHeightAction = WaterSetHeightAction({ x, y }, height);
             waterSetHeightAction.SetFlags(GetFlags());
-            auto result = isExecuting ? GameActions::ExecuteNested(&waterSetHeightAction)
+            auto result = isExecuting ? GameActions::ExecuteNestedBatched(&waterSetHeightAction)
                                       : GameActions::QueryNested(&waterSetHeightAction);
             if (result.Error == GameActions::Status::Ok)
             {
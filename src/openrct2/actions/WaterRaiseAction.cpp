@@ -112,7 +112,7 @@ GameActions::Result WaterRaiseAction::QueryExecute(bool isExecuting) const
             }
             auto waterSetHeightAction = WaterSetHeightAction({ x, y }, height);
             waterSetHeightAction.SetFlags(GetFlags());
-            auto result = isExecuting ? GameActions::ExecuteNested(&waterSetHeightAction)
+            auto result = isExecuting ? GameActions::ExecuteNestedBatched(&waterSetHeightAction)
                                       : GameActions::QueryNested(&waterSetHeightAction);
             if (result.Error == GameActions::Status::Ok)
             {
@@ -0,0 +1,133 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "../Context.h"
+#include "../Game.h"
+#include "../OpenRCT2.h"
+#include "../actions/ClearAction.h"
+#include "../actions/GameAction.h"
+#include "../actions/LandRaiseAction.h"
+#include "../actions/WaterRaiseAction.h"
+#include "../core/Console.hpp"
+#include "../core/Timer.hpp"
+#include "../world/Map.h"
+#include "CommandLine.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+
+using namespace OpenRCT2;
+
+// clang-format off
+static constexpr CommandLineOptionDefinition NoOptions[]
+{
+    kOptionTableEnd
+};
+
+static exitcode_t HandleBenchArea(CommandLineArgEnumerator* argEnumerator);
+
+const CommandLineCommand CommandLine::BenchAreaCommands[]
+{
+    // Main commands
+    DefineCommand("", "<park-file> [iterations]", NoOptions, HandleBenchArea),
+    kCommandTableEnd
+};
+// clang-format on
+
+struct AreaBenchmark
+{
+    const char* Name;
+    std::unique_ptr<GameAction> (*CreateAction)(const MapRange& range);
+};
+
+static constexpr AreaBenchmark kAreaBenchmarks[] = {
+    { "clear",
+      [](const MapRange& range) -> std::unique_ptr<GameAction> {
+          return std::make_unique<ClearAction>(
+              range,
+              CLEARABLE_ITEMS::SCENERY_SMALL | CLEARABLE_ITEMS::SCENERY_LARGE | CLEARABLE_ITEMS::SCENERY_FOOTPATH);
+      } },
+    { "land raise",
+      [](const MapRange& range) -> std::unique_ptr<GameAction> {
+          return std::make_unique<LandRaiseAction>(range.Point1, range, MAP_SELECT_TYPE_FULL);
+      } },
+    { "water raise",
+      [](const MapRange& range) -> std::unique_ptr<GameAction> {
+          return std::make_unique<WaterRaiseAction>(range);
+      } },
+};
+
+/**
+ * Applies each area action to the whole map, once with the nested actions batched and once executing every nested
+ * action on its own. The park is loaded again before each run so that every run starts from the same map.
+ */
+static exitcode_t HandleBenchArea(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+
+    if (argc < 1)
+    {
+        Console::Error::WriteLine("Missing argument <park-file>.");
+        return EXITCODE_FAIL;
+    }
+
+    const char* inputPath = argv[0];
+    const int32_t iterations = argc >= 2 ? std::max(1, atoi(argv[1])) : 5;
+
+    gOpenRCT2Headless = true;
+
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        Console::Error::WriteLine("Context initialization failed.");
+        return EXITCODE_FAIL;
+    }
+
+    for (const auto& benchmark : kAreaBenchmarks)
+    {
+        for (bool batched : { false, true })
+        {
+            GameActions::SetNestedBatching(batched);
+
+            double totalSeconds = 0;
+            for (int32_t i = 0; i < iterations; i++)
+            {
+                if (!context->LoadParkFromFile(inputPath))
+                {
+                    Console::Error::WriteLine("Failed to load park '%s'.", inputPath);
+                    return EXITCODE_FAIL;
+                }
+
+                const auto mapSize = GetMapSizeMaxXY();
+                auto action = benchmark.CreateAction({ 0, 0, mapSize.x, mapSize.y });
+                action->SetFlags(GAME_COMMAND_FLAG_ALLOW_DURING_PAUSED | GAME_COMMAND_FLAG_NO_SPEND);
+
+                // Outside of the update code, Execute only queries the action and queues it for the next tick.
+                gInUpdateCode = true;
+                Timer timer;
+                const auto result = GameActions::Execute(action.get());
+                totalSeconds += timer.GetElapsedTime().count();
+                gInUpdateCode = false;
+
+                if (result.Error != GameActions::Status::Ok)
+                {
+                    Console::Error::WriteLine("%s failed with status %u.", benchmark.Name, EnumValue(result.Error));
+                }
+            }
+
+            Console::WriteLine(
+                "%-12s %-8s %8.3f ms", benchmark.Name, batched ? "batched" : "nested", totalSeconds * 1000 / iterations);
+        }
+    }
+
+    GameActions::SetNestedBatching(true);
+    return EXITCODE_OK;
+}
@@ -0,0 +1,148 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "../Context.h"
+#include "../Game.h"
+#include "../OpenRCT2.h"
+#include "../actions/GameAction.h"
+#include "../actions/TrackDesignAction.h"
+#include "../core/Console.hpp"
+#include "../core/Timer.hpp"
+#include "../ride/Ride.h"
+#include "../ride/TrackDesign.h"
+#include "../util/Math.hpp"
+#include "../world/ConstructionClearance.h"
+#include "../world/Map.h"
+#include "CommandLine.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <optional>
+
+using namespace OpenRCT2;
+
+// clang-format off
+static constexpr CommandLineOptionDefinition NoOptions[]
+{
+    kOptionTableEnd
+};
+
+static exitcode_t HandleBenchPlace(CommandLineArgEnumerator* argEnumerator);
+
+const CommandLineCommand CommandLine::BenchPlaceCommands[]
+{
+    // Main commands
+    DefineCommand("", "<park-file> <track-design-file> <x> <y> [iterations]", NoOptions, HandleBenchPlace),
+    kCommandTableEnd
+};
+// clang-format on
+
+/**
+ * Queries the track design at the position and the heights above it that the track design placement window tries.
+ * Returns the height at which it can be placed, if any.
+ */
+static std::optional<int32_t> FindTrackDesignPlaceZ(const TrackDesign& td, CoordsXYZD loc)
+{
+    // Like the track design window, share the clearance summaries between the heights tried.
+    ClearanceQueryScope clearanceScope;
+    for (int32_t i = 0; i < 7; i++, loc.z += kCoordsZStep)
+    {
+        auto tdAction = TrackDesignAction(loc, td);
+        tdAction.SetFlags(GAME_COMMAND_FLAG_ALLOW_DURING_PAUSED | GAME_COMMAND_FLAG_NO_SPEND);
+        auto res = GameActions::Query(&tdAction);
+        if (res.Error == GameActions::Status::Ok)
+            return loc.z;
+    }
+    return std::nullopt;
+}
+
+/**
+ * Times placing a track design in the park, once walking the elements of every tile for each clearance check and once
+ * with the clearance summaries.
+ */
+static exitcode_t HandleBenchPlace(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+
+    if (argc < 4)
+    {
+        Console::Error::WriteLine("Missing arguments <park-file> <track-design-file> <x> <y>.");
+        return EXITCODE_FAIL;
+    }
+
+    const char* parkPath = argv[0];
+    const char* trackDesignPath = argv[1];
+    const auto tilePos = TileCoordsXY{ atoi(argv[2]), atoi(argv[3]) };
+    const int32_t iterations = argc >= 5 ? std::max(1, atoi(argv[4])) : 20;
+
+    gOpenRCT2Headless = true;
+
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        Console::Error::WriteLine("Context initialization failed.");
+        return EXITCODE_FAIL;
+    }
+
+    if (!context->LoadParkFromFile(parkPath))
+    {
+        Console::Error::WriteLine("Failed to load park '%s'.", parkPath);
+        return EXITCODE_FAIL;
+    }
+
+    auto td = TrackDesignImport(trackDesignPath);
+    if (td == nullptr)
+    {
+        Console::Error::WriteLine("Failed to load track design '%s'.", trackDesignPath);
+        return EXITCODE_FAIL;
+    }
+
+    const auto mapCoords = tilePos.ToCoordsXY();
+    const auto* surfaceElement = MapGetSurfaceElementAt(mapCoords);
+    if (!MapIsLocationValid(mapCoords) || surfaceElement == nullptr)
+    {
+        Console::Error::WriteLine("%d, %d is not a tile of the park.", tilePos.x, tilePos.y);
+        return EXITCODE_FAIL;
+    }
+
+    // Start at the same height as the track design placement window does.
+    auto z = std::max(Floor2(surfaceElement->GetBaseZ(), kCoordsZStep), surfaceElement->GetWaterHeight());
+    z += TrackDesignGetZPlacement(*td, RideGetTemporaryForPreview(), { mapCoords, z, 0 });
+
+    for (bool summaries : { false, true })
+    {
+        MapSetClearanceSummariesEnabled(summaries);
+
+        double totalSeconds = 0;
+        std::optional<int32_t> placeZ;
+        for (int32_t i = 0; i < iterations; i++)
+        {
+            Timer timer;
+            placeZ = FindTrackDesignPlaceZ(*td, { mapCoords, z, 0 });
+            totalSeconds += timer.GetElapsedTime().count();
+        }
+
+        if (placeZ.has_value())
+        {
+            Console::WriteLine(
+                "%-10s %8.3f ms (placed at z %d)", summaries ? "summaries" : "walk", totalSeconds * 1000 / iterations,
+                *placeZ);
+        }
+        else
+        {
+            Console::WriteLine(
+                "%-10s %8.3f ms (no valid height)", summaries ? "summaries" : "walk", totalSeconds * 1000 / iterations);
+        }
+    }
+
+    MapSetClearanceSummariesEnabled(true);
+    return EXITCODE_OK;
+}
@@ -112,6 +112,11 @@ namespace OpenRCT2::CommandLine
     extern const CommandLineCommand SpriteCommands[];
     extern const CommandLineCommand SimulateCommands[];
     extern const CommandLineCommand ParkInfoCommands[];
+    extern const CommandLineCommand MapGenCommands[];
+    extern const CommandLineCommand ReplayCommands[];
+    extern const CommandLineCommand DesyncBisectCommands[];
+    extern const CommandLineCommand BenchAreaCommands[];
+    extern const CommandLineCommand BenchPlaceCommands[];
 
     extern const CommandLineExample RootExamples[];
 
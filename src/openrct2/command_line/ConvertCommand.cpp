@@ -119,7 +119,9 @@ exitcode_t CommandLine::HandleCommandConvert(CommandLineArgEnumerator* enumerato
 
     try
     {
+        // Embed the custom objects, so that saves referencing them in the object store can be shared.
         auto exporter = std::make_unique<ParkFileExporter>();
+        exporter->ExportObjectsList = objManager.GetPackableObjects();
 
         // HACK remove the main window so it saves the park with the
         //      correct initial view
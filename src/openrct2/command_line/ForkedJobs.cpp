@@ -0,0 +1,145 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "ForkedJobs.h"
+
+#include "../core/Console.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+#ifndef _WIN32
+    #include <sys/wait.h>
+    #include <unistd.h>
+#endif
+
+namespace OpenRCT2::CommandLine
+{
+#ifndef _WIN32
+    struct ForkedProcess
+    {
+        pid_t Pid{};
+        int Fd{};
+        size_t Index{};
+    };
+
+    static std::string ReadAll(int fd)
+    {
+        std::string result;
+        char buffer[256];
+        ssize_t length;
+        while ((length = read(fd, buffer, sizeof(buffer))) > 0)
+        {
+            result.append(buffer, static_cast<size_t>(length));
+        }
+        return result;
+    }
+
+    static void WriteAll(int fd, const std::string& data)
+    {
+        size_t offset = 0;
+        while (offset < data.size())
+        {
+            const auto written = write(fd, data.data() + offset, data.size() - offset);
+            if (written <= 0)
+                break;
+            offset += static_cast<size_t>(written);
+        }
+    }
+#endif
+
+    bool CanRunForkedJobs()
+    {
+#ifndef _WIN32
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    size_t GetDefaultNumForkedJobs()
+    {
+        return std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+
+    std::vector<std::optional<std::string>> RunForkedJobs(size_t count, size_t numJobs, const ForkedJob& job)
+    {
+        std::vector<std::optional<std::string>> results(count);
+#ifndef _WIN32
+        std::vector<ForkedProcess> processes;
+        size_t nextIndex = 0;
+        numJobs = std::max<size_t>(1, numJobs);
+
+        // Flush before forking, so buffered output is not written again by every child.
+        fflush(stdout);
+        fflush(stderr);
+
+        while (nextIndex < count || !processes.empty())
+        {
+            while (nextIndex < count && processes.size() < numJobs)
+            {
+                const auto index = nextIndex++;
+                int fds[2];
+                if (pipe(fds) != 0)
+                {
+                    Console::Error::WriteLine("Unable to create pipe for job %zu.", index);
+                    continue;
+                }
+
+                const auto pid = fork();
+                if (pid == 0)
+                {
+                    close(fds[0]);
+                    auto result = job(index);
+                    if (result.has_value())
+                    {
+                        WriteAll(fds[1], *result);
+                    }
+                    close(fds[1]);
+                    fflush(stdout);
+                    fflush(stderr);
+                    // Skip the destructors, the parent owns everything that was set up before forking.
+                    _exit(result.has_value() ? EXIT_SUCCESS : EXIT_FAILURE);
+                }
+
+                close(fds[1]);
+                if (pid < 0)
+                {
+                    Console::Error::WriteLine("Unable to start process for job %zu.", index);
+                    close(fds[0]);
+                    continue;
+                }
+                processes.push_back({ pid, fds[0], index });
+            }
+
+            if (processes.empty())
+                continue;
+
+            // Wait for the oldest job, reading its result before waiting for the process to exit so that results
+            // larger than the pipe buffer do not block the child.
+            auto& process = processes.front();
+            auto output = ReadAll(process.Fd);
+            close(process.Fd);
+
+            int status = 0;
+            waitpid(process.Pid, &status, 0);
+            if (WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS)
+            {
+                results[process.Index] = std::move(output);
+            }
+            processes.erase(processes.begin());
+        }
+#else
+        Console::Error::WriteLine("Forked jobs are not supported on this platform.");
+#endif
+        return results;
+    }
+} // namespace OpenRCT2::CommandLine
@@ -0,0 +1,35 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace OpenRCT2::CommandLine
+{
+    using ForkedJob = std::function<std::optional<std::string>(size_t index)>;
+
+    // Whether jobs can be run in forked processes on this platform.
+    bool CanRunForkedJobs();
+
+    /**
+     * Runs the job for each index in a process forked from this one, at most numJobs at a time. The game state is
+     * global, so this lets jobs that each load a park run concurrently while sharing everything loaded before,
+     * such as the object repository and g1.
+     * @return The string each job returned, or std::nullopt for jobs that failed or could not be started.
+     */
+    std::vector<std::optional<std::string>> RunForkedJobs(size_t count, size_t numJobs, const ForkedJob& job);
+
+    // The number of jobs to run at once when not specified, the number of cores.
+    size_t GetDefaultNumForkedJobs();
+} // namespace OpenRCT2::CommandLine
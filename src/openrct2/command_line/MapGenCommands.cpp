@@ -0,0 +1,123 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "../Context.h"
+#include "../OpenRCT2.h"
+#include "../core/Console.hpp"
+#include "../core/Timer.hpp"
+#include "../world/Map.h"
+#include "../world/MapGen.h"
+#include "CommandLine.hpp"
+
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+using namespace OpenRCT2;
+
+static int32_t _mapGenSeed = 1;
+static int32_t _mapGenOctaves = 6;
+static int32_t _mapGenIterations = 1;
+static bool _mapGenNoTrees = false;
+static bool _mapGenNoBeaches = false;
+
+// clang-format off
+static constexpr CommandLineOptionDefinition MapGenOptionsDef[]
+{
+    { CMDLINE_TYPE_INTEGER, &_mapGenSeed,       NAC, "seed",       "seed for the generator (default 1)" },
+    { CMDLINE_TYPE_INTEGER, &_mapGenOctaves,    NAC, "octaves",    "number of simplex noise octaves (default 6)" },
+    { CMDLINE_TYPE_INTEGER, &_mapGenIterations, NAC, "iterations", "number of times to generate the map (default 1)" },
+    { CMDLINE_TYPE_SWITCH,  &_mapGenNoTrees,    NAC, "no-trees",   "do not place trees" },
+    { CMDLINE_TYPE_SWITCH,  &_mapGenNoBeaches,  NAC, "no-beaches", "do not add beaches" },
+    kOptionTableEnd
+};
+
+static exitcode_t HandleMapGen(CommandLineArgEnumerator* argEnumerator);
+
+const CommandLineCommand CommandLine::MapGenCommands[]
+{
+    // Main commands
+    DefineCommand("", "<park-file> <size>", MapGenOptionsDef, HandleMapGen),
+    kCommandTableEnd
+};
+// clang-format on
+
+/**
+ * FNV-1a hash of the tile elements, used to check that a seed always generates the same map.
+ */
+static uint32_t GetTileElementsChecksum()
+{
+    uint32_t hash = 2166136261u;
+    for (const auto& tileElement : GetTileElements())
+    {
+        const auto* data = reinterpret_cast<const uint8_t*>(&tileElement);
+        for (size_t i = 0; i < sizeof(TileElement); i++)
+        {
+            hash = (hash ^ data[i]) * 16777619u;
+        }
+    }
+    return hash;
+}
+
+static exitcode_t HandleMapGen(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+
+    if (argc < 2)
+    {
+        Console::Error::WriteLine("Missing arguments <park-file> <size>.");
+        return EXITCODE_FAIL;
+    }
+
+    const char* inputPath = argv[0];
+    int32_t size = std::clamp<int32_t>(atol(argv[1]), kMinimumMapSizePractical, kMaximumMapSizePractical);
+
+    gOpenRCT2Headless = true;
+
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        Console::Error::WriteLine("Context initialization failed.");
+        return EXITCODE_FAIL;
+    }
+
+    // The park only provides the loaded terrain and tree objects, its map is replaced.
+    if (!context->LoadParkFromFile(inputPath))
+    {
+        return EXITCODE_FAIL;
+    }
+
+    MapGenSettings settings;
+    settings.algorithm = MapGenAlgorithm::simplexNoise;
+    settings.mapSize = { size + 2, size + 2 };
+    settings.seed = static_cast<uint32_t>(_mapGenSeed);
+    settings.simplex_octaves = _mapGenOctaves;
+    settings.trees = !_mapGenNoTrees;
+    settings.beaches = !_mapGenNoBeaches;
+
+    for (int32_t i = 0; i < std::max(1, _mapGenIterations); i++)
+    {
+        std::vector<MapGenPhaseTiming> timings;
+        Timer timer;
+        MapGenGenerate(&settings, &timings);
+        const auto totalMilliseconds = timer.GetElapsedTime().count() * 1000.0f;
+
+        Console::WriteLine("Iteration %d, %dx%d, seed %u:", i + 1, size, size, settings.seed);
+        for (const auto& timing : timings)
+        {
+            Console::WriteLine(
+                "  %-20.*s %10.3f ms", static_cast<int>(timing.name.size()), timing.name.data(), timing.milliseconds);
+        }
+        Console::WriteLine("  %-20s %10.3f ms", "total", totalMilliseconds);
+        Console::WriteLine("  checksum %08X", GetTileElementsChecksum());
+    }
+
+    return EXITCODE_OK;
+}
@@ -0,0 +1,170 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "../Context.h"
+#include "../OpenRCT2.h"
+#include "../ReplayManager.h"
+#include "../core/Console.hpp"
+#include "CommandLine.hpp"
+#include "ForkedJobs.h"
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace OpenRCT2;
+
+static int32_t _replayJobs = 0;
+
+// clang-format off
+static constexpr CommandLineOptionDefinition ReplayVerifyOptionsDef[]
+{
+    { CMDLINE_TYPE_INTEGER, &_replayJobs, 'j', "jobs", "number of keyframes to verify at once (default number of cores)" },
+    kOptionTableEnd
+};
+
+static constexpr CommandLineOptionDefinition NoOptions[]
+{
+    kOptionTableEnd
+};
+
+static exitcode_t HandleReplayVerify(CommandLineArgEnumerator* argEnumerator);
+static exitcode_t HandleDesyncBisect(CommandLineArgEnumerator* argEnumerator);
+
+const CommandLineCommand CommandLine::ReplayCommands[]
+{
+    // Main commands
+    DefineCommand("verify", "<replay-file>", ReplayVerifyOptionsDef, HandleReplayVerify),
+    kCommandTableEnd
+};
+
+const CommandLineCommand CommandLine::DesyncBisectCommands[]
+{
+    // Main commands
+    DefineCommand("", "<replay-file> <replay-file>", NoOptions, HandleDesyncBisect),
+    kCommandTableEnd
+};
+// clang-format on
+
+/**
+ * Plays every stretch of the replay between two keyframes and checks that it ends in the state stored with the
+ * second one. The stretches are independent, so they are verified concurrently.
+ */
+static exitcode_t HandleReplayVerify(CommandLineArgEnumerator* argEnumerator)
+{
+    const char* inputPath;
+    if (!argEnumerator->TryPopString(&inputPath))
+    {
+        Console::Error::WriteLine("Expected a replay file.");
+        return EXITCODE_FAIL;
+    }
+
+    gOpenRCT2Headless = true;
+    gSilentReplays = true;
+
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        Console::Error::WriteLine("Context initialization failed.");
+        return EXITCODE_FAIL;
+    }
+
+    auto* replayManager = context->GetReplayManager();
+    if (!replayManager->StartPlayback(inputPath))
+    {
+        Console::Error::WriteLine("Unable to start playback of %s.", inputPath);
+        return EXITCODE_FAIL;
+    }
+
+    const auto keyframeTicks = replayManager->GetKeyframeTicks();
+    if (keyframeTicks.empty())
+    {
+        Console::WriteLine("The replay has no keyframes.");
+        return EXITCODE_OK;
+    }
+
+    std::vector<bool> verified(keyframeTicks.size());
+    if (CommandLine::CanRunForkedJobs())
+    {
+        const auto numJobs = _replayJobs > 0 ? static_cast<size_t>(_replayJobs) : CommandLine::GetDefaultNumForkedJobs();
+        auto results = CommandLine::RunForkedJobs(
+            keyframeTicks.size(), numJobs, [replayManager](size_t index) -> std::optional<std::string> {
+                if (!replayManager->VerifyKeyframe(index))
+                    return std::nullopt;
+                return std::string();
+            });
+        for (size_t i = 0; i < results.size(); i++)
+        {
+            verified[i] = results[i].has_value();
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < keyframeTicks.size(); i++)
+        {
+            verified[i] = replayManager->VerifyKeyframe(i);
+        }
+    }
+
+    size_t numFailed = 0;
+    for (size_t i = 0; i < keyframeTicks.size(); i++)
+    {
+        Console::WriteLine("Keyframe %zu at tick %u: %s", i, keyframeTicks[i], verified[i] ? "OK" : "MISMATCH");
+        if (!verified[i])
+            numFailed++;
+    }
+    Console::WriteLine("%zu of %zu keyframes verified.", keyframeTicks.size() - numFailed, keyframeTicks.size());
+
+    replayManager->StopPlayback();
+    return numFailed == 0 ? EXITCODE_OK : EXITCODE_FAIL;
+}
+
+/**
+ * Finds the first tick at which two replays that start from the same park at the same tick differ, e.g. two recordings
+ * made from one save with different commands, and prints the entities that differ at that tick. Both replays are
+ * simulated by this build. Network games do not record their commands, so this does not compare a server and a client.
+ * Exits with a failure when the replays differ.
+ */
+static exitcode_t HandleDesyncBisect(CommandLineArgEnumerator* argEnumerator)
+{
+    const char* inputPathA;
+    const char* inputPathB;
+    if (!argEnumerator->TryPopString(&inputPathA) || !argEnumerator->TryPopString(&inputPathB))
+    {
+        Console::Error::WriteLine("Expected two replay files.");
+        return EXITCODE_FAIL;
+    }
+
+    gOpenRCT2Headless = true;
+
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        Console::Error::WriteLine("Context initialization failed.");
+        return EXITCODE_FAIL;
+    }
+
+    ReplayBisectResult result;
+    if (!context->GetReplayManager()->BisectReplays(inputPathA, inputPathB, result))
+    {
+        Console::Error::WriteLine("Unable to compare %s and %s.", inputPathA, inputPathB);
+        return EXITCODE_FAIL;
+    }
+
+    if (!result.Diverged)
+    {
+        Console::WriteLine("The replays do not differ (%u segments simulated).", result.NumSegments);
+        return EXITCODE_OK;
+    }
+
+    Console::WriteLine("First difference at tick %u (%u segments simulated):", result.Tick, result.NumSegments);
+    Console::WriteLine("%s", result.CompareText.c_str());
+    return EXITCODE_FAIL;
+}
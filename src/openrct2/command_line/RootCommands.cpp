@@ -146,6 +146,11 @@ const CommandLineCommand CommandLine::RootCommands[]
     DefineSubCommand("sprite",          CommandLine::SpriteCommands           ),
     DefineSubCommand("simulate",        CommandLine::SimulateCommands         ),
     DefineSubCommand("parkinfo",        CommandLine::ParkInfoCommands         ),
+    DefineSubCommand("mapgen",          CommandLine::MapGenCommands           ),
+    DefineSubCommand("replay",          CommandLine::ReplayCommands           ),
+    DefineSubCommand("desync-bisect",   CommandLine::DesyncBisectCommands     ),
+    DefineSubCommand("bencharea",       CommandLine::BenchAreaCommands        ),
+    DefineSubCommand("benchplace",      CommandLine::BenchPlaceCommands       ),
     kCommandTableEnd
 };
 
@@ -11,24 +11,159 @@
 #include "../Game.h"
 #include "../GameState.h"
 #include "../OpenRCT2.h"
+#include "../ParkImporter.h"
 #include "../config/ConfigTypes.h"
 #include "../core/Console.hpp"
+#include "../core/Timer.hpp"
 #include "../entity/EntityRegistry.h"
 #include "../network/network.h"
+#include "../object/ObjectList.h"
+#include "../object/ObjectManager.h"
 #include "../platform/Platform.h"
 #include "CommandLine.hpp"
+#include "ForkedJobs.h"
 
+#include <algorithm>
 #include <cstdlib>
+#include <exception>
 #include <memory>
+#include <optional>
+#include <string>
+#include <vector>
 
 using namespace OpenRCT2;
 
+static bool _simulateParallel = false;
+static int32_t _simulateJobs = 0;
+
+// clang-format off
+static constexpr CommandLineOptionDefinition SimulateOptionsDef[]
+{
+    { CMDLINE_TYPE_SWITCH,  &_simulateParallel, NAC, "parallel", "simulate the parks concurrently, one process per park" },
+    { CMDLINE_TYPE_INTEGER, &_simulateJobs,     'j', "jobs",     "number of parks to simulate at once (default number of cores)" },
+    kOptionTableEnd
+};
+
 static exitcode_t HandleSimulate(CommandLineArgEnumerator* argEnumerator);
 
-const CommandLineCommand CommandLine::SimulateCommands[]{ // Main commands
-                                                          DefineCommand("", "<ticks>", nullptr, HandleSimulate),
-                                                          kCommandTableEnd
+const CommandLineCommand CommandLine::SimulateCommands[]
+{
+    // Main commands
+    DefineCommand("", "<park-file>... <ticks>", SimulateOptionsDef, HandleSimulate),
+    kCommandTableEnd
 };
+// clang-format on
+
+struct SimulationResult
+{
+    bool Success{};
+    std::string Checksum;
+    float Seconds{};
+};
+
+static SimulationResult SimulatePark(IContext& context, const char* path, uint32_t ticks)
+{
+    SimulationResult result;
+    Timer timer;
+    if (context.LoadParkFromFile(path))
+    {
+        for (uint32_t i = 0; i < ticks; i++)
+        {
+            gameStateUpdateLogic();
+        }
+        result.Success = true;
+        result.Checksum = GetAllEntitiesChecksum().ToString();
+    }
+    result.Seconds = timer.GetElapsedTime().count();
+    return result;
+}
+
+static void WriteResult(const char* path, const SimulationResult& result)
+{
+    if (result.Success)
+    {
+        Console::WriteLine("%s: %s (%.3f s)", path, result.Checksum.c_str(), result.Seconds);
+    }
+    else
+    {
+        Console::Error::WriteLine("%s: failed to load park.", path);
+    }
+}
+
+/**
+ * Loads the objects of all parks, so that the processes forked to simulate them find their objects already loaded.
+ * Parks that can not be read are skipped here and reported when they are simulated. Objects past the limit of their
+ * type are left for the parks to load themselves.
+ */
+static void PreloadParkObjects(IContext& context, const std::vector<const char*>& paths)
+{
+    ObjectList objects;
+    for (const auto* path : paths)
+    {
+        try
+        {
+            auto parkImporter = ParkImporter::Create(path);
+            const auto result = parkImporter->Load(path);
+            for (auto type : getAllObjectTypes())
+            {
+                auto& list = objects.GetList(type);
+                for (const auto& entry : result.RequiredObjects.GetList(type))
+                {
+                    if (entry.HasValue() && list.size() < getObjectTypeLimit(type)
+                        && std::find(list.begin(), list.end(), entry) == list.end())
+                    {
+                        list.push_back(entry);
+                    }
+                }
+            }
+        }
+        catch (const std::exception&)
+        {
+            // Reported by the process that simulates the park.
+        }
+    }
+
+    try
+    {
+        context.GetObjectManager().LoadObjects(objects);
+    }
+    catch (const std::exception& e)
+    {
+        Console::Error::WriteLine("Unable to preload the objects of the parks: %s", e.what());
+    }
+}
+
+/**
+ * Simulates each park in a process forked from this one once the context is initialised and the objects of all parks
+ * are loaded, so that every park shares the object repository, g1 and loaded objects, and the parks do not share the
+ * global game state.
+ */
+static std::vector<SimulationResult> SimulateParksForked(
+    IContext& context, const std::vector<const char*>& paths, uint32_t ticks, size_t numJobs)
+{
+    PreloadParkObjects(context, paths);
+
+    auto outputs = CommandLine::RunForkedJobs(paths.size(), numJobs, [&](size_t index) -> std::optional<std::string> {
+        auto result = SimulatePark(context, paths[index], ticks);
+        if (!result.Success)
+            return std::nullopt;
+        return result.Checksum + " " + std::to_string(result.Seconds);
+    });
+
+    std::vector<SimulationResult> results(paths.size());
+    for (size_t i = 0; i < outputs.size(); i++)
+    {
+        if (!outputs[i].has_value())
+            continue;
+
+        const auto& output = *outputs[i];
+        const auto separator = output.find(' ');
+        results[i].Success = true;
+        results[i].Checksum = output.substr(0, separator);
+        results[i].Seconds = std::strtof(output.c_str() + separator + 1, nullptr);
+    }
+    return results;
+}
 
 static exitcode_t HandleSimulate(CommandLineArgEnumerator* argEnumerator)
 {
@@ -37,12 +172,12 @@ static exitcode_t HandleSimulate(CommandLineArgEnumerator* argEnumerator)
 
     if (argc < 2)
     {
-        Console::Error::WriteLine("Missing arguments <sv6-file> <ticks>.");
+        Console::Error::WriteLine("Missing arguments <park-file>... <ticks>.");
         return EXITCODE_FAIL;
     }
 
-    const char* inputPath = argv[0];
-    uint32_t ticks = atol(argv[1]);
+    const std::vector<const char*> inputPaths(argv, argv + argc - 1);
+    uint32_t ticks = atol(argv[argc - 1]);
 
     gOpenRCT2Headless = true;
 
@@ -51,25 +186,50 @@ static exitcode_t HandleSimulate(CommandLineArgEnumerator* argEnumerator)
 #endif
 
     std::unique_ptr<IContext> context(CreateContext());
-    if (context->Initialise())
+    if (!context->Initialise())
+    {
+        Console::Error::WriteLine("Context initialization failed.");
+        return EXITCODE_FAIL;
+    }
+
+    Console::WriteLine("Running %d ticks...", ticks);
+
+    std::vector<SimulationResult> results;
+    if (_simulateParallel && inputPaths.size() > 1)
     {
-        if (!context->LoadParkFromFile(inputPath))
+        if (CommandLine::CanRunForkedJobs())
         {
-            return EXITCODE_FAIL;
+            const auto numJobs = _simulateJobs > 0 ? static_cast<size_t>(_simulateJobs)
+                                                   : CommandLine::GetDefaultNumForkedJobs();
+            results = SimulateParksForked(*context, inputPaths, ticks, numJobs);
         }
-
-        Console::WriteLine("Running %d ticks...", ticks);
-        for (uint32_t i = 0; i < ticks; i++)
+        else
         {
-            gameStateUpdateLogic();
+            Console::Error::WriteLine("--parallel is not supported on this platform, simulating the parks one by one.");
         }
-        Console::WriteLine("Completed: %s", GetAllEntitiesChecksum().ToString().c_str());
     }
-    else
+    if (results.empty())
     {
-        Console::Error::WriteLine("Context initialization failed.");
-        return EXITCODE_FAIL;
+        for (const auto* path : inputPaths)
+        {
+            results.push_back(SimulatePark(*context, path, ticks));
+        }
+    }
+
+    bool allSucceeded = true;
+    for (size_t i = 0; i < inputPaths.size(); i++)
+    {
+        allSucceeded &= results[i].Success;
+        if (inputPaths.size() == 1)
+        {
+            if (results[i].Success)
+                Console::WriteLine("Completed: %s", results[i].Checksum.c_str());
+        }
+        else
+        {
+            WriteResult(inputPaths[i], results[i]);
+        }
     }
 
-    return EXITCODE_OK;
+    return allSucceeded ? EXITCODE_OK : EXITCODE_FAIL;
 }
@@ -180,6 +180,8 @@ namespace OpenRCT2::Config
                 "measurement_format", Platform::GetLocaleMeasurementFormat(), Enum_MeasurementFormat);
             model->PlayIntro = reader->GetBoolean("play_intro", false);
             model->SavePluginData = reader->GetBoolean("save_plugin_data", true);
+            model->UseObjectStore = reader->GetBoolean("use_object_store", false);
+            model->UseObjectBundles = reader->GetBoolean("use_object_bundles", false);
             model->DebuggingTools = reader->GetBoolean("debugging_tools", false);
             model->ShowHeightAsUnits = reader->GetBoolean("show_height_as_units", false);
             model->TemperatureFormat = reader->GetEnum<TemperatureUnit>(
@@ -279,6 +281,8 @@ namespace OpenRCT2::Config
         writer->WriteEnum<MeasurementFormat>("measurement_format", model->MeasurementFormat, Enum_MeasurementFormat);
         writer->WriteBoolean("play_intro", model->PlayIntro);
         writer->WriteBoolean("save_plugin_data", model->SavePluginData);
+        writer->WriteBoolean("use_object_store", model->UseObjectStore);
+        writer->WriteBoolean("use_object_bundles", model->UseObjectBundles);
         writer->WriteBoolean("debugging_tools", model->DebuggingTools);
         writer->WriteBoolean("show_height_as_units", model->ShowHeightAsUnits);
         writer->WriteEnum<TemperatureUnit>("temperature_format", model->TemperatureFormat, Enum_Temperature);
@@ -464,6 +468,8 @@ namespace OpenRCT2::Config
             model->LogServerActions = reader->GetBoolean("log_server_actions", false);
             model->PauseServerIfNoClients = reader->GetBoolean("pause_server_if_no_clients", false);
             model->DesyncDebugging = reader->GetBoolean("desync_debugging", false);
+            model->MetricsExportPath = reader->GetString("metrics_export_path", "");
+            model->MetricsExportInterval = reader->GetInt32("metrics_export_interval", 60);
         }
     }
 
@@ -491,6 +497,8 @@ namespace OpenRCT2::Config
         writer->WriteBoolean("log_server_actions", model->LogServerActions);
         writer->WriteBoolean("pause_server_if_no_clients", model->PauseServerIfNoClients);
         writer->WriteBoolean("desync_debugging", model->DesyncDebugging);
+        writer->WriteString("metrics_export_path", model->MetricsExportPath);
+        writer->WriteInt32("metrics_export_interval", model->MetricsExportInterval);
     }
 
     static void ReadNotifications(IIniReader* reader)
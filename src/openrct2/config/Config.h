@@ -89,6 +89,8 @@ namespace OpenRCT2::Config
         bool PlayIntro;
         int32_t WindowSnapProximity;
         bool SavePluginData;
+        bool UseObjectStore;
+        bool UseObjectBundles;
         bool DebuggingTools;
         int32_t AutosaveFrequency;
         int32_t AutosaveAmount;
@@ -176,6 +178,8 @@ namespace OpenRCT2::Config
         bool LogServerActions;
         bool PauseServerIfNoClients;
         bool DesyncDebugging;
+        u8string MetricsExportPath;
+        int32_t MetricsExportInterval;
     };
 
     struct Notification
@@ -11,6 +11,7 @@
 #    include <windows.h>
 #else
 #    include <sys/stat.h>
+#    include <unistd.h>
 #endif
 
 #include "../Diagnostic.h"
@@ -20,6 +21,7 @@
 #include "FileStream.h"
 #include "String.hpp"
 
+#include <atomic>
 #include <fstream>
 
 namespace OpenRCT2::File
@@ -129,6 +131,38 @@ namespace OpenRCT2::File
         fs.Write(buffer, length);
     }
 
+    static uint32_t GetCurrentProcessIdentifier()
+    {
+#ifdef _WIN32
+        return static_cast<uint32_t>(GetCurrentProcessId());
+#else
+        return static_cast<uint32_t>(getpid());
+#endif
+    }
+
+    bool WriteAllBytesAtomic(u8string_view path, const void* buffer, size_t length)
+    {
+        static std::atomic<uint32_t> _tempFileCounter{};
+        const auto tempPath = String::StdFormat(
+            "%s.%u.%u.tmp", u8string(path).c_str(), GetCurrentProcessIdentifier(), _tempFileCounter++);
+        try
+        {
+            WriteAllBytes(tempPath, buffer, length);
+        }
+        catch (const std::exception&)
+        {
+            Delete(tempPath);
+            throw;
+        }
+
+        if (!Move(tempPath, path))
+        {
+            Delete(tempPath);
+            return false;
+        }
+        return true;
+    }
+
     uint64_t GetLastModified(u8string_view path)
     {
         return Platform::GetLastModified(path);
@@ -138,4 +172,11 @@ namespace OpenRCT2::File
     {
         return Platform::GetFileSize(path);
     }
+
+    bool Touch(u8string_view path)
+    {
+        std::error_code ec;
+        fs::last_write_time(fs::u8path(path), fs::file_time_type::clock::now(), ec);
+        return ec.value() == 0;
+    }
 } // namespace OpenRCT2::File
@@ -23,6 +23,11 @@ namespace OpenRCT2::File
     u8string ReadAllText(u8string_view path);
     std::vector<u8string> ReadAllLines(u8string_view path);
     void WriteAllBytes(u8string_view path, const void* buffer, size_t length);
+    // Writes to a temporary file of this process first and then moves it over path, so that other readers and writers of
+    // path never see a partly written file. Returns false if the file could not be moved into place.
+    bool WriteAllBytesAtomic(u8string_view path, const void* buffer, size_t length);
     uint64_t GetLastModified(u8string_view path);
     uint64_t GetSize(u8string_view path);
+    // Sets the last modified time of the file to now.
+    bool Touch(u8string_view path);
 } // namespace OpenRCT2::File
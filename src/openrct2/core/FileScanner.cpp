@@ -22,11 +22,15 @@
 #endif
 
 #include "FileScanner.h"
+
+#include "../Diagnostic.h"
+#include "File.h"
 #include "Memory.hpp"
 #include "Numerics.hpp"
 #include "Path.hpp"
 #include "String.hpp"
 
+#include <algorithm>
 #include <memory>
 #include <stack>
 #include <string>
@@ -369,6 +373,43 @@ std::vector<std::string> Path::GetDirectories(const std::string& path)
     return subDirectories;
 }
 
+void Path::TrimDirectory(const std::string& pattern, uint64_t maxSize)
+{
+    struct TrimFile
+    {
+        u8string Path;
+        uint64_t Size;
+        uint64_t LastModified;
+    };
+
+    std::vector<TrimFile> files;
+    uint64_t totalSize = 0;
+    auto scanner = Path::ScanDirectory(pattern, false);
+    while (scanner->Next())
+    {
+        const auto& fileInfo = scanner->GetFileInfo();
+        files.push_back({ scanner->GetPath(), fileInfo.Size, fileInfo.LastModified });
+        totalSize += fileInfo.Size;
+    }
+    if (totalSize <= maxSize)
+        return;
+
+    std::sort(files.begin(), files.end(), [](const TrimFile& a, const TrimFile& b) {
+        return a.LastModified < b.LastModified;
+    });
+    for (const auto& file : files)
+    {
+        if (totalSize <= maxSize)
+            break;
+
+        LOG_VERBOSE("Deleting '%s' to trim its directory", file.Path.c_str());
+        if (File::Delete(file.Path))
+        {
+            totalSize -= file.Size;
+        }
+    }
+}
+
 static uint32_t GetPathChecksum(u8string_view path)
 {
     uint32_t hash = 0xD8430DED;
@@ -64,4 +64,12 @@ namespace OpenRCT2::Path
     void QueryDirectory(QueryDirectoryResult* result, const std::string& pattern);
 
     [[nodiscard]] std::vector<std::string> GetDirectories(const std::string& path);
+
+    /**
+     * Deletes the least recently modified files of a directory that match the given pattern, until the remaining ones
+     * take up at most the given number of bytes.
+     * @param pattern The path followed by a semi-colon delimited list of wildcard patterns.
+     * @param maxSize The number of bytes the matching files may take up.
+     */
+    void TrimDirectory(const std::string& pattern, uint64_t maxSize);
 } // namespace OpenRCT2::Path
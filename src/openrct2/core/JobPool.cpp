@@ -9,8 +9,16 @@
 
 #include "JobPool.h"
 
+#include "../profiling/Metrics.h"
+
 #include <cassert>
 
+static OpenRCT2::Metrics::Gauge& GetQueueDepthMetric()
+{
+    static auto& queueDepth = OpenRCT2::Metrics::GetGauge("jobpool.queue_depth");
+    return queueDepth;
+}
+
 JobPool::TaskData::TaskData(std::function<void()> workFn, std::function<void()> completionFn)
     : WorkFn(workFn)
     , CompletionFn(completionFn)
@@ -45,6 +53,7 @@ void JobPool::AddTask(std::function<void()> workFn, std::function<void()> comple
 {
     unique_lock lock(_mutex);
     _pending.emplace_back(workFn, completionFn);
+    GetQueueDepthMetric().Add(1);
     _condPending.notify_one();
 }
 
@@ -115,6 +124,7 @@ void JobPool::ProcessQueue()
 
             auto taskData = _pending.front();
             _pending.pop_front();
+            GetQueueDepthMetric().Add(-1);
 
             lock.unlock();
 
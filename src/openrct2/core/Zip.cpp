@@ -71,6 +71,7 @@ class ZipArchive final : public IZipArchive
 private:
     zip_t* _zip;
     ZIP_ACCESS _access;
+    std::vector<uint8_t> _readBuffer;
     std::vector<std::vector<uint8_t>> _writeBuffers;
 
 public:
@@ -92,6 +93,30 @@ public:
         _access = access;
     }
 
+    ZipArchive(std::vector<uint8_t>&& data)
+        : _readBuffer(std::move(data))
+    {
+        zip_error_t error;
+        zip_error_init(&error);
+        auto source = zip_source_buffer_create(_readBuffer.data(), _readBuffer.size(), 0, &error);
+        if (source == nullptr)
+        {
+            zip_error_fini(&error);
+            throw IOException("Unable to open zip file.");
+        }
+
+        // libzip only reads from the buffer, which is kept until the zip handle is closed.
+        _zip = zip_open_from_source(source, ZIP_RDONLY, &error);
+        zip_error_fini(&error);
+        if (_zip == nullptr)
+        {
+            zip_source_free(source);
+            throw IOException("Unable to open zip file.");
+        }
+
+        _access = ZIP_ACCESS::READ;
+    }
+
     ~ZipArchive() override
     {
         zip_close(_zip);
@@ -395,6 +420,11 @@ namespace OpenRCT2::Zip
         }
         return result;
     }
+
+    std::unique_ptr<IZipArchive> Open(std::string_view path, std::vector<uint8_t>&& data)
+    {
+        return std::make_unique<ZipArchive>(std::move(data));
+    }
 } // namespace OpenRCT2::Zip
 
 #endif
@@ -59,4 +59,10 @@ namespace OpenRCT2::Zip
 {
     [[nodiscard]] std::unique_ptr<IZipArchive> Open(std::string_view path, ZIP_ACCESS zipAccess);
     [[nodiscard]] std::unique_ptr<IZipArchive> TryOpen(std::string_view path, ZIP_ACCESS zipAccess);
+
+    /**
+     * Opens the zip file at the given path for reading from its contents that have already been read into memory.
+     * Platforms that can not read a zip from memory open the path instead.
+     */
+    [[nodiscard]] std::unique_ptr<IZipArchive> Open(std::string_view path, std::vector<uint8_t>&& data);
 } // namespace OpenRCT2::Zip
@@ -155,6 +155,11 @@ namespace OpenRCT2::Zip
         }
         return result;
     }
+
+    std::unique_ptr<IZipArchive> Open(std::string_view path, std::vector<uint8_t>&& data)
+    {
+        return std::make_unique<ZipArchive>(path, ZIP_ACCESS::READ);
+    }
 } // namespace OpenRCT2::Zip
 
 extern "C" {
@@ -946,3 +946,52 @@ size_t G1CalculateDataSize(const G1Element* g1)
 
     return g1->width * g1->height;
 }
+
+bool G1IsDataWithinLength(const G1Element* g1, size_t length)
+{
+    if (g1->width < 0 || g1->height < 0)
+    {
+        return false;
+    }
+
+    if (g1->flags & G1_FLAG_PALETTE)
+    {
+        return static_cast<size_t>(g1->width) * 3 <= length;
+    }
+
+    if (g1->flags & G1_FLAG_RLE_COMPRESSION)
+    {
+        // The image starts with the offset of each row, followed by the chunks of each row
+        const size_t rowOffsetsLength = static_cast<size_t>(g1->height) * 2;
+        if (g1->height == 0 || rowOffsetsLength > length)
+        {
+            return false;
+        }
+
+        const auto* data = g1->offset;
+        for (int32_t y = 0; y < g1->height; y++)
+        {
+            size_t position = data[y * 2] | (data[y * 2 + 1] << 8);
+            bool endOfLine = false;
+            do
+            {
+                if (position + 2 > length)
+                {
+                    return false;
+                }
+                const uint8_t chunk0 = data[position];
+                const uint8_t chunkSize = chunk0 & 0x7F;
+                position += 2 + chunkSize;
+                endOfLine = (chunk0 & 0x80) != 0;
+            } while (!endOfLine);
+
+            if (position > length)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    return static_cast<size_t>(g1->width) * g1->height <= length;
+}
@@ -624,6 +624,8 @@ ImageId ScrollingTextSetup(
     struct PaintSession& session, StringId stringId, Formatter& ft, uint16_t scroll, uint16_t scrollingMode, colour_t colour);
 
 size_t G1CalculateDataSize(const G1Element* g1);
+// Returns whether all the data of the image, including the rows of an RLE image, lies within the given length.
+bool G1IsDataWithinLength(const G1Element* g1, size_t length);
 
 void MaskScalar(
     int32_t width, int32_t height, const uint8_t* RESTRICT maskSrc, const uint8_t* RESTRICT colourSrc, uint8_t* RESTRICT dst,
@@ -0,0 +1,204 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "ImageImportCache.h"
+
+#include "../Diagnostic.h"
+#include "../core/Crypt.h"
+#include "../core/File.h"
+#include "../core/FileScanner.h"
+#include "../core/FileStream.h"
+#include "../core/MemoryStream.h"
+#include "../core/Path.hpp"
+#include "../core/String.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+
+namespace OpenRCT2::Drawing
+{
+    static constexpr uint32_t kMagicNumber = 0x43494D49; // IMIC
+    // Increase when the output of the image importer changes, so that images imported before are not used.
+    static constexpr uint16_t kVersion = 1;
+    static constexpr uint32_t kMaxEntries = 0x10000;
+    static constexpr uint32_t kMaxBufferLength = 0x1000000;
+    // The least recently used files are deleted once the cache directory grows beyond this size.
+    static constexpr uint64_t kMaxDirectorySize = 256 * 1024 * 1024;
+    static constexpr uint64_t kTrimInterval = kMaxDirectorySize / 16;
+
+    // Starts at the interval so that the directory is trimmed the first time an image is cached.
+    static std::atomic<uint64_t> _bytesWrittenSinceTrim{ kTrimInterval };
+    static std::mutex _trimMutex;
+
+    static void TrimDirectory(u8string_view directory, uint64_t bytesWritten)
+    {
+        if (_bytesWrittenSinceTrim.fetch_add(bytesWritten) + bytesWritten < kTrimInterval)
+            return;
+
+        std::lock_guard lock(_trimMutex);
+        if (_bytesWrittenSinceTrim < kTrimInterval)
+            return;
+
+        _bytesWrittenSinceTrim = 0;
+        Path::TrimDirectory(Path::Combine(directory, u8"*.dat"), kMaxDirectorySize);
+    }
+
+    ImageImportCache::ImageImportCache(u8string_view directory, const std::vector<uint8_t>& sourceData, IMAGE_FORMAT format)
+    {
+        if (directory.empty())
+            return;
+
+        const auto formatByte = static_cast<uint8_t>(format);
+        auto sha1 = Crypt::CreateSHA1();
+        sha1->Update(sourceData.data(), sourceData.size());
+        sha1->Update(&formatByte, sizeof(formatByte));
+        _path = Path::Combine(directory, String::StringFromHex(sha1->Finish()) + u8".dat");
+
+        if (!File::Exists(_path))
+            return;
+
+        try
+        {
+            FileStream stream(_path, FILE_MODE_OPEN);
+            ReadEntries(stream);
+            // Keep the file from being trimmed, it is in use
+            File::Touch(_path);
+        }
+        catch (const std::exception& e)
+        {
+            LOG_VERBOSE("Unable to read imported image cache '%s': %s", _path.c_str(), e.what());
+            _entries.clear();
+        }
+    }
+
+    ImageImportCache::Key ImageImportCache::GetKey(const ImageImportMeta& meta)
+    {
+        return {
+            meta.offset.x,
+            meta.offset.y,
+            static_cast<int32_t>(meta.palette),
+            meta.importFlags,
+            static_cast<int32_t>(meta.importMode),
+            meta.srcOffset.x,
+            meta.srcOffset.y,
+            meta.srcSize.width,
+            meta.srcSize.height,
+            meta.zoomedOffset,
+        };
+    }
+
+    const ImageImporter::ImportResult* ImageImportCache::Find(const ImageImportMeta& meta) const
+    {
+        const auto key = GetKey(meta);
+        auto it = std::find_if(_entries.begin(), _entries.end(), [&key](const Entry& entry) { return entry.ImportKey == key; });
+        return it != _entries.end() ? &it->Result : nullptr;
+    }
+
+    const ImageImporter::ImportResult& ImageImportCache::Add(const ImageImportMeta& meta, ImageImporter::ImportResult&& result)
+    {
+        auto& entry = _entries.emplace_back();
+        entry.ImportKey = GetKey(meta);
+        entry.Result = std::move(result);
+        entry.Result.Element.offset = entry.Result.Buffer.data();
+        _modified = true;
+        return entry.Result;
+    }
+
+    void ImageImportCache::Save()
+    {
+        if (!_modified || _path.empty())
+            return;
+
+        try
+        {
+            const auto directory = Path::GetDirectory(_path);
+            Path::CreateDirectory(directory);
+            // Other threads may be saving the same source image, either of the writes ends up in the cache.
+            MemoryStream stream;
+            WriteEntries(stream);
+            File::WriteAllBytesAtomic(_path, stream.GetData(), stream.GetLength());
+            _modified = false;
+            TrimDirectory(directory, stream.GetLength());
+        }
+        catch (const std::exception& e)
+        {
+            LOG_WARNING("Unable to write imported image cache '%s': %s", _path.c_str(), e.what());
+        }
+    }
+
+    void ImageImportCache::ReadEntries(IStream& stream)
+    {
+        if (stream.ReadValue<uint32_t>() != kMagicNumber)
+            throw std::runtime_error("Invalid magic number.");
+        if (stream.ReadValue<uint16_t>() != kVersion)
+            throw std::runtime_error("Different version.");
+
+        const auto numEntries = stream.ReadValue<uint32_t>();
+        if (numEntries > kMaxEntries)
+            throw std::runtime_error("Too many entries.");
+
+        std::vector<Entry> entries(numEntries);
+        for (auto& entry : entries)
+        {
+            for (auto& value : entry.ImportKey)
+            {
+                value = stream.ReadValue<int32_t>();
+            }
+
+            auto& element = entry.Result.Element;
+            element.width = stream.ReadValue<int16_t>();
+            element.height = stream.ReadValue<int16_t>();
+            element.x_offset = stream.ReadValue<int16_t>();
+            element.y_offset = stream.ReadValue<int16_t>();
+            element.flags = stream.ReadValue<uint16_t>();
+            element.zoomed_offset = stream.ReadValue<int32_t>();
+
+            const auto bufferLength = stream.ReadValue<uint32_t>();
+            if (bufferLength > kMaxBufferLength)
+                throw std::runtime_error("Image too large.");
+
+            auto& buffer = entry.Result.Buffer;
+            buffer.resize(bufferLength);
+            stream.Read(buffer.data(), buffer.size());
+            element.offset = buffer.data();
+            if (!G1IsDataWithinLength(&element, buffer.size()))
+                throw std::runtime_error("Image data does not match the image.");
+        }
+        _entries = std::move(entries);
+        _modified = false;
+    }
+
+    void ImageImportCache::WriteEntries(IStream& stream) const
+    {
+        stream.WriteValue<uint32_t>(kMagicNumber);
+        stream.WriteValue<uint16_t>(kVersion);
+        stream.WriteValue<uint32_t>(static_cast<uint32_t>(_entries.size()));
+        for (const auto& entry : _entries)
+        {
+            for (auto value : entry.ImportKey)
+            {
+                stream.WriteValue<int32_t>(value);
+            }
+
+            const auto& element = entry.Result.Element;
+            stream.WriteValue<int16_t>(element.width);
+            stream.WriteValue<int16_t>(element.height);
+            stream.WriteValue<int16_t>(element.x_offset);
+            stream.WriteValue<int16_t>(element.y_offset);
+            stream.WriteValue<uint16_t>(element.flags);
+            stream.WriteValue<int32_t>(element.zoomed_offset);
+
+            const auto& buffer = entry.Result.Buffer;
+            stream.WriteValue<uint32_t>(static_cast<uint32_t>(buffer.size()));
+            stream.Write(buffer.data(), buffer.size());
+        }
+    }
+} // namespace OpenRCT2::Drawing
@@ -0,0 +1,65 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../core/StringTypes.h"
+#include "ImageImporter.h"
+
+#include <array>
+#include <vector>
+
+namespace OpenRCT2
+{
+    struct IStream;
+}
+
+namespace OpenRCT2::Drawing
+{
+    /**
+     * The images imported from one source image file, stored in the cache directory under the hash of the file's
+     * contents. Loading an object whose source images have not changed can then skip decoding and quantising them.
+     */
+    class ImageImportCache
+    {
+    public:
+        using Key = std::array<int32_t, 10>;
+
+    private:
+        struct Entry
+        {
+            Key ImportKey{};
+            ImageImporter::ImportResult Result;
+        };
+
+        u8string _path;
+        std::vector<Entry> _entries;
+        bool _modified{};
+
+    public:
+        /**
+         * @param directory The cache directory, or empty to only keep the images in memory.
+         * @param sourceData The contents of the source image file.
+         * @param format The format the source image is decoded as.
+         */
+        ImageImportCache(u8string_view directory, const std::vector<uint8_t>& sourceData, IMAGE_FORMAT format);
+
+        static Key GetKey(const ImageImportMeta& meta);
+
+        // Returns the image imported with the given meta, or nullptr if it is not in the cache.
+        const ImageImporter::ImportResult* Find(const ImageImportMeta& meta) const;
+        const ImageImporter::ImportResult& Add(const ImageImportMeta& meta, ImageImporter::ImportResult&& result);
+
+        // Writes the images to the cache directory if any were added.
+        void Save();
+
+        void ReadEntries(IStream& stream);
+        void WriteEntries(IStream& stream) const;
+    };
+} // namespace OpenRCT2::Drawing
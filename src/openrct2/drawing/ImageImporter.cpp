@@ -13,7 +13,10 @@
 #include "../core/Json.hpp"
 #include "../util/Util.h"
 
+#include <algorithm>
+#include <array>
 #include <cstring>
+#include <limits>
 #include <stdexcept>
 #include <string>
 
@@ -21,6 +24,48 @@ namespace OpenRCT2::Drawing
 {
     constexpr int32_t PALETTE_TRANSPARENT = -1;
 
+    /**
+     * The standard palette arranged for quick lookups. The colours are sorted so that an exact match can be
+     * found by a binary search, and the channels of the changable colours are stored separately so that the
+     * distances to all of them are calculated by one loop the compiler can vectorise.
+     */
+    struct ImageImporter::PaletteLookup
+    {
+        // The colour in the upper 24 bits and its palette index in the lower 8 bits.
+        std::array<uint32_t, PALETTE_SIZE> SortedColours{};
+
+        size_t NumCandidates{};
+        std::array<int32_t, PALETTE_SIZE> CandidateRed{};
+        std::array<int32_t, PALETTE_SIZE> CandidateGreen{};
+        std::array<int32_t, PALETTE_SIZE> CandidateBlue{};
+        std::array<uint8_t, PALETTE_SIZE> CandidateIndex{};
+    };
+
+    const ImageImporter::PaletteLookup& ImageImporter::GetPaletteLookup()
+    {
+        static const PaletteLookup lookup = []() {
+            PaletteLookup result;
+            for (uint32_t i = 0; i < PALETTE_SIZE; i++)
+            {
+                const auto& entry = StandardPalette[i];
+                result.SortedColours[i] = (static_cast<uint32_t>(entry.Red) << 24) | (static_cast<uint32_t>(entry.Green) << 16)
+                    | (static_cast<uint32_t>(entry.Blue) << 8) | i;
+                if (IsChangablePixel(i))
+                {
+                    result.CandidateRed[result.NumCandidates] = entry.Red;
+                    result.CandidateGreen[result.NumCandidates] = entry.Green;
+                    result.CandidateBlue[result.NumCandidates] = entry.Blue;
+                    result.CandidateIndex[result.NumCandidates] = static_cast<uint8_t>(i);
+                    result.NumCandidates++;
+                }
+            }
+            // Duplicate colours stay in index order, so the lowest index is found first as before.
+            std::sort(result.SortedColours.begin(), result.SortedColours.end());
+            return result;
+        }();
+        return lookup;
+    }
+
     ImageImporter::ImportResult ImageImporter::Import(const Image& image, ImageImportMeta& meta) const
     {
         if (meta.srcSize.width == 0)
@@ -237,10 +282,11 @@ namespace OpenRCT2::Drawing
         ImportMode mode, int16_t* rgbaSrc, int32_t x, int32_t y, int32_t width, int32_t height)
     {
         auto& palette = StandardPalette;
-        auto paletteIndex = GetPaletteIndex(palette, rgbaSrc);
-        if ((mode == ImportMode::Closest || mode == ImportMode::Dithering) && !IsInPalette(palette, rgbaSrc))
+        auto paletteIndex = GetPaletteIndex(rgbaSrc);
+        const bool isInPalette = paletteIndex != PALETTE_TRANSPARENT || IsTransparentPixel(rgbaSrc);
+        if ((mode == ImportMode::Closest || mode == ImportMode::Dithering) && !isInPalette)
         {
-            paletteIndex = GetClosestPaletteIndex(palette, rgbaSrc);
+            paletteIndex = GetClosestPaletteIndex(rgbaSrc);
             if (mode == ImportMode::Dithering)
             {
                 auto dr = rgbaSrc[0] - static_cast<int16_t>(palette[paletteIndex].Red);
@@ -252,8 +298,8 @@ namespace OpenRCT2::Drawing
 
                 if (x + 1 < width)
                 {
-                    if (!IsInPalette(palette, rgbaSrc + 4)
-                        && thisIndexType == GetPaletteIndexType(GetClosestPaletteIndex(palette, rgbaSrc + 4)))
+                    if (!IsInPalette(rgbaSrc + 4)
+                        && thisIndexType == GetPaletteIndexType(GetClosestPaletteIndex(rgbaSrc + 4)))
                     {
                         // Right
                         rgbaSrc[4] += dr * 7 / 16;
@@ -266,8 +312,8 @@ namespace OpenRCT2::Drawing
                 {
                     if (x > 0)
                     {
-                        if (!IsInPalette(palette, rgbaSrc + 4 * (width - 1))
-                            && thisIndexType == GetPaletteIndexType(GetClosestPaletteIndex(palette, rgbaSrc + 4 * (width - 1))))
+                        if (!IsInPalette(rgbaSrc + 4 * (width - 1))
+                            && thisIndexType == GetPaletteIndexType(GetClosestPaletteIndex(rgbaSrc + 4 * (width - 1))))
                         {
                             // Bottom left
                             rgbaSrc[4 * (width - 1)] += dr * 3 / 16;
@@ -277,8 +323,8 @@ namespace OpenRCT2::Drawing
                     }
 
                     // Bottom
-                    if (!IsInPalette(palette, rgbaSrc + 4 * width)
-                        && thisIndexType == GetPaletteIndexType(GetClosestPaletteIndex(palette, rgbaSrc + 4 * width)))
+                    if (!IsInPalette(rgbaSrc + 4 * width)
+                        && thisIndexType == GetPaletteIndexType(GetClosestPaletteIndex(rgbaSrc + 4 * width)))
                     {
                         rgbaSrc[4 * width] += dr * 5 / 16;
                         rgbaSrc[4 * width + 1] += dg * 5 / 16;
@@ -287,8 +333,8 @@ namespace OpenRCT2::Drawing
 
                     if (x + 1 < width)
                     {
-                        if (!IsInPalette(palette, rgbaSrc + 4 * (width + 1))
-                            && thisIndexType == GetPaletteIndexType(GetClosestPaletteIndex(palette, rgbaSrc + 4 * (width + 1))))
+                        if (!IsInPalette(rgbaSrc + 4 * (width + 1))
+                            && thisIndexType == GetPaletteIndexType(GetClosestPaletteIndex(rgbaSrc + 4 * (width + 1))))
                         {
                             // Bottom right
                             rgbaSrc[4 * (width + 1)] += dr * 1 / 16;
@@ -303,18 +349,22 @@ namespace OpenRCT2::Drawing
         return paletteIndex;
     }
 
-    int32_t ImageImporter::GetPaletteIndex(const GamePalette& palette, int16_t* colour)
+    int32_t ImageImporter::GetPaletteIndex(const int16_t* colour)
     {
-        if (!IsTransparentPixel(colour))
+        if (IsTransparentPixel(colour))
+            return PALETTE_TRANSPARENT;
+
+        // Dithering can push the channels out of range, such colours are never in the palette.
+        if (std::any_of(colour, colour + 3, [](int16_t channel) { return channel < 0 || channel > 255; }))
+            return PALETTE_TRANSPARENT;
+
+        const auto& sortedColours = GetPaletteLookup().SortedColours;
+        const uint32_t key = (static_cast<uint32_t>(colour[0]) << 24) | (static_cast<uint32_t>(colour[1]) << 16)
+            | (static_cast<uint32_t>(colour[2]) << 8);
+        auto it = std::lower_bound(sortedColours.begin(), sortedColours.end(), key);
+        if (it != sortedColours.end() && (*it >> 8) == (key >> 8))
         {
-            for (uint32_t i = 0; i < PALETTE_SIZE; i++)
-            {
-                if (static_cast<int16_t>(palette[i].Red) == colour[0] && static_cast<int16_t>(palette[i].Green) == colour[1]
-                    && static_cast<int16_t>(palette[i].Blue) == colour[2])
-                {
-                    return i;
-                }
-            }
+            return *it & 0xFF;
         }
         return PALETTE_TRANSPARENT;
     }
@@ -327,9 +377,9 @@ namespace OpenRCT2::Drawing
     /**
      * @returns true if this colour is in the standard palette.
      */
-    bool ImageImporter::IsInPalette(const GamePalette& palette, int16_t* colour)
+    bool ImageImporter::IsInPalette(const int16_t* colour)
     {
-        return !(GetPaletteIndex(palette, colour) == PALETTE_TRANSPARENT && !IsTransparentPixel(colour));
+        return !(GetPaletteIndex(colour) == PALETTE_TRANSPARENT && !IsTransparentPixel(colour));
     }
 
     /**
@@ -361,28 +411,60 @@ namespace OpenRCT2::Drawing
         return PaletteIndexType::Normal;
     }
 
-    int32_t ImageImporter::GetClosestPaletteIndex(const GamePalette& palette, const int16_t* colour)
+    int32_t ImageImporter::GetClosestPaletteIndex(const int16_t* colour)
     {
-        auto smallestError = static_cast<uint32_t>(-1);
-        auto bestMatch = PALETTE_TRANSPARENT;
-        for (uint32_t x = 0; x < PALETTE_SIZE; x++)
+        // Images tend to reuse the same colours, and dithering asks for the colour of each neighbour as well,
+        // so remember the most recent answers.
+        struct CachedColour
         {
-            if (IsChangablePixel(x))
-            {
-                uint32_t error = (static_cast<int16_t>(palette[x].Red) - colour[0])
-                        * (static_cast<int16_t>(palette[x].Red) - colour[0])
-                    + (static_cast<int16_t>(palette[x].Green) - colour[1])
-                        * (static_cast<int16_t>(palette[x].Green) - colour[1])
-                    + (static_cast<int16_t>(palette[x].Blue) - colour[2]) * (static_cast<int16_t>(palette[x].Blue) - colour[2]);
+            uint64_t Key = std::numeric_limits<uint64_t>::max();
+            int32_t PaletteIndex{};
+        };
+        static thread_local std::array<CachedColour, 4096> cache;
 
-                if (smallestError == static_cast<uint32_t>(-1) || smallestError > error)
-                {
-                    bestMatch = x;
-                    smallestError = error;
-                }
-            }
+        const uint64_t key = static_cast<uint64_t>(static_cast<uint16_t>(colour[0]))
+            | (static_cast<uint64_t>(static_cast<uint16_t>(colour[1])) << 16)
+            | (static_cast<uint64_t>(static_cast<uint16_t>(colour[2])) << 32);
+        auto& cached = cache[(key * 0x9E3779B97F4A7C15ull) >> 52];
+        if (cached.Key != key)
+        {
+            cached.Key = key;
+            cached.PaletteIndex = FindClosestPaletteIndex(colour);
+        }
+        return cached.PaletteIndex;
+    }
+
+    int32_t ImageImporter::FindClosestPaletteIndex(const int16_t* colour)
+    {
+        const auto& lookup = GetPaletteLookup();
+        const auto numCandidates = lookup.NumCandidates;
+        const int32_t red = colour[0];
+        const int32_t green = colour[1];
+        const int32_t blue = colour[2];
+
+        // Kept as separate simple loops so that each of them is vectorised.
+        std::array<int32_t, PALETTE_SIZE> errors;
+        for (size_t i = 0; i < numCandidates; i++)
+        {
+            const auto dr = lookup.CandidateRed[i] - red;
+            const auto dg = lookup.CandidateGreen[i] - green;
+            const auto db = lookup.CandidateBlue[i] - blue;
+            errors[i] = dr * dr + dg * dg + db * db;
+        }
+
+        auto smallestError = errors[0];
+        for (size_t i = 1; i < numCandidates; i++)
+        {
+            smallestError = std::min(smallestError, errors[i]);
         }
-        return bestMatch;
+
+        // The first candidate with the smallest error wins, as the candidates are in palette order.
+        for (size_t i = 0; i < numCandidates; i++)
+        {
+            if (errors[i] == smallestError)
+                return lookup.CandidateIndex[i];
+        }
+        return PALETTE_TRANSPARENT;
     }
 
     ImageImportMeta createImageImportMetaFromJson(json_t& input)
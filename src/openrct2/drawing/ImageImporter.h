@@ -75,18 +75,22 @@ namespace OpenRCT2::Drawing
             Special,
         };
 
+        struct PaletteLookup;
+
+        static const PaletteLookup& GetPaletteLookup();
         static std::vector<int32_t> GetPixels(const Image& image, const ImageImportMeta& meta);
         static std::vector<uint8_t> EncodeRaw(const int32_t* pixels, ScreenSize size);
         static std::vector<uint8_t> EncodeRLE(const int32_t* pixels, ScreenSize size);
 
         static int32_t CalculatePaletteIndex(
             ImportMode mode, int16_t* rgbaSrc, int32_t x, int32_t y, int32_t width, int32_t height);
-        static int32_t GetPaletteIndex(const GamePalette& palette, int16_t* colour);
+        static int32_t GetPaletteIndex(const int16_t* colour);
         static bool IsTransparentPixel(const int16_t* colour);
-        static bool IsInPalette(const GamePalette& palette, int16_t* colour);
+        static bool IsInPalette(const int16_t* colour);
         static bool IsChangablePixel(int32_t paletteIndex);
         static PaletteIndexType GetPaletteIndexType(int32_t paletteIndex);
-        static int32_t GetClosestPaletteIndex(const GamePalette& palette, const int16_t* colour);
+        static int32_t GetClosestPaletteIndex(const int16_t* colour);
+        static int32_t FindClosestPaletteIndex(const int16_t* colour);
     };
 
     // Note: jsonSprite is deliberately left non-const: json_t behaviour changes when const.
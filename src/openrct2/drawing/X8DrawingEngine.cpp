@@ -15,6 +15,7 @@
 #include "../interface/Screenshot.h"
 #include "../interface/Viewport.h"
 #include "../interface/Window.h"
+#include "../profiling/Metrics.h"
 #include "../scenes/intro/IntroScene.h"
 #include "../ui/UiContext.h"
 #include "Drawing.h"
@@ -211,6 +212,8 @@ void X8DrawingEngine::PaintWindows()
     DrawAllDirtyBlocks();
     WindowUpdateAllViewports();
     DrawAllDirtyBlocks();
+
+    RecordDirtyStatistics();
 }
 
 void X8DrawingEngine::PaintWeather()
@@ -365,93 +368,144 @@ void X8DrawingEngine::ConfigureDirtyGrid()
 
 void X8DrawingEngine::DrawAllDirtyBlocks()
 {
-    // TODO: For optimal performance it is currently limited to a single column.
-    // The optimal approach would be to extract all dirty regions as rectangles not including
-    // parts that are not marked dirty and have the grid more fine grained.
-    // A situation like following:
-    //
-    //   0 1 2 3 4 5 6 7 8 9
-    //   1 - - - - - - - - -
-    //   2 - x x x x - - - -
-    //   3 - x x - - - - - -
-    //   4 - - - - - - - - -
-    //   5 - - - - - - - - -
-    //   6 - - - - - - - - -
-    //   7 - - - - - - - - -
-    //   8 - - - - - - - - -
-    //   9 - - - - - - - - -
-    //
-    // Would currently redraw {2,2} to {3,5} where {3,4} and {3,5} are not dirty. Choosing to do this
-    // per column eliminates this issue but limits it to rendering just a single column at a time.
-
-    for (uint32_t x = 0; x < _dirtyGrid.BlockColumns; x++)
+    CollectDirtyRects();
+
+    // The rectangles do not overlap, so each one redraws its part of the windows once. Viewports within a rectangle
+    // are painted as a whole, spreading their columns over the paint jobs when parallel drawing is enabled.
+    for (const auto& rect : _dirtyRects)
     {
-        for (uint32_t y = 0; y < _dirtyGrid.BlockRows; y++)
-        {
-            uint32_t yOffset = y * _dirtyGrid.BlockColumns;
-            if (_dirtyGrid.Blocks[yOffset + x] == 0)
-            {
-                continue;
-            }
+        DrawDirtyRect(rect);
+    }
+    _dirtyRects.clear();
+}
 
-            // See comment above as to why this is 1.
-            const uint32_t columns = 1;
+// Marks blocks that are already part of a rectangle while the rectangles are collected.
+static constexpr uint8_t kCoveredBlock = 1;
 
-            // Check rows
-            auto rows = GetNumDirtyRows(x, y, columns);
-            DrawDirtyBlocks(x, y, columns, rows);
-        }
-    }
+static bool IsDirtyBlock(uint8_t block)
+{
+    return block != 0 && block != kCoveredBlock;
 }
 
-uint32_t X8DrawingEngine::GetNumDirtyRows(const uint32_t x, const uint32_t y, const uint32_t columns)
+// Every rectangle sets up its own paint sessions for each viewport it covers, so a rectangle may take in clean
+// blocks as long as it redraws at most a quarter more blocks than are dirty.
+static bool IsWithinDirtyRectOverdraw(uint32_t blocks, uint32_t dirtyBlocks)
 {
-    uint32_t yy = y;
+    return blocks * 4 <= dirtyBlocks * 5;
+}
 
-    for (yy = y; yy < _dirtyGrid.BlockRows; yy++)
-    {
-        uint32_t yyOffset = yy * _dirtyGrid.BlockColumns;
-        for (uint32_t xx = x; xx < x + columns; xx++)
+/**
+ * Extracts the dirty blocks as non-overlapping rectangles and unsets them. Each rectangle starts at the top left-most
+ * dirty block left, takes the run of blocks to its right and extends down for as long as the rows below that run are
+ * dirty. Runs and rows may include clean blocks within the overdraw allowance. A situation like following:
+ *
+ *   - - - - - - -
+ *   - x x x x - -
+ *   - x x - - - -
+ *   - x x - - - -
+ *   - - - - - - -
+ *
+ * becomes {1,1} to {4,1} and {1,2} to {2,3}, where drawing per column would take three rectangles and drawing the
+ * bounding box would redraw four blocks that are not dirty. Every block is looked at a bounded number of times, so
+ * this is linear in the size of the grid.
+ */
+void X8DrawingEngine::CollectDirtyRects()
+{
+    const uint32_t columns = _dirtyGrid.BlockColumns;
+    const uint32_t rows = _dirtyGrid.BlockRows;
+    uint8_t* blocks = _dirtyGrid.Blocks;
+
+    _dirtyRects.clear();
+    for (uint32_t y = 0; y < rows; y++)
+    {
+        uint8_t* row = blocks + (y * columns);
+        uint32_t x = 0;
+        while (x < columns)
         {
-            if (_dirtyGrid.Blocks[yyOffset + xx] == 0)
+            if (!IsDirtyBlock(row[x]))
             {
-                return yy - y;
+                x++;
+                continue;
             }
-        }
-    }
-    return yy - y;
-}
 
-void X8DrawingEngine::DrawDirtyBlocks(uint32_t x, uint32_t y, uint32_t columns, uint32_t rows)
-{
-    uint32_t dirtyBlockColumns = _dirtyGrid.BlockColumns;
-    uint8_t* screenDirtyBlocks = _dirtyGrid.Blocks;
+            // Take the blocks to the right, bridging clean gaps that stay within the allowance.
+            uint32_t right = x + 1;
+            uint32_t dirtyBlocks = 1;
+            for (uint32_t probe = right; probe < columns && row[probe] != kCoveredBlock; probe++)
+            {
+                if (!IsWithinDirtyRectOverdraw(probe + 1 - x, dirtyBlocks + 1))
+                    break;
+                if (IsDirtyBlock(row[probe]))
+                {
+                    dirtyBlocks++;
+                    right = probe + 1;
+                }
+            }
 
-    // Unset dirty blocks
-    for (uint32_t top = y; top < y + rows; top++)
-    {
-        uint32_t topOffset = top * dirtyBlockColumns;
-        for (uint32_t left = x; left < x + columns; left++)
-        {
-            screenDirtyBlocks[topOffset + left] = 0;
+            // Extend down while the rectangle as a whole stays within the allowance.
+            uint32_t bottom = y + 1;
+            while (bottom < rows)
+            {
+                const uint8_t* rowBelow = blocks + (bottom * columns);
+                if (std::find(rowBelow + x, rowBelow + right, kCoveredBlock) != rowBelow + right)
+                    break;
+
+                const auto dirtyBlocksBelow = static_cast<uint32_t>(
+                    std::count_if(rowBelow + x, rowBelow + right, IsDirtyBlock));
+                if (dirtyBlocksBelow == 0
+                    || !IsWithinDirtyRectOverdraw((bottom + 1 - y) * (right - x), dirtyBlocks + dirtyBlocksBelow))
+                    break;
+
+                dirtyBlocks += dirtyBlocksBelow;
+                bottom++;
+            }
+
+            for (uint32_t yy = y; yy < bottom; yy++)
+            {
+                std::fill_n(blocks + (yy * columns) + x, right - x, kCoveredBlock);
+            }
+            _dirtyRects.push_back({ x, y, right - x, bottom - y });
+            x = right;
         }
     }
+    std::fill_n(blocks, columns * rows, 0);
+}
 
+void X8DrawingEngine::DrawDirtyRect(const DirtyRect& rect)
+{
     // Determine region in pixels
-    uint32_t left = std::max<uint32_t>(0, x * _dirtyGrid.BlockWidth);
-    uint32_t top = std::max<uint32_t>(0, y * _dirtyGrid.BlockHeight);
-    uint32_t right = std::min(_width, left + (columns * _dirtyGrid.BlockWidth));
-    uint32_t bottom = std::min(_height, top + (rows * _dirtyGrid.BlockHeight));
+    uint32_t left = rect.Left * _dirtyGrid.BlockWidth;
+    uint32_t top = rect.Top * _dirtyGrid.BlockHeight;
+    uint32_t right = std::min(_width, left + (rect.Columns * _dirtyGrid.BlockWidth));
+    uint32_t bottom = std::min(_height, top + (rect.Rows * _dirtyGrid.BlockHeight));
     if (right <= left || bottom <= top)
     {
         return;
     }
 
+    _frameDirtyRects++;
+    _frameDirtyPixels += static_cast<uint64_t>(right - left) * (bottom - top);
+
     // Draw region
-    OnDrawDirtyBlock(x, y, columns, rows);
+    OnDrawDirtyBlock(rect.Left, rect.Top, rect.Columns, rect.Rows);
     WindowDrawAll(_bitsDPI, left, top, right, bottom);
 }
 
+void X8DrawingEngine::RecordDirtyStatistics()
+{
+    static auto& rectsMetric = Metrics::GetHistogram("drawing.dirty_rects");
+    static auto& areaMetric = Metrics::GetHistogram("drawing.dirty_area_percent");
+    static auto& pixelsMetric = Metrics::GetCounter("drawing.dirty_pixels");
+
+    const auto screenPixels = static_cast<uint64_t>(_width) * _height;
+    rectsMetric.Record(_frameDirtyRects);
+    areaMetric.Record(screenPixels != 0 ? 100.0 * _frameDirtyPixels / screenPixels : 0.0);
+    pixelsMetric.Add(_frameDirtyPixels);
+
+    _frameDirtyRects = 0;
+    _frameDirtyPixels = 0;
+}
+
 #ifdef __WARN_SUGGEST_FINAL_METHODS__
 #    pragma GCC diagnostic pop
 #endif
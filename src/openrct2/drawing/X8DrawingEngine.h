@@ -13,6 +13,7 @@
 #include "IDrawingEngine.h"
 
 #include <memory>
+#include <vector>
 
 namespace OpenRCT2
 {
@@ -36,6 +37,15 @@ namespace OpenRCT2
             uint8_t* Blocks;
         };
 
+        // A rectangle of the dirty grid, in blocks.
+        struct DirtyRect
+        {
+            uint32_t Left;
+            uint32_t Top;
+            uint32_t Columns;
+            uint32_t Rows;
+        };
+
         class X8WeatherDrawer final : public IWeatherDrawer
         {
         private:
@@ -74,6 +84,9 @@ namespace OpenRCT2
             uint8_t* _bits = nullptr;
 
             DirtyGrid _dirtyGrid = {};
+            std::vector<DirtyRect> _dirtyRects;
+            uint32_t _frameDirtyRects = 0;
+            uint64_t _frameDirtyPixels = 0;
 
             DrawPixelInfo _bitsDPI = {};
 
@@ -120,8 +133,9 @@ namespace OpenRCT2
         private:
             void ConfigureDirtyGrid();
             void DrawAllDirtyBlocks();
-            uint32_t GetNumDirtyRows(const uint32_t x, const uint32_t y, const uint32_t columns);
-            void DrawDirtyBlocks(uint32_t x, uint32_t y, uint32_t columns, uint32_t rows);
+            void CollectDirtyRects();
+            void DrawDirtyRect(const DirtyRect& rect);
+            void RecordDirtyStatistics();
         };
 #ifdef __WARN_SUGGEST_FINAL_TYPES__
 #    pragma GCC diagnostic pop
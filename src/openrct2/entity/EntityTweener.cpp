@@ -10,6 +10,7 @@
 
 #include "../entity/Guest.h"
 #include "../entity/Staff.h"
+#include "../interface/Viewport.h"
 #include "../ride/Vehicle.h"
 #include "EntityList.h"
 #include "EntityRegistry.h"
@@ -17,10 +18,36 @@
 #include <algorithm>
 #include <cmath>
 
+static uint32_t GetTileKey(const CoordsXY& pos)
+{
+    const auto tilePos = TileCoordsXY(pos);
+    return (static_cast<uint32_t>(tilePos.x) << 16) | static_cast<uint16_t>(tilePos.y);
+}
+
+static void InvalidateEntityAt(const EntityBase& entity, const CoordsXYZ& pos)
+{
+    // Entities that are not on the map, such as peeps on rides, are not drawn.
+    if (pos.x == kLocationNull)
+        return;
+
+    // Peeps and vehicles are not drawn further out than zoom level 2.
+    ViewportsInvalidate(pos, entity.SpriteData.Width, entity.SpriteData.HeightMin, entity.SpriteData.HeightMax, ZoomLevel{ 2 });
+}
+
 void EntityTweener::AddEntity(EntityBase* entity)
 {
-    Entities.push_back(entity);
-    PrePos.emplace_back(entity->GetLocation());
+    const auto index = entity->Id.ToUnderlying();
+    if (index >= States.size())
+    {
+        States.resize(index + 1);
+    }
+
+    auto& state = States[index];
+    state.PrePos = entity->GetLocation();
+    state.PostPos = state.PrePos;
+    state.PaintPos = state.PrePos;
+    state.Tracked = true;
+    Entities.push_back(entity->Id);
 }
 
 void EntityTweener::PopulateEntities()
@@ -48,17 +75,19 @@ void EntityTweener::PreTick()
 
 void EntityTweener::PostTick()
 {
-    for (auto* ent : Entities)
+    for (auto id : Entities)
     {
+        auto& state = States[id.ToUnderlying()];
+        if (!state.Tracked)
+            continue;
+
+        auto* ent = GetEntity(id);
         if (ent == nullptr)
         {
-            // Sprite was removed, add a dummy position to keep the index aligned.
-            PostPos.emplace_back(0, 0, 0);
-        }
-        else
-        {
-            PostPos.emplace_back(ent->GetLocation());
+            state.Tracked = false;
+            continue;
         }
+        state.PostPos = ent->GetLocation();
     }
 }
 
@@ -77,55 +106,132 @@ void EntityTweener::RemoveEntity(EntityBase* entity)
         return;
     }
 
-    auto it = std::find(Entities.begin(), Entities.end(), entity);
-    if (it != Entities.end())
-        *it = nullptr;
+    const auto index = entity->Id.ToUnderlying();
+    if (index >= States.size() || !States[index].Tracked)
+        return;
+
+    auto& state = States[index];
+    if (IsTweening && state.PaintPos != entity->GetLocation())
+    {
+        InvalidateEntityAt(*entity, state.PaintPos);
+    }
+    state.Tracked = false;
+}
+
+const EntityTweener::TweenState* EntityTweener::GetTweenState(const EntityBase& entity) const
+{
+    if (!IsTweening)
+        return nullptr;
+
+    const auto index = entity.Id.ToUnderlying();
+    if (index >= States.size())
+        return nullptr;
+
+    // Entities moved outside of a tick are painted where they are.
+    const auto& state = States[index];
+    if (!state.Tracked || state.PostPos != entity.GetLocation())
+        return nullptr;
+    return &state;
 }
 
 void EntityTweener::Tween(float alpha)
 {
     const float inv = (1.0f - alpha);
-    for (size_t i = 0; i < Entities.size(); ++i)
+
+    DisplacedEntities.clear();
+    IsTweening = true;
+    for (auto id : Entities)
     {
-        auto* ent = Entities[i];
-        if (ent == nullptr)
+        auto& state = States[id.ToUnderlying()];
+        if (!state.Tracked)
             continue;
 
-        auto& posA = PrePos[i];
-        auto& posB = PostPos[i];
-
-        if (posA == posB)
+        auto* ent = GetEntity(id);
+        if (ent == nullptr || state.PostPos != ent->GetLocation())
             continue;
 
-        ent->Invalidate();
-        EntitySetCoordinates(
-            { static_cast<int32_t>(std::round(posB.x * alpha + posA.x * inv)),
-              static_cast<int32_t>(std::round(posB.y * alpha + posA.y * inv)),
-              static_cast<int32_t>(std::round(posB.z * alpha + posA.z * inv)) },
-            ent);
-        ent->Invalidate();
+        const auto& posA = state.PrePos;
+        const auto& posB = state.PostPos;
+
+        // Entities that enter or leave the map are not interpolated.
+        CoordsXYZ paintPos = posB;
+        if (posA != posB && posA.x != kLocationNull && posB.x != kLocationNull)
+        {
+            paintPos = { static_cast<int32_t>(std::round(posB.x * alpha + posA.x * inv)),
+                         static_cast<int32_t>(std::round(posB.y * alpha + posA.y * inv)),
+                         static_cast<int32_t>(std::round(posB.z * alpha + posA.z * inv)) };
+        }
+
+        if (paintPos != state.PaintPos)
+        {
+            InvalidateEntityAt(*ent, state.PaintPos);
+            InvalidateEntityAt(*ent, paintPos);
+            state.PaintPos = paintPos;
+        }
+
+        const auto tileKey = GetTileKey(paintPos);
+        if (tileKey != GetTileKey(posB))
+        {
+            DisplacedEntities.push_back({ tileKey, ent });
+        }
     }
+
+    std::sort(DisplacedEntities.begin(), DisplacedEntities.end(), [](const DisplacedEntity& a, const DisplacedEntity& b) {
+        return a.TileKey < b.TileKey;
+    });
 }
 
 void EntityTweener::Restore()
 {
-    for (size_t i = 0; i < Entities.size(); ++i)
+    if (!IsTweening)
+        return;
+
+    for (auto id : Entities)
     {
-        auto* ent = Entities[i];
-        if (ent == nullptr)
+        const auto& state = States[id.ToUnderlying()];
+        if (!state.Tracked)
             continue;
 
-        ent->Invalidate();
-        EntitySetCoordinates(PostPos[i], ent);
-        ent->Invalidate();
+        auto* ent = GetEntity(id);
+        if (ent != nullptr && state.PaintPos != ent->GetLocation())
+        {
+            InvalidateEntityAt(*ent, state.PaintPos);
+            InvalidateEntityAt(*ent, ent->GetLocation());
+        }
     }
+    IsTweening = false;
 }
 
 void EntityTweener::Reset()
 {
+    for (auto id : Entities)
+    {
+        States[id.ToUnderlying()].Tracked = false;
+    }
     Entities.clear();
-    PrePos.clear();
-    PostPos.clear();
+    DisplacedEntities.clear();
+    IsTweening = false;
+}
+
+CoordsXYZ EntityTweener::GetPaintLocation(const EntityBase& entity) const
+{
+    const auto* state = GetTweenState(entity);
+    return state != nullptr ? state->PaintPos : entity.GetLocation();
+}
+
+bool EntityTweener::IsDisplaced(const EntityBase& entity) const
+{
+    const auto* state = GetTweenState(entity);
+    return state != nullptr && GetTileKey(state->PaintPos) != GetTileKey(state->PostPos);
+}
+
+std::span<const EntityTweener::DisplacedEntity> EntityTweener::GetDisplacedEntities(const CoordsXY& tilePos) const
+{
+    const auto tileKey = GetTileKey(tilePos);
+    auto range = std::equal_range(
+        DisplacedEntities.begin(), DisplacedEntities.end(), DisplacedEntity{ tileKey, nullptr },
+        [](const DisplacedEntity& a, const DisplacedEntity& b) { return a.TileKey < b.TileKey; });
+    return { range.first, range.second };
 }
 
 static EntityTweener tweener;
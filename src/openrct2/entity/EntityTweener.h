@@ -11,17 +11,42 @@
 
 #include "EntityBase.h"
 
+#include <span>
 #include <vector>
 
+/**
+ * Interpolates the positions of peeps and vehicles between ticks when the frame rate is uncapped. The entities
+ * themselves are never moved, the painter asks for the position to paint each entity at instead.
+ */
 class EntityTweener
 {
-    std::vector<EntityBase*> Entities;
-    std::vector<CoordsXYZ> PrePos;
-    std::vector<CoordsXYZ> PostPos;
+public:
+    struct DisplacedEntity
+    {
+        uint32_t TileKey;
+        EntityBase* Entity;
+    };
+
+private:
+    struct TweenState
+    {
+        CoordsXYZ PrePos;
+        CoordsXYZ PostPos;
+        CoordsXYZ PaintPos;
+        bool Tracked{};
+    };
+
+    // Indexed by entity id.
+    std::vector<TweenState> States;
+    std::vector<EntityId> Entities;
+    // Entities painted on another tile than the one they are on, sorted by the tile they are painted on.
+    std::vector<DisplacedEntity> DisplacedEntities;
+    bool IsTweening{};
 
 private:
     void PopulateEntities();
     void AddEntity(EntityBase* entity);
+    const TweenState* GetTweenState(const EntityBase& entity) const;
 
 public:
     static EntityTweener& Get();
@@ -30,6 +55,14 @@ public:
     void PostTick();
     void RemoveEntity(EntityBase* entity);
     void Tween(float alpha);
+    // Invalidates the interpolated positions, so that the entities are drawn at their actual positions again.
     void Restore();
     void Reset();
+
+    // Returns the position to paint the entity at, which is its actual position unless it is being interpolated.
+    CoordsXYZ GetPaintLocation(const EntityBase& entity) const;
+    // Returns true if the entity is painted on another tile than the one it is on.
+    bool IsDisplaced(const EntityBase& entity) const;
+    // Returns the entities painted on the given tile that are on another tile.
+    std::span<const DisplacedEntity> GetDisplacedEntities(const CoordsXY& tilePos) const;
 };
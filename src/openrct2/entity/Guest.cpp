@@ -7485,34 +7485,7 @@ void Guest::RemoveFromQueue()
     if (ride == nullptr)
         return;
 
-    auto& station = ride->GetStation(CurrentRideStation);
-    // Make sure we don't underflow, building while paused might reset it to 0 where peeps have
-    // not yet left the queue.
-    if (station.QueueLength > 0)
-    {
-        station.QueueLength--;
-    }
-
-    if (Id == station.LastPeepInQueue)
-    {
-        station.LastPeepInQueue = GuestNextInQueue;
-        return;
-    }
-
-    auto* otherGuest = GetEntity<Guest>(station.LastPeepInQueue);
-    if (otherGuest == nullptr)
-    {
-        LOG_ERROR("Invalid Guest Queue list!");
-        return;
-    }
-    for (; otherGuest != nullptr; otherGuest = GetEntity<Guest>(otherGuest->GuestNextInQueue))
-    {
-        if (Id == otherGuest->GuestNextInQueue)
-        {
-            otherGuest->GuestNextInQueue = GuestNextInQueue;
-            return;
-        }
-    }
+    ride->QueueRemoveGuest(CurrentRideStation, this);
 }
 
 uint64_t Guest::GetItemFlags() const
@@ -263,6 +263,8 @@ struct Guest : Peep
 public:
     uint8_t GuestNumRides;
     EntityId GuestNextInQueue;
+    // The guest behind in the queue. Not saved, rebuilt from GuestNextInQueue when a park is loaded.
+    EntityId GuestBehindInQueue;
     int32_t ParkEntryTime;
     RideId GuestHeadingToRideId;
     uint8_t GuestIsLostCountdown;
@@ -1830,11 +1830,7 @@ static bool PeepInteractWithEntrance(Peep* peep, const CoordsXYE& coords, uint8_
         guest->AnimationImageIdOffset = _backupAnimationImageIdOffset;
         guest->InteractionRideIndex = rideIndex;
 
-        auto& station = ride->GetStation(stationNum);
-        auto previous_last = station.LastPeepInQueue;
-        station.LastPeepInQueue = guest->Id;
-        guest->GuestNextInQueue = previous_last;
-        station.QueueLength++;
+        ride->QueueAppendGuest(stationNum, guest);
 
         guest->CurrentRide = rideIndex;
         guest->CurrentRideStation = stationNum;
@@ -2257,11 +2253,7 @@ static void PeepInteractWithPath(Peep* peep, const CoordsXYE& coords)
                     guest->InteractionRideIndex = rideIndex;
 
                     // Add the peep to the ride queue.
-                    auto& station = ride->GetStation(stationNum);
-                    auto old_last_peep = station.LastPeepInQueue;
-                    station.LastPeepInQueue = guest->Id;
-                    guest->GuestNextInQueue = old_last_peep;
-                    station.QueueLength++;
+                    ride->QueueAppendGuest(stationNum, guest);
 
                     PeepDecrementNumRiders(guest);
                     guest->CurrentRide = rideIndex;
@@ -2830,7 +2822,7 @@ void Peep::Serialise(DataSerialiser& stream)
     stream << PeepFlags;
 }
 
-void Peep::Paint(PaintSession& session, int32_t imageDirection) const
+void Peep::Paint(PaintSession& session, int32_t imageDirection, const CoordsXYZ& location) const
 {
     PROFILED_FUNCTION();
 
@@ -2838,7 +2830,7 @@ void Peep::Paint(PaintSession& session, int32_t imageDirection) const
     {
         if (Is<Staff>())
         {
-            auto loc = GetLocation();
+            auto loc = location;
             switch (Orientation)
             {
                 case 0:
@@ -2887,9 +2879,9 @@ void Peep::Paint(PaintSession& session, int32_t imageDirection) const
 
     auto imageId = ImageId(baseImageId, TshirtColour, TrousersColour);
 
-    auto bb = BoundBoxXYZ{ { 0, 0, z + 5 }, { 1, 1, 11 } };
-    auto offset = CoordsXYZ{ 0, 0, z };
-    PaintAddImageAsParent(session, imageId, { 0, 0, z }, bb);
+    auto bb = BoundBoxXYZ{ { 0, 0, location.z + 5 }, { 1, 1, 11 } };
+    auto offset = CoordsXYZ{ 0, 0, location.z };
+    PaintAddImageAsParent(session, imageId, { 0, 0, location.z }, bb);
 
     auto* guest = As<Guest>();
     if (guest != nullptr)
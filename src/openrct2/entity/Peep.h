@@ -413,7 +413,7 @@ public: // Peep
     [[nodiscard]] CoordsXY GetDestination() const;
 
     void Serialise(class DataSerialiser& stream);
-    void Paint(PaintSession& session, int32_t imageDirection) const;
+    void Paint(PaintSession& session, int32_t imageDirection, const CoordsXYZ& location) const;
 
     // TODO: Make these private again when done refactoring
 public: // Peep
@@ -51,7 +51,9 @@
 #include "../object/ObjectList.h"
 #include "../object/ObjectManager.h"
 #include "../object/ObjectRepository.h"
+#include "../paint/PaintCache.h"
 #include "../platform/Platform.h"
+#include "../profiling/Metrics.h"
 #include "../profiling/Profiling.h"
 #include "../ride/Ride.h"
 #include "../ride/RideData.h"
@@ -1669,10 +1671,13 @@ static int32_t ConsoleCommandReplayStart(InteractiveConsole& console, const argu
                              "  Date Recorded: %s\n"
                              "  Ticks: %u\n"
                              "  Commands: %u\n"
-                             "  Checksums: %u";
+                             "  Checksums: %u\n"
+                             "  Keyframes: %u";
 
-        console.WriteFormatLine(logFmt, info.FilePath.c_str(), recordingDate, info.Ticks, info.NumCommands, info.NumChecksums);
-        Console::WriteLine(logFmt, info.FilePath.c_str(), recordingDate, info.Ticks, info.NumCommands, info.NumChecksums);
+        console.WriteFormatLine(
+            logFmt, info.FilePath.c_str(), recordingDate, info.Ticks, info.NumCommands, info.NumChecksums, info.NumKeyframes);
+        Console::WriteLine(
+            logFmt, info.FilePath.c_str(), recordingDate, info.Ticks, info.NumCommands, info.NumChecksums, info.NumKeyframes);
 
         return 1;
     }
@@ -1698,6 +1703,38 @@ static int32_t ConsoleCommandReplayStop(InteractiveConsole& console, const argum
     return 0;
 }
 
+static int32_t ConsoleCommandReplaySeek(InteractiveConsole& console, const arguments_t& argv)
+{
+    if (NetworkGetMode() != NETWORK_MODE_NONE)
+    {
+        console.WriteFormatLine("This command is currently not supported in multiplayer mode.");
+        return 0;
+    }
+
+    if (argv.size() < 1)
+    {
+        console.WriteFormatLine("Parameters required <tick>");
+        return 0;
+    }
+
+    auto* replayManager = OpenRCT2::GetContext()->GetReplayManager();
+    if (!replayManager->IsReplaying())
+    {
+        console.WriteFormatLine("Replay currently not playing");
+        return 0;
+    }
+
+    const auto tick = static_cast<uint32_t>(atol(argv[0].c_str()));
+    if (replayManager->SeekPlayback(tick))
+    {
+        console.WriteFormatLine("Replay at tick %u", tick);
+        return 1;
+    }
+
+    console.WriteFormatLine("Unable to seek to tick %u", tick);
+    return 0;
+}
+
 static int32_t ConsoleCommandReplayNormalise(InteractiveConsole& console, const arguments_t& argv)
 {
     if (NetworkGetMode() != NETWORK_MODE_NONE)
@@ -1920,6 +1957,65 @@ static int32_t ConsoleCommandProfilerStop(
     return 0;
 }
 
+static int32_t ConsoleCommandMetrics(InteractiveConsole& console, const arguments_t& argv)
+{
+    OpenRCT2::Metrics::Update();
+    for (const auto* metric : OpenRCT2::Metrics::GetAll())
+    {
+        // Optional argument filters metrics by name prefix, e.g. "metrics network."
+        if (argv.size() >= 1 && !String::StartsWith(metric->GetName(), argv[0]))
+            continue;
+
+        console.WriteLine(metric->ToString());
+    }
+    return 0;
+}
+
+static int32_t ConsoleCommandMetricsExport(InteractiveConsole& console, const arguments_t& argv)
+{
+    if (argv.size() < 1)
+    {
+        console.WriteLineError("Missing argument: <file path>");
+        return 1;
+    }
+
+    const auto& jsonFilePath = argv[0];
+    OpenRCT2::Metrics::Update();
+    if (!OpenRCT2::Metrics::ExportJson(jsonFilePath))
+    {
+        console.WriteFormatLine("Unable to export metrics to %s", jsonFilePath.c_str());
+        return 1;
+    }
+
+    console.WriteFormatLine("Wrote metrics file: \"%s\"", jsonFilePath.c_str());
+    return 0;
+}
+
+static int32_t ConsoleCommandPaintCache(InteractiveConsole& console, const arguments_t& argv)
+{
+    using namespace OpenRCT2::PaintCache;
+
+    static constexpr const char* kModeNames[] = { "off", "on", "compare" };
+    if (argv.size() < 1)
+    {
+        console.WriteFormatLine("paint_cache %s", kModeNames[EnumValue(GetMode())]);
+        return 0;
+    }
+
+    for (size_t i = 0; i < std::size(kModeNames); i++)
+    {
+        if (argv[0] == kModeNames[i])
+        {
+            SetMode(static_cast<Mode>(i));
+            console.WriteFormatLine("paint_cache %s", kModeNames[i]);
+            return 0;
+        }
+    }
+
+    console.WriteLineError("Invalid argument, expected off, on or compare");
+    return 1;
+}
+
 static int32_t ConsoleSpawnBalloon(InteractiveConsole& console, const arguments_t& argv)
 {
     if (argv.size() < 3)
@@ -2039,6 +2135,7 @@ static constexpr ConsoleCommand console_command_table[] = {
     { "replay_stoprecord", ConsoleCommandReplayStopRecord, "Stops recording a new replay.", "replay_stoprecord" },
     { "replay_start", ConsoleCommandReplayStart, "Starts a replay", "replay_start <name>" },
     { "replay_stop", ConsoleCommandReplayStop, "Stops the replay", "replay_stop" },
+    { "replay_seek", ConsoleCommandReplaySeek, "Moves the replay to a tick, counted from its start", "replay_seek <tick>" },
     { "replay_normalise", ConsoleCommandReplayNormalise, "Normalises the replay to remove all gaps",
       "replay_normalise <input file> <output file>" },
     { "mp_desync", ConsoleCommandMpDesync, "Forces a multiplayer desync",
@@ -2048,6 +2145,10 @@ static constexpr ConsoleCommand console_command_table[] = {
     { "profiler_stop", ConsoleCommandProfilerStop, "Stops the profiler.", "profiler_stop [<output file>]" },
     { "profiler_exportcsv", ConsoleCommandProfilerExportCSV, "Exports the current profiler data.",
       "profiler_exportcsv <output file>" },
+    { "metrics", ConsoleCommandMetrics, "Lists the current value of all metrics.", "metrics [<name prefix>]" },
+    { "metrics_export", ConsoleCommandMetricsExport, "Exports all metrics as JSON.", "metrics_export <output file>" },
+    { "paint_cache", ConsoleCommandPaintCache, "Turns the paint cache on or off, or compares it with uncached painting.",
+      "paint_cache [off|on|compare]" },
 };
 
 static int32_t ConsoleCommandWindows(InteractiveConsole& console, [[maybe_unused]] const arguments_t& argv)
@@ -21,6 +21,7 @@
 #include "../drawing/Drawing.h"
 #include "../drawing/IDrawingEngine.h"
 #include "../entity/EntityList.h"
+#include "../entity/EntityTweener.h"
 #include "../entity/Guest.h"
 #include "../entity/PatrolArea.h"
 #include "../entity/Staff.h"
@@ -28,6 +29,8 @@
 #include "../object/SmallSceneryEntry.h"
 #include "../object/WallSceneryEntry.h"
 #include "../paint/Paint.h"
+#include "../paint/PaintCache.h"
+#include "../profiling/Metrics.h"
 #include "../profiling/Profiling.h"
 #include "../ride/Ride.h"
 #include "../ride/RideData.h"
@@ -76,6 +79,8 @@ InteractionInfo::InteractionInfo(const PaintStruct* ps)
 
 static void ViewportPaintWeatherGloom(DrawPixelInfo& dpi);
 static void ViewportPaint(const Viewport* viewport, DrawPixelInfo& dpi);
+static void ViewportPaintWorld(const Viewport* viewport, DrawPixelInfo& worldDpi, bool usePaintCache);
+static void ViewportPaintCompareWithCache(const Viewport* viewport, DrawPixelInfo& worldDpi);
 static void ViewportUpdateFollowSprite(WindowBase* window);
 static void ViewportUpdateSmartFollowEntity(WindowBase* window);
 static void ViewportUpdateSmartFollowStaff(WindowBase* window, const Staff& peep);
@@ -289,6 +294,43 @@ void ViewportsInvalidate(const ScreenRect& screenRect, ZoomLevel maxZoom)
     }
 }
 
+std::vector<MapRange> ViewportsGetVisibleMapRanges(ZoomLevel maxZoom)
+{
+    // Tiles are invalidated up to 32 pixels around their position, see ViewportsInvalidate.
+    constexpr int32_t kMargin = 32;
+    constexpr int32_t kMaxHeight = MAX_ELEMENT_HEIGHT * kCoordsZStep;
+
+    std::vector<MapRange> ranges;
+    for (const auto& vp : _viewports)
+    {
+        if (maxZoom != ZoomLevel{ -1 } && vp.zoom > maxZoom)
+            continue;
+
+        const ScreenCoordsXY corners[] = {
+            { vp.viewPos.x - kMargin, vp.viewPos.y - kMargin },
+            { vp.viewPos.x + vp.ViewWidth() + kMargin, vp.viewPos.y - kMargin },
+            { vp.viewPos.x - kMargin, vp.viewPos.y + vp.ViewHeight() + kMargin },
+            { vp.viewPos.x + vp.ViewWidth() + kMargin, vp.viewPos.y + vp.ViewHeight() + kMargin },
+        };
+
+        // A tile shows higher up on the screen the higher its elements are, so take the corners at both the lowest
+        // and the highest height.
+        CoordsXY mins{ std::numeric_limits<int32_t>::max(), std::numeric_limits<int32_t>::max() };
+        CoordsXY maxs{ std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::min() };
+        for (const auto& corner : corners)
+        {
+            for (int32_t z : { 0, kMaxHeight })
+            {
+                const auto mapPos = ViewportPosToMapPos(corner, z, vp.rotation);
+                mins = { std::min(mins.x, mapPos.x), std::min(mins.y, mapPos.y) };
+                maxs = { std::max(maxs.x, mapPos.x), std::max(maxs.y, mapPos.y) };
+            }
+        }
+        ranges.emplace_back(mins.x - kCoordsXYStep, mins.y - kCoordsXYStep, maxs.x, maxs.y);
+    }
+    return ranges;
+}
+
 /**
  *
  *  rct2: 0x00689174
@@ -710,7 +752,8 @@ void ViewportUpdateFollowSprite(WindowBase* window)
             ViewportSetUndergroundFlag(underground, window, window->viewport);
         }
 
-        auto centreLoc = centre_2d_coordinates(sprite->GetLocation(), window->viewport);
+        // Follow the entity where it is drawn, which differs from its location while it is being interpolated.
+        auto centreLoc = centre_2d_coordinates(EntityTweener::Get().GetPaintLocation(*sprite), window->viewport);
         if (centreLoc.has_value())
         {
             window->savedViewPos = *centreLoc;
@@ -935,8 +978,12 @@ static void ViewportFillColumn(PaintSession& session)
 {
     PROFILED_FUNCTION();
 
+    static auto& paintStructsMetric = Metrics::GetCounter("paint.structs");
+
     PaintSessionGenerate(session);
     PaintSessionArrange(session);
+
+    paintStructsMetric.Add(session.PaintEntryChain.GetCount());
 }
 
 static void ViewportPaintColumn(PaintSession& session)
@@ -1001,6 +1048,26 @@ static void ViewportPaint(const Viewport* viewport, DrawPixelInfo& dpi)
     worldDpi.pitch = dpi.LineStride() - worldDpi.width;
     worldDpi.zoom_level = viewport->zoom;
 
+    PaintCache::Trim();
+    const bool usePaintCache = PaintCache::IsUsable(viewport->flags);
+
+    // Only the software drawing engines draw into the pixels of the DPI.
+    const bool canComparePixels = dpi.DrawingEngine != nullptr
+        && (dpi.DrawingEngine->GetFlags() & DEF_DIRTY_OPTIMISATIONS);
+    if (usePaintCache && PaintCache::GetMode() == PaintCache::Mode::Compare && canComparePixels)
+    {
+        ViewportPaintCompareWithCache(viewport, worldDpi);
+    }
+    else
+    {
+        ViewportPaintWorld(viewport, worldDpi, usePaintCache);
+    }
+}
+
+static void ViewportPaintWorld(const Viewport* viewport, DrawPixelInfo& worldDpi, bool usePaintCache)
+{
+    PROFILED_FUNCTION();
+
     _paintColumns.clear();
 
     bool useMultithreading = Config::Get().general.MultiThreading;
@@ -1014,7 +1081,7 @@ static void ViewportPaint(const Viewport* viewport, DrawPixelInfo& dpi)
     }
 
     bool useParallelDrawing = false;
-    if (useMultithreading && (dpi.DrawingEngine->GetFlags() & DEF_PARALLEL_DRAWING))
+    if (useMultithreading && (worldDpi.DrawingEngine->GetFlags() & DEF_PARALLEL_DRAWING))
     {
         useParallelDrawing = true;
     }
@@ -1027,6 +1094,7 @@ static void ViewportPaint(const Viewport* viewport, DrawPixelInfo& dpi)
     for (int32_t x = alignedX; x < rightBorder; x += columnWidth)
     {
         PaintSession* session = PaintSessionAlloc(worldDpi, viewport->flags, viewport->rotation);
+        session->UsePaintCache = usePaintCache;
         _paintColumns.push_back(session);
 
         DrawPixelInfo& columnDpi = session->DPI;
@@ -1087,6 +1155,54 @@ static void ViewportPaint(const Viewport* viewport, DrawPixelInfo& dpi)
     }
 }
 
+static std::vector<uint8_t> ViewportCopyPixels(const DrawPixelInfo& dpi)
+{
+    std::vector<uint8_t> pixels(static_cast<size_t>(dpi.width) * dpi.height);
+    for (int32_t y = 0; y < dpi.height; y++)
+    {
+        std::memcpy(pixels.data() + static_cast<size_t>(y) * dpi.width, dpi.bits + y * dpi.LineStride(), dpi.width);
+    }
+    return pixels;
+}
+
+static void ViewportRestorePixels(DrawPixelInfo& dpi, const std::vector<uint8_t>& pixels)
+{
+    for (int32_t y = 0; y < dpi.height; y++)
+    {
+        std::memcpy(dpi.bits + y * dpi.LineStride(), pixels.data() + static_cast<size_t>(y) * dpi.width, dpi.width);
+    }
+}
+
+/**
+ * Paints the viewport without and then with the paint cache, both on top of the same background,
+ * and reports how many pixels differ between the two.
+ */
+static void ViewportPaintCompareWithCache(const Viewport* viewport, DrawPixelInfo& worldDpi)
+{
+    if (worldDpi.width <= 0 || worldDpi.height <= 0)
+        return;
+
+    const auto background = ViewportCopyPixels(worldDpi);
+    ViewportPaintWorld(viewport, worldDpi, false);
+    const auto reference = ViewportCopyPixels(worldDpi);
+
+    ViewportRestorePixels(worldDpi, background);
+    ViewportPaintWorld(viewport, worldDpi, true);
+
+    size_t differingPixels = 0;
+    for (int32_t y = 0; y < worldDpi.height; y++)
+    {
+        const auto* row = worldDpi.bits + y * worldDpi.LineStride();
+        const auto* referenceRow = reference.data() + static_cast<size_t>(y) * worldDpi.width;
+        for (int32_t x = 0; x < worldDpi.width; x++)
+        {
+            if (row[x] != referenceRow[x])
+                differingPixels++;
+        }
+    }
+    PaintCache::ReportComparison(differingPixels, reference.size());
+}
+
 static void ViewportPaintWeatherGloom(DrawPixelInfo& dpi)
 {
     auto paletteId = ClimateGetWeatherGloomPaletteId(GetGameState().ClimateCurrent);
@@ -136,6 +136,8 @@ void ViewportRemove(Viewport* viewport);
 void ViewportsInvalidate(int32_t x, int32_t y, int32_t z0, int32_t z1, ZoomLevel maxZoom);
 void ViewportsInvalidate(const CoordsXYZ& pos, int32_t width, int32_t minHeight, int32_t maxHeight, ZoomLevel maxZoom);
 void ViewportsInvalidate(const ScreenRect& screenRect, ZoomLevel maxZoom = ZoomLevel{ -1 });
+// Returns, for each viewport zoomed in at least as far as maxZoom, a map range containing every tile it can show.
+std::vector<MapRange> ViewportsGetVisibleMapRanges(ZoomLevel maxZoom);
 void ViewportUpdatePosition(WindowBase* window);
 void ViewportUpdateSmartFollowGuest(WindowBase* window, const Guest& peep);
 void ViewportRotateSingle(WindowBase* window, int32_t direction);
@@ -15,14 +15,15 @@
 #include "../core/Memory.hpp"
 #include "../core/RTL.h"
 #include "../core/String.hpp"
-#include "../core/StringBuilder.h"
-#include "../core/StringReader.h"
 #include "Language.h"
 #include "LocalisationService.h"
 #include "StringIds.h"
 
+#include <deque>
+#include <limits>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 using namespace OpenRCT2;
@@ -43,8 +44,17 @@ struct ScenarioOverride
 class LanguagePack final : public ILanguagePack
 {
 private:
+    static constexpr uint32_t kNoString = std::numeric_limits<uint32_t>::max();
+    // Marks the offsets that refer to a string in _ownStrings instead of _text.
+    static constexpr uint32_t kOwnString = 0x80000000;
+
     uint16_t const _id;
-    std::vector<std::string> _strings;
+    // The language file, with the end of each string replaced by a NUL so that strings are used from it in place.
+    std::string _text;
+    // The offset of each string in _text, or kNoString.
+    std::vector<uint32_t> _stringOffsets;
+    // The strings that are not in the language file as they are, i.e. set strings and right-to-left strings.
+    std::deque<std::string> _ownStrings;
     std::vector<ScenarioOverride> _scenarioOverrides;
 
     ///////////////////////////////////////////////////////////////////////////
@@ -80,23 +90,30 @@ public:
             return nullptr;
         }
 
-        return FromText(id, fileData.data());
+        return std::make_unique<LanguagePack>(id, std::move(fileData));
     }
 
     static std::unique_ptr<LanguagePack> FromText(uint16_t id, const utf8* text)
     {
-        return std::make_unique<LanguagePack>(id, text);
+        Guard::ArgumentNotNull(text);
+        return std::make_unique<LanguagePack>(id, u8string(text));
     }
 
-    LanguagePack(uint16_t id, const utf8* text)
+    LanguagePack(uint16_t id, u8string&& text)
         : _id(id)
+        , _text(std::move(text))
     {
-        Guard::ArgumentNotNull(text);
-
-        auto reader = UTF8StringReader(text);
-        while (reader.CanRead())
+        // Only index the strings, they are read from the text when they are used.
+        size_t lineStart = String::SkipBOM(_text.c_str()) - _text.c_str();
+        while (lineStart < _text.size())
         {
-            ParseLine(&reader);
+            auto lineEnd = _text.find_first_of("\r\n", lineStart);
+            if (lineEnd == std::string::npos)
+            {
+                lineEnd = _text.size();
+            }
+            ParseLine(lineStart, lineEnd);
+            lineStart = lineEnd + 1;
         }
 
         // Clean up the parsing work data
@@ -111,22 +128,22 @@ public:
 
     uint32_t GetCount() const override
     {
-        return static_cast<uint32_t>(_strings.size());
+        return static_cast<uint32_t>(_stringOffsets.size());
     }
 
     void RemoveString(StringId stringId) override
     {
-        if (_strings.size() > static_cast<size_t>(stringId))
+        if (_stringOffsets.size() > static_cast<size_t>(stringId))
         {
-            _strings[stringId].clear();
+            _stringOffsets[stringId] = kNoString;
         }
     }
 
     void SetString(StringId stringId, const std::string& str) override
     {
-        if (_strings.size() > static_cast<size_t>(stringId))
+        if (_stringOffsets.size() > static_cast<size_t>(stringId))
         {
-            _strings[stringId] = str;
+            _stringOffsets[stringId] = AddOwnString(std::string(str));
         }
     }
 
@@ -147,9 +164,20 @@ public:
             return nullptr;
         }
 
-        if ((_strings.size() > static_cast<size_t>(stringId)) && !_strings[stringId].empty())
+        if (_stringOffsets.size() > static_cast<size_t>(stringId))
         {
-            return _strings[stringId].c_str();
+            const auto offset = _stringOffsets[stringId];
+            if (offset == kNoString)
+            {
+                return nullptr;
+            }
+
+            const utf8* result = (offset & kOwnString) != 0 ? _ownStrings[offset & ~kOwnString].c_str()
+                                                            : _text.c_str() + offset;
+            if (*result != '\0')
+            {
+                return result;
+            }
         }
 
         return nullptr;
@@ -190,6 +218,12 @@ private:
         return nullptr;
     }
 
+    uint32_t AddOwnString(std::string&& str)
+    {
+        _ownStrings.push_back(std::move(str));
+        return static_cast<uint32_t>(_ownStrings.size() - 1) | kOwnString;
+    }
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Parsing
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -205,144 +239,58 @@ private:
     // the beginning of a line to leave a comment.
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-    static bool IsWhitespace(codepoint_t codepoint)
-    {
-        return codepoint == '\t' || codepoint == ' ' || codepoint == '\r' || codepoint == '\n';
-    }
-
-    static bool IsNewLine(codepoint_t codepoint)
+    static bool IsWhitespace(char c)
     {
-        return codepoint == '\r' || codepoint == '\n';
+        return c == '\t' || c == ' ';
     }
 
-    static void SkipWhitespace(IStringReader* reader)
+    size_t SkipWhitespace(size_t position, size_t lineEnd) const
     {
-        codepoint_t codepoint;
-        while (reader->TryPeek(&codepoint))
+        while (position < lineEnd && IsWhitespace(_text[position]))
         {
-            if (IsWhitespace(codepoint))
-            {
-                reader->Skip();
-            }
-            else
-            {
-                break;
-            }
+            position++;
         }
+        return position;
     }
 
-    static void SkipNewLine(IStringReader* reader)
+    void ParseLine(size_t lineStart, size_t lineEnd)
     {
-        codepoint_t codepoint;
-        while (reader->TryPeek(&codepoint))
-        {
-            if (IsNewLine(codepoint))
-            {
-                reader->Skip();
-            }
-            else
-            {
-                break;
-            }
-        }
-    }
-
-    static void SkipToEndOfLine(IStringReader* reader)
-    {
-        codepoint_t codepoint;
-        while (reader->TryPeek(&codepoint))
-        {
-            if (codepoint != '\r' && codepoint != '\n')
-            {
-                reader->Skip();
-            }
-            else
-            {
-                break;
-            }
-        }
-    }
-
-    void ParseLine(IStringReader* reader)
-    {
-        SkipWhitespace(reader);
-
-        codepoint_t codepoint;
-        if (reader->TryPeek(&codepoint))
+        const auto position = SkipWhitespace(lineStart, lineEnd);
+        if (position < lineEnd)
         {
-            switch (codepoint)
+            switch (_text[position])
             {
                 case '#':
-                    SkipToEndOfLine(reader);
                     break;
                 case '[':
-                    ParseGroupObject(reader);
+                    ParseGroupObject();
                     break;
                 case '<':
-                    ParseGroupScenario(reader);
-                    break;
-                case '\r':
-                case '\n':
+                    ParseGroupScenario(position, lineEnd);
                     break;
                 default:
-                    ParseString(reader);
+                    ParseString(position, lineEnd);
                     break;
             }
-            SkipToEndOfLine(reader);
-            SkipNewLine(reader);
         }
     }
 
-    void ParseGroupObject(IStringReader* reader)
+    void ParseGroupObject()
     {
         // THIS IS NO LONGER USED SO WE ARE JUST SKIPPING OVER
-        codepoint_t codepoint;
-
-        // Should have already deduced that the next codepoint is a [
-        reader->Skip();
-
-        // Read string up to ] or line end
-        while (reader->TryPeek(&codepoint))
-        {
-            if (IsNewLine(codepoint))
-                break;
-
-            reader->Skip();
-            if (codepoint == ']')
-            {
-                break;
-            }
-        }
         _currentGroup.clear();
     }
 
-    void ParseGroupScenario(IStringReader* reader)
+    void ParseGroupScenario(size_t position, size_t lineEnd)
     {
-        auto sb = StringBuilder();
-        codepoint_t codepoint;
-
-        // Should have already deduced that the next codepoint is a <
-        reader->Skip();
+        // Should have already deduced that the next character is a <
+        const auto nameStart = position + 1;
 
         // Read string up to > or line end
-        bool closedCorrectly = false;
-        while (reader->TryPeek(&codepoint))
-        {
-            if (IsNewLine(codepoint))
-                break;
-
-            reader->Skip();
-            if (codepoint == '>')
-            {
-                closedCorrectly = true;
-                break;
-            }
-            sb.Append(codepoint);
-        }
-
-        if (closedCorrectly)
+        const auto nameLength = std::string_view(_text).substr(nameStart, lineEnd - nameStart).find('>');
+        if (nameLength != std::string_view::npos)
         {
-            _currentGroup = sb.GetStdString();
+            _currentGroup = _text.substr(nameStart, nameLength);
             _currentScenarioOverride = GetScenarioOverride(_currentGroup);
             if (_currentScenarioOverride == nullptr)
             {
@@ -353,53 +301,36 @@ private:
 
                 _scenarioOverrides.emplace_back();
                 _currentScenarioOverride = &_scenarioOverrides[_scenarioOverrides.size() - 1];
-                _currentScenarioOverride->filename = std::string(sb.GetBuffer());
+                _currentScenarioOverride->filename = _currentGroup;
             }
         }
     }
 
-    void ParseString(IStringReader* reader)
+    void ParseString(size_t position, size_t lineEnd)
     {
-        auto sb = StringBuilder();
-        codepoint_t codepoint;
-
         // Parse string identifier
-        while (reader->TryPeek(&codepoint))
+        const auto identifierStart = position;
+        while (position < lineEnd && !IsWhitespace(_text[position]) && _text[position] != ':')
         {
-            if (IsNewLine(codepoint))
-            {
-                // Unexpected new line, ignore line entirely
-                return;
-            }
-
-            if (!IsWhitespace(codepoint) && codepoint != ':')
-            {
-                reader->Skip();
-                sb.Append(codepoint);
-            }
-            else
-            {
-                break;
-            }
+            position++;
         }
+        const auto identifier = _text.substr(identifierStart, position - identifierStart);
 
-        SkipWhitespace(reader);
+        position = SkipWhitespace(position, lineEnd);
 
         // Parse a colon
-        if (!reader->TryPeek(&codepoint) || codepoint != ':')
+        if (position >= lineEnd || _text[position] != ':')
         {
             // Expected a colon, ignore line entirely
             return;
         }
-        reader->Skip();
+        position++;
 
         // Validate identifier
-        const utf8* identifier = sb.GetBuffer();
-
         int32_t stringId;
         if (_currentGroup.empty())
         {
-            if (sscanf(identifier, "STR_%4d", &stringId) != 1)
+            if (sscanf(identifier.c_str(), "STR_%4d", &stringId) != 1)
             {
                 // Ignore line entirely
                 return;
@@ -407,28 +338,28 @@ private:
         }
         else
         {
-            if (String::Equals(identifier, "STR_NAME"))
+            if (identifier == "STR_NAME")
             {
                 stringId = 0;
             }
-            else if (String::Equals(identifier, "STR_DESC"))
+            else if (identifier == "STR_DESC")
             {
                 stringId = 1;
             }
-            else if (String::Equals(identifier, "STR_CPTY"))
+            else if (identifier == "STR_CPTY")
             {
                 stringId = 2;
             }
 
-            else if (String::Equals(identifier, "STR_SCNR"))
+            else if (identifier == "STR_SCNR")
             {
                 stringId = 0;
             }
-            else if (String::Equals(identifier, "STR_PARK"))
+            else if (identifier == "STR_PARK")
             {
                 stringId = 1;
             }
-            else if (String::Equals(identifier, "STR_DTLS"))
+            else if (identifier == "STR_DTLS")
             {
                 stringId = 2;
             }
@@ -440,38 +371,35 @@ private:
         }
 
         // Rest of the line is the actual string
-        sb.Clear();
-        while (reader->TryPeek(&codepoint) && !IsNewLine(codepoint))
-        {
-            reader->Skip();
-            sb.Append(codepoint);
-        }
-
-        std::string s;
-        if (LanguagesDescriptors[_id].isRtl)
-        {
-            auto ts = std::string(sb.GetBuffer(), sb.GetLength());
-            s = FixRTL(ts);
-        }
-        else
-        {
-            s = std::string(sb.GetBuffer(), sb.GetLength());
-        }
-
         if (_currentGroup.empty())
         {
             // Make sure the list is big enough to contain this string id
-            if (static_cast<size_t>(stringId) >= _strings.size())
+            if (static_cast<size_t>(stringId) >= _stringOffsets.size())
+            {
+                _stringOffsets.resize(stringId + 1, kNoString);
+            }
+
+            if (LanguagesDescriptors[_id].isRtl)
             {
-                _strings.resize(stringId + 1);
+                auto s = _text.substr(position, lineEnd - position);
+                _stringOffsets[stringId] = AddOwnString(FixRTL(s));
+            }
+            else
+            {
+                // End the string where the line ends, so that it can be used in place.
+                if (lineEnd < _text.size())
+                {
+                    _text[lineEnd] = '\0';
+                }
+                _stringOffsets[stringId] = static_cast<uint32_t>(position);
             }
-            _strings[stringId] = s;
         }
         else
         {
             if (_currentScenarioOverride != nullptr)
             {
-                _currentScenarioOverride->strings[stringId] = std::move(s);
+                auto s = _text.substr(position, lineEnd - position);
+                _currentScenarioOverride->strings[stringId] = LanguagesDescriptors[_id].isRtl ? FixRTL(s) : std::move(s);
             }
         }
     }
@@ -14,6 +14,7 @@
 #    include "../core/String.hpp"
 #    include "../localisation/Formatting.h"
 #    include "../platform/Platform.h"
+#    include "../profiling/Metrics.h"
 #    include "Socket.h"
 #    include "network.h"
 
@@ -208,11 +209,43 @@ void NetworkConnection::SetLastDisconnectReason(const StringId string_id, void*
     SetLastDisconnectReason(buffer);
 }
 
+// Indexed by NetworkCommand, used to name the per command traffic metrics.
+// clang-format off
+static constexpr std::string_view kNetworkCommandNames[] = {
+    "auth", "map", "chat", "unused", "tick", "player_list", "ping", "ping_list", "disconnect", "game_info", "show_error",
+    "group_list", "event", "token", "objects_list", "map_request", "game_action", "player_info", "request_game_state",
+    "game_state", "scripts_header", "scripts_data", "heartbeat",
+};
+// clang-format on
+static_assert(std::size(kNetworkCommandNames) == EnumValue(NetworkCommand::Max));
+
+static Metrics::Counter& GetPacketBytesMetric(NetworkCommand command, bool sending)
+{
+    using MetricTable = std::array<Metrics::Counter*, std::size(kNetworkCommandNames) + 1>;
+    auto createTable = [](std::string_view direction) {
+        MetricTable table{};
+        for (size_t i = 0; i < std::size(kNetworkCommandNames); i++)
+        {
+            table[i] = &Metrics::GetCounter(String::StdFormat(
+                "network.%s.%s", std::string(direction).c_str(), std::string(kNetworkCommandNames[i]).c_str()));
+        }
+        table.back() = &Metrics::GetCounter(String::StdFormat("network.%s.unknown", std::string(direction).c_str()));
+        return table;
+    };
+    static const MetricTable bytesSent = createTable("bytes_out");
+    static const MetricTable bytesReceived = createTable("bytes_in");
+
+    const auto index = std::min<size_t>(EnumValue(command), std::size(kNetworkCommandNames));
+    return sending ? *bytesSent[index] : *bytesReceived[index];
+}
+
 void NetworkConnection::RecordPacketStats(const NetworkPacket& packet, bool sending)
 {
     uint32_t packetSize = static_cast<uint32_t>(packet.BytesTransferred);
     NetworkStatisticsGroup trafficGroup;
 
+    GetPacketBytesMetric(packet.GetCommand(), sending).Add(packetSize);
+
     switch (packet.GetCommand())
     {
         case NetworkCommand::GameAction:
@@ -19,18 +19,88 @@
 #include "../core/Json.hpp"
 #include "../core/Path.hpp"
 #include "../core/String.hpp"
+#include "../drawing/ImageImportCache.h"
 #include "../drawing/ImageImporter.h"
+#include "../profiling/Metrics.h"
 #include "../sprites.h"
 #include "Object.h"
+#include "ObjectBundle.h"
 #include "ObjectFactory.h"
 
+#include <future>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <stdexcept>
+#include <unordered_map>
 
 using namespace OpenRCT2;
 using namespace OpenRCT2::Drawing;
 
-static thread_local std::map<u8string, std::unique_ptr<Object>> _objDataCache = {};
+/**
+ * Legacy objects whose images are used by other objects, shared by all threads loading objects so that each one is
+ * only read once. The least recently used objects are released when their images take up too much memory.
+ */
+struct LegacyObjectCacheEntry
+{
+    std::shared_future<std::shared_ptr<const Object>> LoadedObject;
+    size_t Size{};
+    uint64_t LastUsed{};
+    bool Loaded{};
+};
+
+static constexpr size_t kLegacyObjectCacheMaxSize = 64 * 1024 * 1024;
+
+static std::mutex _legacyObjectCacheMutex;
+static std::unordered_map<u8string, LegacyObjectCacheEntry> _legacyObjectCache;
+static size_t _legacyObjectCacheSize;
+static uint64_t _legacyObjectCacheUseCounter;
+
+// Every legacy object file in the RCT2 objects directory by upper case file name, to find objects with a different case.
+static std::once_flag _legacyObjectIndexFlag;
+static std::unordered_map<u8string, u8string> _legacyObjectIndex;
+
+static size_t GetImageDataSize(const Object& obj)
+{
+    const auto& imageTable = obj.GetImageTable();
+    const auto* images = imageTable.GetImages();
+    size_t size = 0;
+    for (uint32_t i = 0; i < imageTable.GetCount(); i++)
+    {
+        size += sizeof(G1Element) + G1CalculateDataSize(&images[i]);
+    }
+    return size;
+}
+
+static void UpdateLegacyObjectCacheMetrics()
+{
+    static auto& cachedObjects = Metrics::GetGauge("objects.legacy_cache.objects");
+    static auto& cachedBytes = Metrics::GetGauge("objects.legacy_cache.bytes");
+    cachedObjects.Set(static_cast<double>(_legacyObjectCache.size()));
+    cachedBytes.Set(static_cast<double>(_legacyObjectCacheSize));
+}
+
+// Releases the least recently used objects until the cache fits, keeping the one that was used last.
+static void TrimLegacyObjectCache()
+{
+    while (_legacyObjectCacheSize > kLegacyObjectCacheMaxSize)
+    {
+        auto oldest = _legacyObjectCache.end();
+        for (auto it = _legacyObjectCache.begin(); it != _legacyObjectCache.end(); it++)
+        {
+            if (it->second.Loaded && it->second.LastUsed != _legacyObjectCacheUseCounter
+                && (oldest == _legacyObjectCache.end() || it->second.LastUsed < oldest->second.LastUsed))
+            {
+                oldest = it;
+            }
+        }
+        if (oldest == _legacyObjectCache.end())
+            break;
+
+        _legacyObjectCacheSize -= oldest->second.Size;
+        _legacyObjectCache.erase(oldest);
+    }
+}
 
 struct ImageTable::RequiredImage
 {
@@ -82,6 +152,34 @@ struct ImageTable::RequiredImage
     }
 };
 
+struct ImageTable::ImageSource
+{
+    std::string Path;
+    std::vector<uint8_t> Data;
+    IMAGE_FORMAT Format{};
+    std::optional<Image> DecodedImage;
+    std::unique_ptr<ImageImportCache> Cache;
+
+    const Image& GetImage()
+    {
+        if (!DecodedImage.has_value())
+        {
+            DecodedImage = Imaging::ReadFromBuffer(Data, Format);
+        }
+        return *DecodedImage;
+    }
+};
+
+static u8string GetImageImportCacheDirectory()
+{
+    auto* context = GetContext();
+    if (context == nullptr)
+        return {};
+
+    const auto env = context->GetPlatformEnvironment();
+    return Path::Combine(env->GetDirectoryPath(DIRBASE::CACHE), u8"images");
+}
+
 std::vector<std::unique_ptr<ImageTable::RequiredImage>> ImageTable::ParseImages(IReadObjectContext* context, std::string s)
 {
     std::vector<std::unique_ptr<RequiredImage>> result;
@@ -160,13 +258,21 @@ std::vector<std::unique_ptr<ImageTable::RequiredImage>> ImageTable::ParseImages(
         try
         {
             auto imageData = context->GetData(s);
-            auto image = Imaging::ReadFromBuffer(imageData);
-            auto meta = ImageImportMeta{};
+            ImageImportCache cache(GetImageImportCacheDirectory(), imageData, IMAGE_FORMAT::AUTOMATIC);
+            const auto meta = ImageImportMeta{};
 
-            ImageImporter importer;
-            auto importResult = importer.Import(image, meta);
+            const auto* importResult = cache.Find(meta);
+            if (importResult == nullptr)
+            {
+                auto image = Imaging::ReadFromBuffer(imageData);
+                auto importMeta = meta;
+
+                ImageImporter importer;
+                importResult = &cache.Add(meta, importer.Import(image, importMeta));
+                cache.Save();
+            }
 
-            result.push_back(std::make_unique<RequiredImage>(importResult.Element));
+            result.push_back(std::make_unique<RequiredImage>(importResult->Element));
         }
         catch (const std::exception& e)
         {
@@ -179,29 +285,34 @@ std::vector<std::unique_ptr<ImageTable::RequiredImage>> ImageTable::ParseImages(
 }
 
 std::vector<std::unique_ptr<ImageTable::RequiredImage>> ImageTable::ParseImages(
-    IReadObjectContext* context, std::vector<std::pair<std::string, Image>>& imageSources, json_t& el)
+    IReadObjectContext* context, std::vector<ImageSource>& imageSources, json_t& el)
 {
     Guard::Assert(el.is_object(), "ImageTable::ParseImages expects parameter el to be object");
 
     auto path = Json::GetString(el["path"]);
-    auto meta = createImageImportMetaFromJson(el);
+    const auto meta = createImageImportMetaFromJson(el);
 
     std::vector<std::unique_ptr<RequiredImage>> result;
     try
     {
         auto itSource = std::find_if(
-            imageSources.begin(), imageSources.end(),
-            [&path](const std::pair<std::string, Image>& item) { return item.first == path; });
+            imageSources.begin(), imageSources.end(), [&path](const ImageSource& item) { return item.Path == path; });
         if (itSource == imageSources.end())
         {
             throw std::runtime_error("Unable to find image in image source list.");
         }
-        auto& image = itSource->second;
+        auto& source = *itSource;
+
+        const auto* importResult = source.Cache->Find(meta);
+        if (importResult == nullptr)
+        {
+            // Import modifies the meta, the cache is keyed by the meta as given in the JSON.
+            auto importMeta = meta;
 
-        ImageImporter importer;
-        auto importResult = importer.Import(image, meta);
-        auto g1element = importResult.Element;
-        result.push_back(std::make_unique<RequiredImage>(g1element));
+            ImageImporter importer;
+            importResult = &source.Cache->Add(meta, importer.Import(source.GetImage(), importMeta));
+        }
+        result.push_back(std::make_unique<RequiredImage>(importResult->Element));
     }
     catch (const std::exception& e)
     {
@@ -267,29 +378,73 @@ std::vector<std::unique_ptr<ImageTable::RequiredImage>> ImageTable::LoadImageArc
     return result;
 }
 
-std::vector<std::unique_ptr<ImageTable::RequiredImage>> ImageTable::LoadObjectImages(
-    IReadObjectContext* context, const std::string& name, const std::vector<int32_t>& range)
+std::shared_ptr<const Object> ImageTable::GetLegacyObject(IReadObjectContext* context, const std::string& name)
 {
-    std::vector<std::unique_ptr<RequiredImage>> result;
-    Object* obj;
+    static auto& hits = Metrics::GetCounter("objects.legacy_cache.hits");
+    static auto& loads = Metrics::GetCounter("objects.legacy_cache.loads");
 
-    auto cached = _objDataCache.find(name);
-    if (cached != _objDataCache.end())
+    const auto key = String::ToUpper(name);
+    std::promise<std::shared_ptr<const Object>> promise;
+    std::shared_future<std::shared_ptr<const Object>> cached;
     {
-        obj = cached->second.get();
+        std::scoped_lock lock(_legacyObjectCacheMutex);
+        auto it = _legacyObjectCache.find(key);
+        if (it != _legacyObjectCache.end())
+        {
+            it->second.LastUsed = ++_legacyObjectCacheUseCounter;
+            cached = it->second.LoadedObject;
+        }
+        else
+        {
+            auto& entry = _legacyObjectCache[key];
+            entry.LoadedObject = promise.get_future().share();
+            entry.LastUsed = ++_legacyObjectCacheUseCounter;
+        }
     }
-    else
+    if (cached.valid())
+    {
+        // Another thread may still be reading the object, wait for it without holding the lock.
+        hits.Add();
+        return cached.get();
+    }
+
+    loads.Add();
+    std::shared_ptr<const Object> obj;
+    try
     {
         auto objectPath = FindLegacyObject(name);
-        auto tmp = ObjectFactory::CreateObjectFromLegacyFile(
+        obj = ObjectFactory::CreateObjectFromLegacyFile(
             context->GetObjectRepository(), objectPath.c_str(), !gOpenRCT2NoGraphics);
-        auto inserted = _objDataCache.insert({ name, std::move(tmp) });
-        obj = inserted.first->second.get();
     }
+    catch (const std::exception& e)
+    {
+        LOG_ERROR("Unable to read legacy object '%s': %s", name.c_str(), e.what());
+    }
+    promise.set_value(obj);
+
+    std::scoped_lock lock(_legacyObjectCacheMutex);
+    auto it = _legacyObjectCache.find(key);
+    if (it != _legacyObjectCache.end())
+    {
+        it->second.Size = obj != nullptr ? GetImageDataSize(*obj) : 0;
+        it->second.Loaded = true;
+        _legacyObjectCacheSize += it->second.Size;
+        TrimLegacyObjectCache();
+    }
+    UpdateLegacyObjectCacheMetrics();
+    return obj;
+}
+
+std::vector<std::unique_ptr<ImageTable::RequiredImage>> ImageTable::LoadObjectImages(
+    IReadObjectContext* context, const std::string& name, const std::vector<int32_t>& range)
+{
+    std::vector<std::unique_ptr<RequiredImage>> result;
+    auto objHolder = GetLegacyObject(context, name);
+    const auto* obj = objHolder.get();
 
     if (obj != nullptr)
     {
-        auto& imgTable = static_cast<const Object*>(obj)->GetImageTable();
+        auto& imgTable = obj->GetImageTable();
         auto numImages = static_cast<int32_t>(imgTable.GetCount());
         auto images = imgTable.GetImages();
         size_t placeHoldersAdded = 0;
@@ -383,19 +538,24 @@ std::string ImageTable::FindLegacyObject(const std::string& name)
         return objectPath;
     }
 
-    if (!File::Exists(objectPath))
-    {
-        // Search recursively for any file with the target name (case insensitive)
+    // Look for any file with the target name (case insensitive) in the objects directory and its subdirectories.
+    // The directory is only scanned once, the first file found with a name is used.
+    std::call_once(_legacyObjectIndexFlag, [&objectsPath]() {
         auto filter = Path::Combine(objectsPath, u8"*.dat;*.pob");
         auto scanner = Path::ScanDirectory(filter, true);
         while (scanner->Next())
         {
-            auto currentName = Path::GetFileName(scanner->GetPathRelative());
-            if (String::IEquals(currentName, name) || String::IEquals(currentName, altName))
-            {
-                objectPath = scanner->GetPath();
-                break;
-            }
+            auto currentName = String::ToUpper(Path::GetFileName(scanner->GetPathRelative()));
+            _legacyObjectIndex.emplace(std::move(currentName), scanner->GetPath());
+        }
+    });
+
+    for (const auto& candidate : { name, altName })
+    {
+        auto it = _legacyObjectIndex.find(String::ToUpper(candidate));
+        if (it != _legacyObjectIndex.end())
+        {
+            return it->second;
         }
     }
     return objectPath;
@@ -481,25 +641,33 @@ void ImageTable::Read(IReadObjectContext* context, OpenRCT2::IStream* stream)
     }
 }
 
-std::vector<std::pair<std::string, Image>> ImageTable::GetImageSources(IReadObjectContext* context, json_t& jsonImages)
+std::vector<ImageTable::ImageSource> ImageTable::GetImageSources(IReadObjectContext* context, json_t& jsonImages)
 {
-    std::vector<std::pair<std::string, Image>> result;
+    const auto cacheDirectory = GetImageImportCacheDirectory();
+
+    std::vector<ImageSource> result;
     for (auto& jsonImage : jsonImages)
     {
         if (jsonImage.is_object() && jsonImage.contains("path"))
         {
             auto path = Json::GetString(jsonImage["path"]);
             auto keepPalette = Json::GetString(jsonImage["palette"]) == "keep";
-            auto itSource = std::find_if(result.begin(), result.end(), [&path](const std::pair<std::string, Image>& item) {
-                return item.first == path;
-            });
+            auto itSource = std::find_if(
+                result.begin(), result.end(), [&path](const ImageSource& item) { return item.Path == path; });
             if (itSource == result.end())
             {
-                auto imageData = context->GetData(path);
-                auto imageFormat = keepPalette ? IMAGE_FORMAT::PNG : IMAGE_FORMAT::PNG_32;
-                auto image = Imaging::ReadFromBuffer(imageData, imageFormat);
-                auto pair = std::make_pair<std::string, Image>(std::move(path), std::move(image));
-                result.push_back(std::move(pair));
+                auto& source = result.emplace_back();
+                source.Path = std::move(path);
+                source.Data = context->GetData(source.Path);
+                source.Format = keepPalette ? IMAGE_FORMAT::PNG : IMAGE_FORMAT::PNG_32;
+                source.Cache = std::make_unique<ImageImportCache>(cacheDirectory, source.Data, source.Format);
+                itSource = result.end() - 1;
+            }
+
+            // Decode the image up front when it is needed, so that a bad image fails the object as before.
+            if (itSource->Cache->Find(createImageImportMetaFromJson(jsonImage)) == nullptr)
+            {
+                itSource->GetImage();
             }
         }
     }
@@ -514,6 +682,20 @@ bool ImageTable::ReadJson(IReadObjectContext* context, json_t& root)
 
     if (context->ShouldLoadImages())
     {
+        const auto* bundleEntry = context->GetBundleEntry();
+        if (bundleEntry != nullptr)
+        {
+            for (size_t i = 0; i < bundleEntry->Images.size(); i++)
+            {
+                const auto g1 = bundleEntry->GetImage(i);
+                AddImage(&g1);
+            }
+            return bundleEntry->UsesFallbackImages;
+        }
+
+        // Images copied from other objects or the game's data depend on more than the object's files.
+        bool onlyUsesObjectFiles = true;
+
         // First gather all the required images from inspecting the JSON
         std::vector<std::unique_ptr<RequiredImage>> allImages;
         auto jsonImages = root["images"];
@@ -529,6 +711,7 @@ bool ImageTable::ReadJson(IReadObjectContext* context, json_t& root)
         {
             if (jsonImage.is_string())
             {
+                onlyUsesObjectFiles = false;
                 auto strImage = jsonImage.get<std::string>();
                 auto images = ParseImages(context, strImage);
                 allImages.insert(
@@ -538,6 +721,7 @@ bool ImageTable::ReadJson(IReadObjectContext* context, json_t& root)
             {
                 if (jsonImage.contains("gx"))
                 {
+                    onlyUsesObjectFiles = false;
                     auto xOverride = Json::GetNumber<int16_t>(jsonImage["x"], std::numeric_limits<int16_t>::max());
                     auto yOverride = Json::GetNumber<int16_t>(jsonImage["y"], std::numeric_limits<int16_t>::max());
                     const bool hasXOverride = xOverride != std::numeric_limits<int16_t>::max();
@@ -569,6 +753,11 @@ bool ImageTable::ReadJson(IReadObjectContext* context, json_t& root)
             }
         }
 
+        for (auto& source : imageSources)
+        {
+            source.Cache->Save();
+        }
+
         // Now add all the images to the image table
         auto imagesStartIndex = GetCount();
         for (const auto& img : allImages)
@@ -603,9 +792,13 @@ bool ImageTable::ReadJson(IReadObjectContext* context, json_t& root)
                 }
             }
         }
-    }
 
-    _objDataCache.clear();
+        auto* newBundleEntry = context->GetNewBundleEntry();
+        if (newBundleEntry != nullptr && onlyUsesObjectFiles)
+        {
+            newBundleEntry->SetImages(GetImages(), GetCount(), usesFallbackSprites);
+        }
+    }
 
     return usesFallbackSprites;
 }
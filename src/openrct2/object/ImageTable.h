@@ -15,6 +15,7 @@
 #include <memory>
 #include <vector>
 
+class Object;
 struct Image;
 struct IReadObjectContext;
 namespace OpenRCT2
@@ -32,14 +33,19 @@ private:
      * Container for a G1 image, additional information and RAII. Used by ReadJson
      */
     struct RequiredImage;
-    [[nodiscard]] std::vector<std::pair<std::string, Image>> GetImageSources(IReadObjectContext* context, json_t& jsonImages);
+    /**
+     * An image file used by the images of an object, decoded only if some of its images are not in the import cache.
+     */
+    struct ImageSource;
+    [[nodiscard]] std::vector<ImageSource> GetImageSources(IReadObjectContext* context, json_t& jsonImages);
     [[nodiscard]] static std::vector<std::unique_ptr<ImageTable::RequiredImage>> ParseImages(
         IReadObjectContext* context, std::string s);
     /**
      * @note root is deliberately left non-const: json_t behaviour changes when const
      */
     [[nodiscard]] static std::vector<std::unique_ptr<ImageTable::RequiredImage>> ParseImages(
-        IReadObjectContext* context, std::vector<std::pair<std::string, Image>>& imageSources, json_t& el);
+        IReadObjectContext* context, std::vector<ImageSource>& imageSources, json_t& el);
+    [[nodiscard]] static std::shared_ptr<const Object> GetLegacyObject(IReadObjectContext* context, const std::string& name);
     [[nodiscard]] static std::vector<std::unique_ptr<ImageTable::RequiredImage>> LoadObjectImages(
         IReadObjectContext* context, const std::string& name, const std::vector<int32_t>& range);
     [[nodiscard]] static std::vector<int32_t> ParseRange(std::string s);
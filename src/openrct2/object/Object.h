@@ -24,6 +24,10 @@
 #include <vector>
 
 struct ObjectRepositoryItem;
+namespace OpenRCT2
+{
+    struct ObjectBundleEntry;
+}
 using ride_type_t = uint16_t;
 
 constexpr size_t VersionNumFields = 3;
@@ -173,6 +177,10 @@ struct IReadObjectContext
     virtual bool ShouldLoadImages() = 0;
     virtual std::vector<uint8_t> GetData(std::string_view path) = 0;
     virtual ObjectAsset GetAsset(std::string_view path) = 0;
+    // The object as stored in the object bundle it is read from, or nullptr if it is read from its files.
+    virtual const OpenRCT2::ObjectBundleEntry* GetBundleEntry() = 0;
+    // The entry to store the object in the object bundle being built, or nullptr if it is not going to be bundled.
+    virtual OpenRCT2::ObjectBundleEntry* GetNewBundleEntry() = 0;
 
     virtual void LogVerbose(ObjectError code, const utf8* text) = 0;
     virtual void LogWarning(ObjectError code, const utf8* text) = 0;
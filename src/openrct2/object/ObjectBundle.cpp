@@ -0,0 +1,293 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "ObjectBundle.h"
+
+#include "../Context.h"
+#include "../Diagnostic.h"
+#include "../PlatformEnvironment.h"
+#include "../core/File.h"
+#include "../core/FileScanner.h"
+#include "../core/MemoryStream.h"
+#include "../core/Path.hpp"
+#include "../core/String.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+
+namespace OpenRCT2
+{
+    static constexpr uint32_t kMagicNumber = 0x424A424F; // OBJB
+    // Increase when the way objects are compiled changes, so that objects compiled before are not used.
+    static constexpr uint16_t kVersion = 1;
+    static constexpr uint32_t kMaxEntries = 0x10000;
+    static constexpr uint32_t kMaxStringLength = 0x10000;
+    static constexpr uint32_t kMaxBufferLength = 0x4000000;
+    // The least recently used bundles are deleted once the cache directory grows beyond this size.
+    static constexpr uint64_t kMaxDirectorySize = 512 * 1024 * 1024;
+
+    static constexpr uint8_t kEntryFlagHasImages = 1 << 0;
+    static constexpr uint8_t kEntryFlagCsgLoaded = 1 << 1;
+    static constexpr uint8_t kEntryFlagUsesFallbackImages = 1 << 2;
+
+    static std::atomic<ObjectBundle*> _activeBundle{};
+
+    bool ObjectBundleEntry::CanLoad(bool loadImages) const
+    {
+        return !loadImages || (HasImages && CsgLoaded == IsCsgLoaded());
+    }
+
+    void ObjectBundleEntry::SetImages(const G1Element* images, size_t numImages, bool usesFallbackImages)
+    {
+        HasImages = true;
+        CsgLoaded = IsCsgLoaded();
+        UsesFallbackImages = usesFallbackImages;
+        Images.clear();
+        ImageDataOffsets.clear();
+        ImageData.clear();
+        for (size_t i = 0; i < numImages; i++)
+        {
+            auto& element = Images.emplace_back(images[i]);
+            element.offset = nullptr;
+            ImageDataOffsets.push_back(static_cast<uint32_t>(ImageData.size()));
+
+            const auto length = G1CalculateDataSize(&images[i]);
+            if (length != 0)
+            {
+                ImageData.insert(ImageData.end(), images[i].offset, images[i].offset + length);
+            }
+        }
+    }
+
+    G1Element ObjectBundleEntry::GetImage(size_t index) const
+    {
+        auto element = Images[index];
+        element.offset = const_cast<uint8_t*>(ImageData.data()) + ImageDataOffsets[index];
+        return element;
+    }
+
+    ObjectBundle::ObjectBundle(u8string_view path)
+        : _path(path)
+    {
+        if (_path.empty() || !File::Exists(_path))
+            return;
+
+        try
+        {
+            // Read the whole bundle at once, it is only useful if most of its objects are loaded.
+            MemoryStream stream(File::ReadAllBytes(_path));
+            ReadEntries(stream);
+            // Keep the file from being trimmed, it is in use
+            File::Touch(_path);
+        }
+        catch (const std::exception& e)
+        {
+            LOG_VERBOSE("Unable to read object bundle '%s': %s", _path.c_str(), e.what());
+            _entries.clear();
+        }
+    }
+
+    u8string ObjectBundle::GetPath(std::vector<u8string> sourcePaths)
+    {
+        auto* context = GetContext();
+        if (context == nullptr)
+            return {};
+
+        // The bundle is named after the set of object files, regardless of the order they are loaded in.
+        std::sort(sourcePaths.begin(), sourcePaths.end());
+        auto sha1 = Crypt::CreateSHA1();
+        for (const auto& sourcePath : sourcePaths)
+        {
+            sha1->Update(sourcePath.data(), sourcePath.size() + 1);
+        }
+
+        const auto env = context->GetPlatformEnvironment();
+        const auto directory = Path::Combine(env->GetDirectoryPath(DIRBASE::CACHE), u8"objects");
+        return Path::Combine(directory, String::StringFromHex(sha1->Finish()) + u8".dat");
+    }
+
+    const ObjectBundleEntry* ObjectBundle::Find(
+        u8string_view sourcePath, const Crypt::Sha1Algorithm::Result& sourceHash) const
+    {
+        std::lock_guard lock(_mutex);
+        auto it = _entries.find(u8string(sourcePath));
+        if (it == _entries.end() || it->second.SourceHash != sourceHash)
+            return nullptr;
+        return &it->second;
+    }
+
+    void ObjectBundle::Add(u8string_view sourcePath, ObjectBundleEntry&& entry)
+    {
+        std::lock_guard lock(_mutex);
+        _entries.insert_or_assign(u8string(sourcePath), std::move(entry));
+        _modified = true;
+    }
+
+    size_t ObjectBundle::GetCount() const
+    {
+        std::lock_guard lock(_mutex);
+        return _entries.size();
+    }
+
+    void ObjectBundle::Save()
+    {
+        std::lock_guard lock(_mutex);
+        if (!_modified || _path.empty())
+            return;
+
+        try
+        {
+            Path::CreateDirectory(Path::GetDirectory(_path));
+            // Another process may be saving the same bundle, either of the writes ends up on disk.
+            MemoryStream stream;
+            WriteEntries(stream);
+            File::WriteAllBytesAtomic(_path, stream.GetData(), stream.GetLength());
+            _modified = false;
+            // A bundle is only written when a park loads objects that are not bundled yet, so trim on every write.
+            Path::TrimDirectory(Path::Combine(Path::GetDirectory(_path), u8"*.dat"), kMaxDirectorySize);
+        }
+        catch (const std::exception& e)
+        {
+            LOG_WARNING("Unable to write object bundle '%s': %s", _path.c_str(), e.what());
+        }
+    }
+
+    static std::vector<uint8_t> ReadBuffer(IStream& stream, uint32_t maxLength)
+    {
+        const auto length = stream.ReadValue<uint32_t>();
+        if (length > maxLength)
+            throw std::runtime_error("Buffer too large.");
+
+        std::vector<uint8_t> buffer(length);
+        stream.Read(buffer.data(), buffer.size());
+        return buffer;
+    }
+
+    static void WriteBuffer(IStream& stream, const void* data, size_t length)
+    {
+        stream.WriteValue<uint32_t>(static_cast<uint32_t>(length));
+        stream.Write(data, length);
+    }
+
+    void ObjectBundle::ReadEntries(IStream& stream)
+    {
+        if (stream.ReadValue<uint32_t>() != kMagicNumber)
+            throw std::runtime_error("Invalid magic number.");
+        if (stream.ReadValue<uint16_t>() != kVersion)
+            throw std::runtime_error("Different version.");
+
+        const auto numEntries = stream.ReadValue<uint32_t>();
+        if (numEntries > kMaxEntries)
+            throw std::runtime_error("Too many entries.");
+
+        std::unordered_map<u8string, ObjectBundleEntry> entries;
+        for (uint32_t i = 0; i < numEntries; i++)
+        {
+            const auto sourcePath = ReadBuffer(stream, kMaxStringLength);
+
+            ObjectBundleEntry entry;
+            stream.Read(entry.SourceHash.data(), entry.SourceHash.size());
+            entry.Properties = ReadBuffer(stream, kMaxBufferLength);
+
+            const auto flags = stream.ReadValue<uint8_t>();
+            entry.HasImages = (flags & kEntryFlagHasImages) != 0;
+            entry.CsgLoaded = (flags & kEntryFlagCsgLoaded) != 0;
+            entry.UsesFallbackImages = (flags & kEntryFlagUsesFallbackImages) != 0;
+
+            const auto numImages = stream.ReadValue<uint32_t>();
+            if (numImages > kMaxBufferLength / 16)
+                throw std::runtime_error("Too many images.");
+
+            entry.Images.resize(numImages);
+            entry.ImageDataOffsets.resize(numImages);
+            for (uint32_t j = 0; j < numImages; j++)
+            {
+                auto& element = entry.Images[j];
+                element.width = stream.ReadValue<int16_t>();
+                element.height = stream.ReadValue<int16_t>();
+                element.x_offset = stream.ReadValue<int16_t>();
+                element.y_offset = stream.ReadValue<int16_t>();
+                element.flags = stream.ReadValue<uint16_t>();
+                element.zoomed_offset = stream.ReadValue<int32_t>();
+                entry.ImageDataOffsets[j] = stream.ReadValue<uint32_t>();
+            }
+
+            entry.ImageData = ReadBuffer(stream, kMaxBufferLength);
+            for (uint32_t j = 0; j < numImages; j++)
+            {
+                const auto offset = entry.ImageDataOffsets[j];
+                if (offset > entry.ImageData.size())
+                    throw std::runtime_error("Invalid image data offset.");
+
+                const auto element = entry.GetImage(j);
+                if (!G1IsDataWithinLength(&element, entry.ImageData.size() - offset))
+                    throw std::runtime_error("Image data does not match the image.");
+            }
+
+            entries.insert_or_assign(u8string(sourcePath.begin(), sourcePath.end()), std::move(entry));
+        }
+
+        std::lock_guard lock(_mutex);
+        _entries = std::move(entries);
+        _modified = false;
+    }
+
+    void ObjectBundle::WriteEntries(IStream& stream) const
+    {
+        stream.WriteValue<uint32_t>(kMagicNumber);
+        stream.WriteValue<uint16_t>(kVersion);
+        stream.WriteValue<uint32_t>(static_cast<uint32_t>(_entries.size()));
+        for (const auto& [sourcePath, entry] : _entries)
+        {
+            WriteBuffer(stream, sourcePath.data(), sourcePath.size());
+            stream.Write(entry.SourceHash.data(), entry.SourceHash.size());
+            WriteBuffer(stream, entry.Properties.data(), entry.Properties.size());
+
+            uint8_t flags = 0;
+            if (entry.HasImages)
+                flags |= kEntryFlagHasImages;
+            if (entry.CsgLoaded)
+                flags |= kEntryFlagCsgLoaded;
+            if (entry.UsesFallbackImages)
+                flags |= kEntryFlagUsesFallbackImages;
+            stream.WriteValue<uint8_t>(flags);
+
+            stream.WriteValue<uint32_t>(static_cast<uint32_t>(entry.Images.size()));
+            for (size_t j = 0; j < entry.Images.size(); j++)
+            {
+                const auto& element = entry.Images[j];
+                stream.WriteValue<int16_t>(element.width);
+                stream.WriteValue<int16_t>(element.height);
+                stream.WriteValue<int16_t>(element.x_offset);
+                stream.WriteValue<int16_t>(element.y_offset);
+                stream.WriteValue<uint16_t>(element.flags);
+                stream.WriteValue<int32_t>(element.zoomed_offset);
+                stream.WriteValue<uint32_t>(entry.ImageDataOffsets[j]);
+            }
+
+            WriteBuffer(stream, entry.ImageData.data(), entry.ImageData.size());
+        }
+    }
+
+    ObjectBundleScope::ObjectBundleScope(ObjectBundle& bundle)
+    {
+        _activeBundle = &bundle;
+    }
+
+    ObjectBundleScope::~ObjectBundleScope()
+    {
+        _activeBundle = nullptr;
+    }
+
+    ObjectBundle* GetActiveObjectBundle()
+    {
+        return _activeBundle;
+    }
+} // namespace OpenRCT2
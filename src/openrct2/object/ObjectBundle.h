@@ -0,0 +1,99 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../core/Crypt.h"
+#include "../core/StringTypes.h"
+#include "../drawing/Drawing.h"
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace OpenRCT2
+{
+    struct IStream;
+
+    /**
+     * An object compiled from a .parkobj file: its properties and the images they describe, ready to be read without
+     * opening the file, parsing its object.json or importing its images.
+     */
+    struct ObjectBundleEntry
+    {
+        Crypt::Sha1Algorithm::Result SourceHash{};
+        // The object.json of the object, encoded as CBOR.
+        std::vector<uint8_t> Properties;
+
+        bool HasImages{};
+        // Whether the images were read while the RCT1 images (CSG) were loaded, which decides the images an object uses.
+        bool CsgLoaded{};
+        bool UsesFallbackImages{};
+        // The images of the image table of the object, without their data.
+        std::vector<G1Element> Images;
+        std::vector<uint32_t> ImageDataOffsets;
+        std::vector<uint8_t> ImageData;
+
+        // Returns whether the object can be read from this entry alone.
+        bool CanLoad(bool loadImages) const;
+        void SetImages(const G1Element* images, size_t numImages, bool usesFallbackImages);
+        G1Element GetImage(size_t index) const;
+    };
+
+    /**
+     * The objects of a set of object files compiled into a single file in the cache directory, such as the objects used
+     * by a park. Loading the park again reads the whole bundle in one go and takes each object whose file still has
+     * the same contents from it.
+     */
+    class ObjectBundle
+    {
+    private:
+        u8string _path;
+        mutable std::mutex _mutex;
+        std::unordered_map<u8string, ObjectBundleEntry> _entries;
+        bool _modified{};
+
+    public:
+        /**
+         * @param path The bundle file, or empty to only keep the objects in memory.
+         */
+        explicit ObjectBundle(u8string_view path);
+
+        // Returns the path of the bundle of the given object files, or an empty string if there is no cache directory.
+        static u8string GetPath(std::vector<u8string> sourcePaths);
+
+        // Returns the object compiled from the object file with the given contents, or nullptr if it is not bundled.
+        const ObjectBundleEntry* Find(u8string_view sourcePath, const Crypt::Sha1Algorithm::Result& sourceHash) const;
+        void Add(u8string_view sourcePath, ObjectBundleEntry&& entry);
+        size_t GetCount() const;
+
+        // Writes the bundle file if any objects were added.
+        void Save();
+
+        void ReadEntries(IStream& stream);
+        void WriteEntries(IStream& stream) const;
+    };
+
+    /**
+     * Makes the objects that are loaded from .parkobj files, on any thread, use and extend the given bundle until the
+     * scope is destroyed.
+     */
+    class ObjectBundleScope
+    {
+    public:
+        explicit ObjectBundleScope(ObjectBundle& bundle);
+        ~ObjectBundleScope();
+
+        ObjectBundleScope(const ObjectBundleScope&) = delete;
+        ObjectBundleScope& operator=(const ObjectBundleScope&) = delete;
+    };
+
+    // Returns the bundle of the objects being loaded, or nullptr if they are not loaded through a bundle.
+    ObjectBundle* GetActiveObjectBundle();
+} // namespace OpenRCT2
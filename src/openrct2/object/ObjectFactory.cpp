@@ -15,6 +15,7 @@
 #include "../PlatformEnvironment.h"
 #include "../audio/audio.h"
 #include "../core/Console.hpp"
+#include "../core/Crypt.h"
 #include "../core/File.h"
 #include "../core/FileStream.h"
 #include "../core/Json.hpp"
@@ -33,6 +34,7 @@
 #include "LargeSceneryObject.h"
 #include "MusicObject.h"
 #include "Object.h"
+#include "ObjectBundle.h"
 #include "ObjectLimits.h"
 #include "ObjectList.h"
 #include "PathAdditionObject.h"
@@ -93,18 +95,23 @@ class ZipDataRetriever : public IFileDataRetriever
 {
 private:
     const std::string _path;
-    const IZipArchive& _zipArchive;
+    // Opened when first needed, objects read from an object bundle usually do not need their files.
+    mutable std::unique_ptr<IZipArchive> _zipArchive;
 
 public:
-    ZipDataRetriever(std::string_view path, const IZipArchive& zipArchive)
+    ZipDataRetriever(std::string_view path, std::unique_ptr<IZipArchive> zipArchive = nullptr)
         : _path(path)
-        , _zipArchive(zipArchive)
+        , _zipArchive(std::move(zipArchive))
     {
     }
 
     std::vector<uint8_t> GetData(std::string_view path) const override
     {
-        return _zipArchive.GetFileData(path);
+        if (_zipArchive == nullptr)
+        {
+            _zipArchive = Zip::Open(_path, ZIP_ACCESS::READ);
+        }
+        return _zipArchive->GetFileData(path);
     }
 
     ObjectAsset GetAsset(std::string_view path) const override
@@ -118,6 +125,8 @@ class ReadObjectContext : public IReadObjectContext
 private:
     IObjectRepository& _objectRepository;
     const IFileDataRetriever* _fileDataRetriever;
+    const ObjectBundleEntry* _bundleEntry;
+    ObjectBundleEntry* _newBundleEntry;
 
     std::string _identifier;
     bool _loadImages;
@@ -142,9 +151,12 @@ public:
 
     ReadObjectContext(
         IObjectRepository& objectRepository, const std::string& identifier, bool loadImages,
-        const IFileDataRetriever* fileDataRetriever)
+        const IFileDataRetriever* fileDataRetriever, const ObjectBundleEntry* bundleEntry = nullptr,
+        ObjectBundleEntry* newBundleEntry = nullptr)
         : _objectRepository(objectRepository)
         , _fileDataRetriever(fileDataRetriever)
+        , _bundleEntry(bundleEntry)
+        , _newBundleEntry(newBundleEntry)
         , _identifier(identifier)
         , _loadImages(loadImages)
     {
@@ -183,6 +195,16 @@ public:
         return {};
     }
 
+    const ObjectBundleEntry* GetBundleEntry() override
+    {
+        return _bundleEntry;
+    }
+
+    ObjectBundleEntry* GetNewBundleEntry() override
+    {
+        return _newBundleEntry;
+    }
+
     void LogVerbose(ObjectError code, const utf8* text) override
     {
         _wasVerbose = true;
@@ -221,7 +243,8 @@ namespace OpenRCT2::ObjectFactory
      * @note jRoot is deliberately left non-const: json_t behaviour changes when const
      */
     static std::unique_ptr<Object> CreateObjectFromJson(
-        IObjectRepository& objectRepository, json_t& jRoot, const IFileDataRetriever* fileRetriever, bool loadImageTable);
+        IObjectRepository& objectRepository, json_t& jRoot, const IFileDataRetriever* fileRetriever, bool loadImageTable,
+        const ObjectBundleEntry* bundleEntry, ObjectBundleEntry* newBundleEntry);
 
     static ObjectSourceGame ParseSourceGame(const std::string& s)
     {
@@ -437,7 +460,29 @@ namespace OpenRCT2::ObjectFactory
     {
         try
         {
-            auto archive = Zip::Open(path, ZIP_ACCESS::READ);
+            auto* bundle = GetActiveObjectBundle();
+            Crypt::Sha1Algorithm::Result sourceHash{};
+            std::vector<uint8_t> sourceData;
+            if (bundle != nullptr)
+            {
+                sourceData = File::ReadAllBytes(path);
+                sourceHash = Crypt::SHA1(sourceData.data(), sourceData.size());
+
+                const auto* bundleEntry = bundle->Find(path, sourceHash);
+                if (bundleEntry != nullptr && bundleEntry->CanLoad(loadImages))
+                {
+                    json_t jRoot = json_t::from_cbor(bundleEntry->Properties, true, false);
+                    if (jRoot.is_object())
+                    {
+                        auto fileDataRetriever = ZipDataRetriever(path);
+                        return CreateObjectFromJson(
+                            objectRepository, jRoot, &fileDataRetriever, loadImages, bundleEntry, nullptr);
+                    }
+                }
+            }
+
+            // The bundle has already read the whole file to hash it, so open the zip from that.
+            auto archive = bundle != nullptr ? Zip::Open(path, std::move(sourceData)) : Zip::Open(path, ZIP_ACCESS::READ);
             auto jsonBytes = archive->GetFileData("object.json");
             if (jsonBytes.empty())
             {
@@ -448,8 +493,23 @@ namespace OpenRCT2::ObjectFactory
 
             if (jRoot.is_object())
             {
-                auto fileDataRetriever = ZipDataRetriever(path, *archive);
-                return CreateObjectFromJson(objectRepository, jRoot, &fileDataRetriever, loadImages);
+                auto fileDataRetriever = ZipDataRetriever(path, std::move(archive));
+                if (bundle == nullptr)
+                {
+                    return CreateObjectFromJson(objectRepository, jRoot, &fileDataRetriever, loadImages, nullptr, nullptr);
+                }
+
+                // Encode the properties before reading them, reading adds the properties the object does not have.
+                ObjectBundleEntry newEntry;
+                newEntry.SourceHash = sourceHash;
+                newEntry.Properties = json_t::to_cbor(jRoot);
+                auto result = CreateObjectFromJson(
+                    objectRepository, jRoot, &fileDataRetriever, loadImages, nullptr, &newEntry);
+                if (result != nullptr && newEntry.CanLoad(loadImages))
+                {
+                    bundle->Add(path, std::move(newEntry));
+                }
+                return result;
             }
         }
         catch (const std::exception& e)
@@ -468,7 +528,7 @@ namespace OpenRCT2::ObjectFactory
         {
             json_t jRoot = Json::ReadFromFile(path.c_str());
             auto fileDataRetriever = FileSystemDataRetriever(Path::GetDirectory(path));
-            return CreateObjectFromJson(objectRepository, jRoot, &fileDataRetriever, loadImages);
+            return CreateObjectFromJson(objectRepository, jRoot, &fileDataRetriever, loadImages, nullptr, nullptr);
         }
         catch (const std::runtime_error& err)
         {
@@ -517,7 +577,8 @@ namespace OpenRCT2::ObjectFactory
     }
 
     std::unique_ptr<Object> CreateObjectFromJson(
-        IObjectRepository& objectRepository, json_t& jRoot, const IFileDataRetriever* fileRetriever, bool loadImageTable)
+        IObjectRepository& objectRepository, json_t& jRoot, const IFileDataRetriever* fileRetriever, bool loadImageTable,
+        const ObjectBundleEntry* bundleEntry, ObjectBundleEntry* newBundleEntry)
     {
         if (!jRoot.is_object())
         {
@@ -576,7 +637,8 @@ namespace OpenRCT2::ObjectFactory
             result->SetIdentifier(id);
             result->SetDescriptor(descriptor);
             result->MarkAsJsonObject();
-            auto readContext = ReadObjectContext(objectRepository, id, loadImageTable, fileRetriever);
+            auto readContext = ReadObjectContext(
+                objectRepository, id, loadImageTable, fileRetriever, bundleEntry, newBundleEntry);
             result->ReadJson(&readContext, jRoot);
             if (readContext.WasError())
             {
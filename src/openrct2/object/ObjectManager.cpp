@@ -13,6 +13,7 @@
 #include "../Diagnostic.h"
 #include "../ParkImporter.h"
 #include "../audio/audio.h"
+#include "../config/Config.h"
 #include "../core/Console.hpp"
 #include "../core/JobPool.h"
 #include "../core/Memory.hpp"
@@ -24,6 +25,7 @@
 #include "BannerSceneryEntry.h"
 #include "LargeSceneryObject.h"
 #include "Object.h"
+#include "ObjectBundle.h"
 #include "ObjectLimits.h"
 #include "ObjectList.h"
 #include "ObjectRepository.h"
@@ -37,6 +39,7 @@
 #include <array>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <thread>
 #include <unordered_set>
 
@@ -627,6 +630,20 @@ private:
                 ReportProgress(numProcessed, numRequired);
         };
 
+        // Load the objects from the bundle compiled the last time this set of objects was loaded
+        std::optional<ObjectBundle> bundle;
+        std::optional<ObjectBundleScope> bundleScope;
+        if (Config::Get().general.UseObjectBundles && !objectsToLoad.empty())
+        {
+            std::vector<u8string> sourcePaths;
+            for (const auto* object : objectsToLoad)
+            {
+                sourcePaths.push_back(object->Path);
+            }
+            bundle.emplace(ObjectBundle::GetPath(std::move(sourcePaths)));
+            bundleScope.emplace(*bundle);
+        }
+
         // Dispatch loading the objects
         JobPool jobs{};
         for (auto* object : objectsToLoad)
@@ -637,6 +654,12 @@ private:
         // Wait until all jobs are fully completed
         jobs.Join();
 
+        if (bundle.has_value())
+        {
+            bundleScope.reset();
+            bundle->Save();
+        }
+
         // Assign the loaded objects to the required objects
         for (auto& requiredObject : requiredObjects)
         {
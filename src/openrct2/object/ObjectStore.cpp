@@ -0,0 +1,137 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "ObjectStore.h"
+
+#include "../Context.h"
+#include "../Diagnostic.h"
+#include "../PlatformEnvironment.h"
+#include "../core/File.h"
+#include "../core/Path.hpp"
+#include "../core/String.hpp"
+
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace OpenRCT2::ObjectStore
+{
+    struct FileHash
+    {
+        uint64_t LastModified{};
+        uint64_t Size{};
+        Hash ContentHash{};
+    };
+
+    // The hashes of the object files added before, so that saving a park again does not read every object file.
+    static std::mutex _fileHashesMutex;
+    static std::unordered_map<u8string, FileHash> _fileHashes;
+
+    u8string GetDirectory()
+    {
+        auto* context = GetContext();
+        if (context == nullptr)
+            return {};
+
+        const auto env = context->GetPlatformEnvironment();
+        return env->GetDirectoryPath(DIRBASE::USER, DIRID::OBJECT_STORE);
+    }
+
+    static u8string GetStorePath(u8string_view directory, const Hash& hash)
+    {
+        // Spread the objects over subdirectories named after the first byte of their hash.
+        const auto hex = String::StringFromHex(hash);
+        return Path::Combine(directory, hex.substr(0, 2), hex + u8".bin");
+    }
+
+    // Whether the store already holds data, a store file that was cut short or damaged is written again.
+    static bool IsStored(const u8string& storePath, const std::vector<uint8_t>& data)
+    {
+        return File::Exists(storePath) && File::GetSize(storePath) == data.size() && File::ReadAllBytes(storePath) == data;
+    }
+
+    static bool WriteToStore(const u8string& storePath, const std::vector<uint8_t>& data)
+    {
+        try
+        {
+            // Another process may be storing the same object, in which case either of the writes ends up in the store.
+            Path::CreateDirectory(Path::GetDirectory(storePath));
+            return File::WriteAllBytesAtomic(storePath, data.data(), data.size()) || File::Exists(storePath);
+        }
+        catch (const std::exception& e)
+        {
+            LOG_WARNING("Unable to write object to store '%s': %s", storePath.c_str(), e.what());
+            return false;
+        }
+    }
+
+    std::optional<Hash> AddFile(u8string_view path)
+    {
+        const auto directory = GetDirectory();
+        if (directory.empty())
+            return std::nullopt;
+
+        try
+        {
+            const auto lastModified = File::GetLastModified(path);
+            const auto size = File::GetSize(path);
+            {
+                std::lock_guard lock(_fileHashesMutex);
+                auto it = _fileHashes.find(u8string(path));
+                if (it != _fileHashes.end() && it->second.LastModified == lastModified && it->second.Size == size
+                    && File::Exists(GetStorePath(directory, it->second.ContentHash)))
+                {
+                    return it->second.ContentHash;
+                }
+            }
+
+            const auto data = File::ReadAllBytes(path);
+            const auto hash = Crypt::SHA1(data.data(), data.size());
+            const auto storePath = GetStorePath(directory, hash);
+            if (!IsStored(storePath, data) && !WriteToStore(storePath, data))
+                return std::nullopt;
+
+            std::lock_guard lock(_fileHashesMutex);
+            _fileHashes[u8string(path)] = { lastModified, size, hash };
+            return hash;
+        }
+        catch (const std::exception& e)
+        {
+            LOG_WARNING("Unable to add '%s' to the object store: %s", u8string(path).c_str(), e.what());
+            return std::nullopt;
+        }
+    }
+
+    std::optional<std::vector<uint8_t>> Read(const Hash& hash)
+    {
+        const auto directory = GetDirectory();
+        if (directory.empty())
+            return std::nullopt;
+
+        const auto storePath = GetStorePath(directory, hash);
+        if (!File::Exists(storePath))
+            return std::nullopt;
+
+        try
+        {
+            auto data = File::ReadAllBytes(storePath);
+            if (Crypt::SHA1(data.data(), data.size()) != hash)
+            {
+                LOG_WARNING("Object in store '%s' does not match its hash.", storePath.c_str());
+                return std::nullopt;
+            }
+            return data;
+        }
+        catch (const std::exception& e)
+        {
+            LOG_WARNING("Unable to read object from store '%s': %s", storePath.c_str(), e.what());
+            return std::nullopt;
+        }
+    }
+} // namespace OpenRCT2::ObjectStore
@@ -0,0 +1,35 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../core/Crypt.h"
+#include "../core/StringTypes.h"
+
+#include <optional>
+#include <vector>
+
+/**
+ * A local store of object files addressed by the SHA-1 hash of their contents. Saved games can reference their packed
+ * objects by hash instead of embedding them, so saving a park again only writes the objects that are not stored yet.
+ */
+namespace OpenRCT2::ObjectStore
+{
+    using Hash = Crypt::Sha1Algorithm::Result;
+
+    u8string GetDirectory();
+
+    // Adds the contents of the object file to the store unless they are stored already. Returns the hash of the
+    // contents, or std::nullopt if the file could not be read or the store could not be written.
+    std::optional<Hash> AddFile(u8string_view path);
+
+    // Returns the stored contents with the given hash, or std::nullopt if they are not in the store.
+    std::optional<std::vector<uint8_t>> Read(const Hash& hash);
+
+} // namespace OpenRCT2::ObjectStore
@@ -10,6 +10,7 @@
 #include "StringTable.h"
 
 #include "../Context.h"
+#include "../OpenRCT2.h"
 #include "../core/IStream.hpp"
 #include "../core/Json.hpp"
 #include "../core/String.hpp"
@@ -63,12 +64,7 @@ void StringTable::Read(IReadObjectContext* context, OpenRCT2::IStream* stream, O
 
             if (!StringIsBlank(stringAsUtf8.data()))
             {
-                stringAsUtf8 = String::Trim(stringAsUtf8);
-                StringTableEntry entry{};
-                entry.Id = id;
-                entry.LanguageId = languageId;
-                entry.Text = std::move(stringAsUtf8);
-                _strings.push_back(std::move(entry));
+                SetString(id, languageId, String::Trim(stringAsUtf8));
             }
         }
     }
@@ -119,13 +115,18 @@ void StringTable::ReadJson(json_t& root)
     Sort();
 }
 
+std::string_view StringTable::GetText(const StringTableEntry& entry) const
+{
+    return std::string_view(_text).substr(entry.Offset, entry.Length);
+}
+
 std::string StringTable::GetString(ObjectStringID id) const
 {
     for (auto& string : _strings)
     {
         if (string.Id == id)
         {
-            return string.Text;
+            return std::string(GetText(string));
         }
     }
     return std::string();
@@ -137,7 +138,7 @@ std::string StringTable::GetString(uint8_t language, ObjectStringID id) const
     {
         if (string.LanguageId == language && string.Id == id)
         {
-            return string.Text;
+            return std::string(GetText(string));
         }
     }
     return std::string();
@@ -148,19 +149,22 @@ void StringTable::SetString(ObjectStringID id, uint8_t language, const std::stri
     StringTableEntry entry;
     entry.Id = id;
     entry.LanguageId = language;
-    entry.Text = text;
-    _strings.push_back(std::move(entry));
+    entry.Offset = static_cast<uint32_t>(_text.size());
+    entry.Length = static_cast<uint32_t>(text.size());
+    _text.append(text);
+    _text.push_back('\0');
+    _strings.push_back(entry);
 }
 
 void StringTable::Sort()
 {
     const auto& languageOrder = OpenRCT2::GetContext()->GetLocalisationService().GetLanguageOrder();
-    std::sort(_strings.begin(), _strings.end(), [languageOrder](const StringTableEntry& a, const StringTableEntry& b) -> bool {
+    auto compare = [this, &languageOrder](const StringTableEntry& a, const StringTableEntry& b) -> bool {
         if (a.Id == b.Id)
         {
             if (a.LanguageId == b.LanguageId)
             {
-                return String::Compare(a.Text, b.Text, true) < 0;
+                return String::Compare(_text.c_str() + a.Offset, _text.c_str() + b.Offset, true) < 0;
             }
 
             for (const auto& language : languageOrder)
@@ -178,5 +182,32 @@ void StringTable::Sort()
             return a.LanguageId < b.LanguageId;
         }
         return a.Id < b.Id;
+    };
+    std::sort(_strings.begin(), _strings.end(), compare);
+
+    if (gOpenRCT2Headless)
+    {
+        RemoveUnusedStrings();
+    }
+    _strings.shrink_to_fit();
+    _text.shrink_to_fit();
+}
+
+void StringTable::RemoveUnusedStrings()
+{
+    // Keep only the first string of each identifier, the one shown in the current language.
+    auto itUnused = std::unique(_strings.begin(), _strings.end(), [](const StringTableEntry& a, const StringTableEntry& b) {
+        return a.Id == b.Id;
     });
+    _strings.erase(itUnused, _strings.end());
+
+    std::string text;
+    for (auto& entry : _strings)
+    {
+        const auto offset = static_cast<uint32_t>(text.size());
+        text.append(GetText(entry));
+        text.push_back('\0');
+        entry.Offset = offset;
+    }
+    _text = std::move(text);
 }
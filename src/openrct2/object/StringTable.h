@@ -13,6 +13,7 @@
 #include "../localisation/Language.h"
 
 #include <string>
+#include <string_view>
 #include <vector>
 
 struct IReadObjectContext;
@@ -37,14 +38,20 @@ struct StringTableEntry
 {
     ObjectStringID Id = ObjectStringID::UNKNOWN;
     uint8_t LanguageId = LANGUAGE_UNDEFINED;
-    std::string Text;
+    // The position of the string in the text of the string table.
+    uint32_t Offset{};
+    uint32_t Length{};
 };
 
 class StringTable
 {
 private:
+    // The strings of every entry one after another, each followed by a NUL.
+    std::string _text;
     std::vector<StringTableEntry> _strings;
     static ObjectStringID ParseStringId(const std::string& s);
+    std::string_view GetText(const StringTableEntry& entry) const;
+    void RemoveUnusedStrings();
 
 public:
     StringTable() = default;
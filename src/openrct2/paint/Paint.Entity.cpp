@@ -14,6 +14,7 @@
 #include "../entity/Balloon.h"
 #include "../entity/Duck.h"
 #include "../entity/EntityList.h"
+#include "../entity/EntityTweener.h"
 #include "../entity/Fountain.h"
 #include "../entity/Litter.h"
 #include "../entity/MoneyEffect.h"
@@ -32,6 +33,115 @@
 
 #include <cassert>
 
+static void PaintEntity(PaintSession& session, EntityBase* spr, const CoordsXYZ& entityPos)
+{
+    // Only paint sprites that are below the clip height and inside the clip selection.
+    // Here converting from land/path/etc height scale to pixel height scale.
+    // Note: peeps/scenery on slopes will be above the base
+    // height of the slope element, and consequently clipped.
+    if ((session.ViewFlags & VIEWPORT_FLAG_CLIP_VIEW))
+    {
+        if (entityPos.z > (gClipHeight * kCoordsZStep))
+        {
+            return;
+        }
+        if (entityPos.x < gClipSelectionA.x || entityPos.x > (gClipSelectionB.x + kCoordsXYStep - 1))
+        {
+            return;
+        }
+        if (entityPos.y < gClipSelectionA.y || entityPos.y > (gClipSelectionB.y + kCoordsXYStep - 1))
+        {
+            return;
+        }
+    }
+
+    auto screenCoords = Translate3DTo2DWithZ(session.CurrentRotation, entityPos);
+    auto spriteRect = ScreenRect(
+        screenCoords - ScreenCoordsXY{ spr->SpriteData.Width, spr->SpriteData.HeightMin },
+        screenCoords + ScreenCoordsXY{ spr->SpriteData.Width, spr->SpriteData.HeightMax });
+
+    const ZoomLevel zoom = session.DPI.zoom_level;
+    if (session.DPI.y + session.DPI.height <= zoom.ApplyInversedTo(spriteRect.GetTop())
+        || zoom.ApplyInversedTo(spriteRect.GetBottom()) <= session.DPI.y
+        || session.DPI.x + session.DPI.width <= zoom.ApplyInversedTo(spriteRect.GetLeft())
+        || zoom.ApplyInversedTo(spriteRect.GetRight()) <= session.DPI.x)
+    {
+        return;
+    }
+
+    int32_t image_direction = session.CurrentRotation;
+    image_direction <<= 3;
+    image_direction += spr->Orientation;
+    image_direction &= 0x1F;
+
+    session.CurrentlyDrawnEntity = spr;
+    session.SpritePosition.x = entityPos.x;
+    session.SpritePosition.y = entityPos.y;
+    session.InteractionType = ViewportInteractionItem::Entity;
+
+    switch (spr->Type)
+    {
+        case EntityType::Vehicle:
+            spr->As<Vehicle>()->Paint(session, image_direction, entityPos);
+            if (LightFXForVehiclesIsAvailable())
+            {
+                LightFXAddLightsMagicVehicle(spr->As<Vehicle>());
+            }
+            break;
+        case EntityType::Guest:
+        case EntityType::Staff:
+            spr->As<Peep>()->Paint(session, image_direction, entityPos);
+            break;
+        case EntityType::SteamParticle:
+            spr->As<SteamParticle>()->Paint(session, image_direction);
+            break;
+        case EntityType::MoneyEffect:
+            spr->As<MoneyEffect>()->Paint(session, image_direction);
+            break;
+        case EntityType::CrashedVehicleParticle:
+            spr->As<VehicleCrashParticle>()->Paint(session, image_direction);
+            break;
+        case EntityType::ExplosionCloud:
+            spr->As<ExplosionCloud>()->Paint(session, image_direction);
+            break;
+        case EntityType::CrashSplash:
+            spr->As<CrashSplashParticle>()->Paint(session, image_direction);
+            break;
+        case EntityType::ExplosionFlare:
+            spr->As<ExplosionFlare>()->Paint(session, image_direction);
+            break;
+        case EntityType::JumpingFountain:
+            spr->As<JumpingFountain>()->Paint(session, image_direction);
+            break;
+        case EntityType::Balloon:
+            spr->As<Balloon>()->Paint(session, image_direction);
+            break;
+        case EntityType::Duck:
+            spr->As<Duck>()->Paint(session, image_direction);
+            break;
+        case EntityType::Litter:
+            spr->As<Litter>()->Paint(session, image_direction);
+            break;
+        default:
+            assert(false);
+            break;
+    }
+}
+
+static bool IsEntityHidden(const PaintSession& session, const EntityBase* spr)
+{
+    if (session.ViewFlags & VIEWPORT_FLAG_HIGHLIGHT_PATH_ISSUES)
+    {
+        const auto staff = spr->As<Staff>();
+        if (staff != nullptr)
+        {
+            return staff->AssignedStaffType != StaffType::Handyman;
+        }
+        return spr->Type != EntityType::Litter;
+    }
+    return false;
+}
+
 /**
  * Paint Quadrant
  *  rct2: 0x0069E8B0
@@ -54,118 +164,23 @@ void EntityPaintSetup(PaintSession& session, const CoordsXY& pos)
         return;
     }
 
-    const bool highlightPathIssues = (session.ViewFlags & VIEWPORT_FLAG_HIGHLIGHT_PATH_ISSUES);
-
+    // Interpolated entities are painted on the tile they are drawn over rather than the one they are on,
+    // so that they are sorted against the right tile elements.
+    const auto& tweener = EntityTweener::Get();
     for (auto* spr : EntityTileList(pos))
     {
-        if (highlightPathIssues)
-        {
-            const auto staff = spr->As<Staff>();
-            if (staff != nullptr)
-            {
-                if (staff->AssignedStaffType != StaffType::Handyman)
-                {
-                    continue;
-                }
-            }
-            else if (spr->Type != EntityType::Litter)
-            {
-                continue;
-            }
-        }
-
-        const auto entityPos = spr->GetLocation();
-
-        // Only paint sprites that are below the clip height and inside the clip selection.
-        // Here converting from land/path/etc height scale to pixel height scale.
-        // Note: peeps/scenery on slopes will be above the base
-        // height of the slope element, and consequently clipped.
-        if ((session.ViewFlags & VIEWPORT_FLAG_CLIP_VIEW))
-        {
-            if (entityPos.z > (gClipHeight * kCoordsZStep))
-            {
-                continue;
-            }
-            if (entityPos.x < gClipSelectionA.x || entityPos.x > (gClipSelectionB.x + kCoordsXYStep - 1))
-            {
-                continue;
-            }
-            if (entityPos.y < gClipSelectionA.y || entityPos.y > (gClipSelectionB.y + kCoordsXYStep - 1))
-            {
-                continue;
-            }
-        }
-
-        auto screenCoords = Translate3DTo2DWithZ(session.CurrentRotation, spr->GetLocation());
-        auto spriteRect = ScreenRect(
-            screenCoords - ScreenCoordsXY{ spr->SpriteData.Width, spr->SpriteData.HeightMin },
-            screenCoords + ScreenCoordsXY{ spr->SpriteData.Width, spr->SpriteData.HeightMax });
-
-        const ZoomLevel zoom = session.DPI.zoom_level;
-        if (session.DPI.y + session.DPI.height <= zoom.ApplyInversedTo(spriteRect.GetTop())
-            || zoom.ApplyInversedTo(spriteRect.GetBottom()) <= session.DPI.y
-            || session.DPI.x + session.DPI.width <= zoom.ApplyInversedTo(spriteRect.GetLeft())
-            || zoom.ApplyInversedTo(spriteRect.GetRight()) <= session.DPI.x)
+        if (IsEntityHidden(session, spr) || tweener.IsDisplaced(*spr))
         {
             continue;
         }
-
-        int32_t image_direction = session.CurrentRotation;
-        image_direction <<= 3;
-        image_direction += spr->Orientation;
-        image_direction &= 0x1F;
-
-        session.CurrentlyDrawnEntity = spr;
-        session.SpritePosition.x = entityPos.x;
-        session.SpritePosition.y = entityPos.y;
-        session.InteractionType = ViewportInteractionItem::Entity;
-
-        switch (spr->Type)
+        PaintEntity(session, spr, tweener.GetPaintLocation(*spr));
+    }
+    for (const auto& displaced : tweener.GetDisplacedEntities(pos))
+    {
+        if (IsEntityHidden(session, displaced.Entity))
         {
-            case EntityType::Vehicle:
-                spr->As<Vehicle>()->Paint(session, image_direction);
-                if (LightFXForVehiclesIsAvailable())
-                {
-                    LightFXAddLightsMagicVehicle(spr->As<Vehicle>());
-                }
-                break;
-            case EntityType::Guest:
-            case EntityType::Staff:
-                spr->As<Peep>()->Paint(session, image_direction);
-                break;
-            case EntityType::SteamParticle:
-                spr->As<SteamParticle>()->Paint(session, image_direction);
-                break;
-            case EntityType::MoneyEffect:
-                spr->As<MoneyEffect>()->Paint(session, image_direction);
-                break;
-            case EntityType::CrashedVehicleParticle:
-                spr->As<VehicleCrashParticle>()->Paint(session, image_direction);
-                break;
-            case EntityType::ExplosionCloud:
-                spr->As<ExplosionCloud>()->Paint(session, image_direction);
-                break;
-            case EntityType::CrashSplash:
-                spr->As<CrashSplashParticle>()->Paint(session, image_direction);
-                break;
-            case EntityType::ExplosionFlare:
-                spr->As<ExplosionFlare>()->Paint(session, image_direction);
-                break;
-            case EntityType::JumpingFountain:
-                spr->As<JumpingFountain>()->Paint(session, image_direction);
-                break;
-            case EntityType::Balloon:
-                spr->As<Balloon>()->Paint(session, image_direction);
-                break;
-            case EntityType::Duck:
-                spr->As<Duck>()->Paint(session, image_direction);
-                break;
-            case EntityType::Litter:
-                spr->As<Litter>()->Paint(session, image_direction);
-                break;
-            default:
-                assert(false);
-                break;
+            continue;
         }
+        PaintEntity(session, displaced.Entity, tweener.GetPaintLocation(*displaced.Entity));
     }
 }
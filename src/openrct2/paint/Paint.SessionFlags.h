@@ -15,4 +15,6 @@ namespace OpenRCT2::PaintSessionFlags
 {
     constexpr uint8_t PassedSurface = 1u << 0;
     constexpr uint8_t IsTrackPiecePreview = 1u << 1;
+    // Set by painters whose output changes without the tile being invalidated, so it can not be cached.
+    constexpr uint8_t IsUncacheable = 1u << 2;
 } // namespace OpenRCT2::PaintSessionFlags
@@ -23,6 +23,7 @@
 #include "../util/Prefetch.h"
 #include "Boundbox.h"
 #include "Paint.Entity.h"
+#include "PaintCache.h"
 #include "tile_element/Paint.TileElement.h"
 
 #include <algorithm>
@@ -742,6 +743,11 @@ void PaintSessionFree(PaintSession* session)
 PaintStruct* PaintAddImageAsParent(
     PaintSession& session, const ImageId image_id, const CoordsXYZ& offset, const BoundBoxXYZ& boundBox)
 {
+    if (session.Recorder != nullptr)
+    {
+        return session.Recorder->AddImageAsParent(session, image_id, offset, boundBox);
+    }
+
     session.LastPS = nullptr;
     session.LastAttachedPS = nullptr;
 
@@ -776,6 +782,12 @@ PaintStruct* PaintAddImageAsParent(
 [[nodiscard]] PaintStruct* PaintAddImageAsOrphan(
     PaintSession& session, const ImageId imageId, const CoordsXYZ& offset, const BoundBoxXYZ& boundBox)
 {
+    if (session.Recorder != nullptr)
+    {
+        // The struct is linked in by the caller, which the cache cannot replay.
+        session.Recorder->MarkUncacheable();
+    }
+
     session.LastPS = nullptr;
     session.LastAttachedPS = nullptr;
     return CreateNormalPaintStruct(session, imageId, offset, boundBox);
@@ -801,6 +813,11 @@ PaintStruct* PaintAddImageAsParent(
 PaintStruct* PaintAddImageAsChild(
     PaintSession& session, const ImageId image_id, const CoordsXYZ& offset, const BoundBoxXYZ& boundBox)
 {
+    if (session.Recorder != nullptr)
+    {
+        return session.Recorder->AddImageAsChild(session, image_id, offset, boundBox);
+    }
+
     PaintStruct* parentPS = session.LastPS;
     if (parentPS == nullptr)
     {
@@ -828,6 +845,11 @@ PaintStruct* PaintAddImageAsChild(
  */
 bool PaintAttachToPreviousAttach(PaintSession& session, const ImageId imageId, int32_t x, int32_t y)
 {
+    if (session.Recorder != nullptr)
+    {
+        return session.Recorder->AttachToPreviousAttach(session, imageId, x, y);
+    }
+
     auto* previousAttachedPS = session.LastAttachedPS;
     if (previousAttachedPS == nullptr)
     {
@@ -860,6 +882,11 @@ bool PaintAttachToPreviousAttach(PaintSession& session, const ImageId imageId, i
  */
 bool PaintAttachToPreviousPS(PaintSession& session, const ImageId image_id, int32_t x, int32_t y)
 {
+    if (session.Recorder != nullptr)
+    {
+        return session.Recorder->AttachToPreviousPS(session, image_id, x, y);
+    }
+
     auto* masterPs = session.LastPS;
     if (masterPs == nullptr)
     {
@@ -25,6 +25,11 @@ struct SurfaceElement;
 enum class RailingEntrySupportType : uint8_t;
 enum class ViewportInteractionItem : uint8_t;
 
+namespace OpenRCT2::PaintCache
+{
+    class Recorder;
+}
+
 struct AttachedPaintStruct
 {
     AttachedPaintStruct* NextEntry;
@@ -210,6 +215,10 @@ struct PaintSession : public PaintSessionCore
 {
     DrawPixelInfo DPI;
     PaintEntryPool::Chain PaintEntryChain;
+    // Tile elements are painted through the paint cache.
+    bool UsePaintCache{};
+    // Set while the paint cache records the paint calls made for a tile.
+    OpenRCT2::PaintCache::Recorder* Recorder{};
 
     PaintStruct* AllocateNormalPaintEntry() noexcept
     {
@@ -0,0 +1,542 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "PaintCache.h"
+
+#include "../Diagnostic.h"
+#include "../OpenRCT2.h"
+#include "../drawing/LightFX.h"
+#include "../entity/PatrolArea.h"
+#include "../interface/Viewport.h"
+#include "../profiling/Metrics.h"
+#include "../ride/TrackDesign.h"
+#include "../world/Map.h"
+#include "../world/TileInspector.h"
+#include "Paint.SessionFlags.h"
+#include "Paint.h"
+#include "VirtualFloor.h"
+#include "tile_element/Paint.TileElement.h"
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace OpenRCT2::PaintCache
+{
+    // Recordings are freed all at once when there are more than this, e.g. after looking at many zoom levels.
+    static constexpr size_t kMaxEntries = 1u << 18;
+
+    // The capture session covers the whole map so that no paint call is culled while recording.
+    static constexpr int32_t kCaptureExtent = 1 << 22;
+
+    struct TileRecord
+    {
+        uint32_t Stamp{};
+        uint32_t Epoch{};
+        const TileElement* FirstElement{};
+        bool Uncacheable{};
+        std::vector<PaintOp> Ops;
+    };
+
+    struct CaptureContext
+    {
+        PaintSession Session{};
+        PaintCache::Recorder TileRecorder;
+    };
+
+    static Mode _mode = Mode::Off;
+    static uint32_t _epoch;
+    // Bumped whenever the tile or one of its neighbours is invalidated, indexed by x + y * kMaximumMapSizeTechnical.
+    static std::vector<uint32_t> _tileStamps;
+
+    static std::shared_mutex _entriesMutex;
+    static std::unordered_map<uint64_t, std::shared_ptr<const TileRecord>> _entries;
+
+    // The pool must outlive the capture sessions that rent entries from it.
+    static PaintEntryPool _capturePool;
+    static std::mutex _captureContextsMutex;
+    static std::vector<std::unique_ptr<CaptureContext>> _captureContexts;
+    static thread_local CaptureContext* _captureContext;
+
+    template<typename T> static int32_t FindOpWithState(const std::vector<T*>& states, const T* value)
+    {
+        for (auto i = states.size(); i > 0; i--)
+        {
+            if (states[i - 1] == value)
+                return static_cast<int32_t>(i - 1);
+        }
+        return -1;
+    }
+
+    void Recorder::Reset()
+    {
+        _ops.clear();
+        _lastPS.clear();
+        _lastAttachedPS.clear();
+        _attached.clear();
+        _uncacheable = false;
+    }
+
+    void Recorder::MarkUncacheable()
+    {
+        _uncacheable = true;
+    }
+
+    bool Recorder::IsUncacheable() const
+    {
+        return _uncacheable;
+    }
+
+    void Recorder::RecordRestores(const PaintSession& session)
+    {
+        // Painters sometimes put back the last paint struct after adding an unrelated one, record that as an op of its own.
+        auto* lastPS = _lastPS.empty() ? nullptr : _lastPS.back();
+        auto* lastAttachedPS = _lastAttachedPS.empty() ? nullptr : _lastAttachedPS.back();
+        if (session.LastPS != lastPS)
+        {
+            PaintOp op{};
+            op.Kind = OpKind::RestoreLastPS;
+            op.Target = FindOpWithState(_lastPS, session.LastPS);
+            if (op.Target == -1 && session.LastPS != nullptr)
+                _uncacheable = true;
+
+            _ops.push_back(op);
+            _lastPS.push_back(session.LastPS);
+            _lastAttachedPS.push_back(lastAttachedPS);
+            _attached.push_back(nullptr);
+        }
+        if (session.LastAttachedPS != lastAttachedPS)
+        {
+            PaintOp op{};
+            op.Kind = OpKind::RestoreLastAttachedPS;
+            op.Target = FindOpWithState(_lastAttachedPS, session.LastAttachedPS);
+            if (op.Target == -1 && session.LastAttachedPS != nullptr)
+                _uncacheable = true;
+
+            _ops.push_back(op);
+            _lastPS.push_back(session.LastPS);
+            _lastAttachedPS.push_back(session.LastAttachedPS);
+            _attached.push_back(nullptr);
+        }
+    }
+
+    PaintOp& Recorder::BeginOp(const PaintSession& session, OpKind kind)
+    {
+        RecordRestores(session);
+
+        auto& op = _ops.emplace_back();
+        op.Kind = kind;
+        op.InteractionItem = session.InteractionType;
+        op.SpritePosition = session.SpritePosition;
+        op.MapPosition = session.MapPosition;
+        op.Element = session.CurrentlyDrawnTileElement;
+        return op;
+    }
+
+    void Recorder::EndOp(const PaintSession& session, AttachedPaintStruct* attached)
+    {
+        _lastPS.push_back(session.LastPS);
+        _lastAttachedPS.push_back(session.LastAttachedPS);
+        _attached.push_back(attached);
+    }
+
+    PaintStruct* Recorder::AddImageAsParent(
+        PaintSession& session, ImageId imageId, const CoordsXYZ& offset, const BoundBoxXYZ& boundBox)
+    {
+        auto& op = BeginOp(session, OpKind::AddImageAsParent);
+        op.Image = imageId;
+        op.Offset = offset;
+        op.BoundBox = boundBox;
+
+        session.Recorder = nullptr;
+        auto* ps = PaintAddImageAsParent(session, imageId, offset, boundBox);
+        session.Recorder = this;
+
+        EndOp(session, nullptr);
+        return ps;
+    }
+
+    PaintStruct* Recorder::AddImageAsChild(
+        PaintSession& session, ImageId imageId, const CoordsXYZ& offset, const BoundBoxXYZ& boundBox)
+    {
+        auto& op = BeginOp(session, OpKind::AddImageAsChild);
+        op.Image = imageId;
+        op.Offset = offset;
+        op.BoundBox = boundBox;
+
+        session.Recorder = nullptr;
+        auto* ps = PaintAddImageAsChild(session, imageId, offset, boundBox);
+        session.Recorder = this;
+
+        EndOp(session, nullptr);
+        return ps;
+    }
+
+    bool Recorder::AttachToPreviousPS(PaintSession& session, ImageId imageId, int32_t x, int32_t y)
+    {
+        auto& op = BeginOp(session, OpKind::AttachToPreviousPS);
+        op.Image = imageId;
+        op.Offset = { x, y, 0 };
+
+        session.Recorder = nullptr;
+        const auto result = PaintAttachToPreviousPS(session, imageId, x, y);
+        session.Recorder = this;
+
+        EndOp(session, result ? session.LastAttachedPS : nullptr);
+        return result;
+    }
+
+    bool Recorder::AttachToPreviousAttach(PaintSession& session, ImageId imageId, int32_t x, int32_t y)
+    {
+        auto& op = BeginOp(session, OpKind::AttachToPreviousAttach);
+        op.Image = imageId;
+        op.Offset = { x, y, 0 };
+
+        session.Recorder = nullptr;
+        const auto result = PaintAttachToPreviousAttach(session, imageId, x, y);
+        session.Recorder = this;
+
+        EndOp(session, result ? session.LastAttachedPS : nullptr);
+        return result;
+    }
+
+    std::vector<PaintOp> Recorder::Finish(const PaintSession& session)
+    {
+        RecordRestores(session);
+
+        // The surface painter masks the attached structs it creates.
+        for (size_t i = 0; i < _ops.size(); i++)
+        {
+            if (_attached[i] != nullptr)
+            {
+                _ops[i].ColourImageId = _attached[i]->ColourImageId;
+                _ops[i].IsMasked = _attached[i]->IsMasked;
+            }
+        }
+        return std::vector<PaintOp>(_ops.begin(), _ops.end());
+    }
+
+    Mode GetMode()
+    {
+        return _mode;
+    }
+
+    void SetMode(Mode mode)
+    {
+        if (mode != Mode::Off && _tileStamps.empty())
+        {
+            _tileStamps.resize(kMaximumMapSizeTechnical * kMaximumMapSizeTechnical);
+        }
+        _mode = mode;
+        InvalidateAll();
+    }
+
+    bool IsUsable(uint32_t viewFlags)
+    {
+        if (_mode == Mode::Off)
+            return false;
+
+        if (viewFlags & VIEWPORT_FLAG_CLIP_VIEW)
+            return false;
+
+        if ((gScreenFlags & SCREEN_FLAGS_EDITOR) || gTrackDesignSaveMode)
+            return false;
+
+        // Tool selections, arrows and patrol areas are painted on top of the tiles they cover.
+        if (gMapSelectFlags != 0)
+            return false;
+
+        const auto patrolAreaToRender = GetPatrolAreaToRender();
+        const auto* staffId = std::get_if<EntityId>(&patrolAreaToRender);
+        if (staffId == nullptr || !staffId->IsNull())
+            return false;
+
+        if (VirtualFloorIsEnabled() || OpenRCT2::TileInspector::GetSelectedElement() != nullptr)
+            return false;
+
+        if (gShowSupportSegmentHeights || gPaintBlockedTiles || gPaintWidePathsAsGhost)
+            return false;
+
+        // Painting tile elements adds the lights as a side effect.
+        if (LightFXIsAvailable())
+            return false;
+
+        return true;
+    }
+
+    void InvalidateTile(const CoordsXY& mapPos)
+    {
+        if (_tileStamps.empty())
+            return;
+
+        const auto tilePos = TileCoordsXY(mapPos);
+        for (int32_t y = tilePos.y - 1; y <= tilePos.y + 1; y++)
+        {
+            for (int32_t x = tilePos.x - 1; x <= tilePos.x + 1; x++)
+            {
+                if (x >= 0 && y >= 0 && x < kMaximumMapSizeTechnical && y < kMaximumMapSizeTechnical)
+                {
+                    _tileStamps[x + y * kMaximumMapSizeTechnical]++;
+                }
+            }
+        }
+    }
+
+    void InvalidateRegion(const CoordsXY& mins, const CoordsXY& maxs)
+    {
+        if (_tileStamps.empty())
+            return;
+
+        const auto tileMin = TileCoordsXY(mins);
+        const auto tileMax = TileCoordsXY(maxs);
+        const auto minX = std::max(tileMin.x - 1, 0);
+        const auto minY = std::max(tileMin.y - 1, 0);
+        const auto maxX = std::min(tileMax.x + 1, kMaximumMapSizeTechnical - 1);
+        const auto maxY = std::min(tileMax.y + 1, kMaximumMapSizeTechnical - 1);
+        for (int32_t y = minY; y <= maxY; y++)
+        {
+            for (int32_t x = minX; x <= maxX; x++)
+            {
+                _tileStamps[x + y * kMaximumMapSizeTechnical]++;
+            }
+        }
+    }
+
+    void InvalidateAll()
+    {
+        _epoch++;
+
+        std::unique_lock lock(_entriesMutex);
+        _entries.clear();
+    }
+
+    void Trim()
+    {
+        static auto& entriesMetric = Metrics::GetGauge("paint.cache.entries");
+
+        std::unique_lock lock(_entriesMutex);
+        if (_entries.size() > kMaxEntries)
+        {
+            _entries.clear();
+        }
+        entriesMetric.Set(static_cast<double>(_entries.size()));
+    }
+
+    static CaptureContext& GetCaptureContext()
+    {
+        if (_captureContext == nullptr)
+        {
+            auto context = std::make_unique<CaptureContext>();
+            context->Session.PaintEntryChain = _capturePool.Create();
+            _captureContext = context.get();
+
+            std::scoped_lock lock(_captureContextsMutex);
+            _captureContexts.push_back(std::move(context));
+        }
+        return *_captureContext;
+    }
+
+    static void PrepareCaptureSession(PaintSession& capture, const PaintSession& session)
+    {
+        capture.DPI = {};
+        capture.DPI.x = -kCaptureExtent;
+        capture.DPI.y = -kCaptureExtent;
+        capture.DPI.width = 2 * kCaptureExtent;
+        capture.DPI.height = 2 * kCaptureExtent;
+        capture.DPI.zoom_level = session.DPI.zoom_level;
+
+        capture.PaintHead = nullptr;
+        capture.LastPS = nullptr;
+        capture.LastAttachedPS = nullptr;
+        capture.PSStringHead = nullptr;
+        capture.LastPSString = nullptr;
+        capture.WoodenSupportsPrependTo = nullptr;
+        capture.QuadrantBackIndex = std::numeric_limits<uint32_t>::max();
+        capture.QuadrantFrontIndex = 0;
+
+        capture.Surface = session.Surface;
+        capture.CurrentlyDrawnEntity = session.CurrentlyDrawnEntity;
+        capture.CurrentlyDrawnTileElement = session.CurrentlyDrawnTileElement;
+        capture.PathElementOnSameHeight = session.PathElementOnSameHeight;
+        capture.TrackElementOnSameHeight = session.TrackElementOnSameHeight;
+        capture.SelectedElement = session.SelectedElement;
+        capture.SpritePosition = session.SpritePosition;
+        capture.MapPosition = session.MapPosition;
+        capture.ViewFlags = session.ViewFlags;
+        capture.TrackColours = session.TrackColours;
+        capture.SupportColours = session.SupportColours;
+        std::copy(std::begin(session.SupportSegments), std::end(session.SupportSegments), std::begin(capture.SupportSegments));
+        capture.Support = session.Support;
+        capture.WaterHeight = session.WaterHeight;
+        std::copy(std::begin(session.LeftTunnels), std::end(session.LeftTunnels), std::begin(capture.LeftTunnels));
+        std::copy(std::begin(session.RightTunnels), std::end(session.RightTunnels), std::begin(capture.RightTunnels));
+        capture.LeftTunnelCount = session.LeftTunnelCount;
+        capture.RightTunnelCount = session.RightTunnelCount;
+        capture.VerticalTunnelHeight = session.VerticalTunnelHeight;
+        capture.CurrentRotation = session.CurrentRotation;
+        // Whether the tile is uncacheable is found out by painting it, an earlier tile does not decide it.
+        capture.Flags = session.Flags & ~PaintSessionFlags::IsUncacheable;
+        capture.InteractionType = session.InteractionType;
+    }
+
+    static std::shared_ptr<const TileRecord> Capture(
+        PaintSession& session, TileElement* firstElement, TilePaintFunc paintFunc, uint32_t stamp)
+    {
+        auto& context = GetCaptureContext();
+        auto& capture = context.Session;
+        PrepareCaptureSession(capture, session);
+
+        context.TileRecorder.Reset();
+        capture.Recorder = &context.TileRecorder;
+        paintFunc(capture, firstElement);
+        capture.Recorder = nullptr;
+
+        auto record = std::make_shared<TileRecord>();
+        record->Stamp = stamp;
+        record->Epoch = _epoch;
+        record->FirstElement = firstElement;
+        record->Uncacheable = context.TileRecorder.IsUncacheable() || (capture.Flags & PaintSessionFlags::IsUncacheable);
+        if (!record->Uncacheable)
+        {
+            record->Ops = context.TileRecorder.Finish(capture);
+        }
+
+        capture.PaintEntryChain.Clear();
+        return record;
+    }
+
+    static void Replay(PaintSession& session, const std::vector<PaintOp>& ops)
+    {
+        // The paint structs each op left as the last ones, for the restore ops.
+        thread_local std::vector<PaintStruct*> lastPS;
+        thread_local std::vector<AttachedPaintStruct*> lastAttachedPS;
+        lastPS.resize(ops.size());
+        lastAttachedPS.resize(ops.size());
+
+        auto* const startPS = session.LastPS;
+        auto* const startAttachedPS = session.LastAttachedPS;
+        const auto mapPosition = session.MapPosition;
+        for (size_t i = 0; i < ops.size(); i++)
+        {
+            const auto& op = ops[i];
+            switch (op.Kind)
+            {
+                case OpKind::AddImageAsParent:
+                case OpKind::AddImageAsChild:
+                    session.SpritePosition = op.SpritePosition;
+                    session.MapPosition = op.MapPosition;
+                    session.InteractionType = op.InteractionItem;
+                    session.CurrentlyDrawnTileElement = op.Element;
+                    if (op.Kind == OpKind::AddImageAsParent)
+                        PaintAddImageAsParent(session, op.Image, op.Offset, op.BoundBox);
+                    else
+                        PaintAddImageAsChild(session, op.Image, op.Offset, op.BoundBox);
+                    break;
+                case OpKind::AttachToPreviousPS:
+                case OpKind::AttachToPreviousAttach:
+                {
+                    const auto attached = op.Kind == OpKind::AttachToPreviousPS
+                        ? PaintAttachToPreviousPS(session, op.Image, op.Offset.x, op.Offset.y)
+                        : PaintAttachToPreviousAttach(session, op.Image, op.Offset.x, op.Offset.y);
+                    if (attached)
+                    {
+                        session.LastAttachedPS->ColourImageId = op.ColourImageId;
+                        session.LastAttachedPS->IsMasked = op.IsMasked;
+                    }
+                    break;
+                }
+                case OpKind::RestoreLastPS:
+                    session.LastPS = op.Target == -1 ? startPS : lastPS[op.Target];
+                    break;
+                case OpKind::RestoreLastAttachedPS:
+                    session.LastAttachedPS = op.Target == -1 ? startAttachedPS : lastAttachedPS[op.Target];
+                    break;
+            }
+            lastPS[i] = session.LastPS;
+            lastAttachedPS[i] = session.LastAttachedPS;
+        }
+        session.MapPosition = mapPosition;
+    }
+
+    // Paints the tile into the session itself, without letting it mark the following tiles as uncacheable.
+    static void PaintUncached(PaintSession& session, TileElement* firstElement, TilePaintFunc paintFunc)
+    {
+        const uint8_t uncacheable = session.Flags & PaintSessionFlags::IsUncacheable;
+        paintFunc(session, firstElement);
+        session.Flags = (session.Flags & ~PaintSessionFlags::IsUncacheable) | uncacheable;
+    }
+
+    void PaintTile(PaintSession& session, TileElement* firstElement, TilePaintFunc paintFunc)
+    {
+        static auto& hits = Metrics::GetCounter("paint.cache.hits");
+        static auto& misses = Metrics::GetCounter("paint.cache.misses");
+        static auto& uncacheable = Metrics::GetCounter("paint.cache.uncacheable");
+
+        const auto tilePos = TileCoordsXY(session.MapPosition);
+        if (_tileStamps.empty() || tilePos.x < 0 || tilePos.y < 0 || tilePos.x >= kMaximumMapSizeTechnical
+            || tilePos.y >= kMaximumMapSizeTechnical)
+        {
+            PaintUncached(session, firstElement, paintFunc);
+            return;
+        }
+
+        const auto tileIndex = static_cast<uint32_t>(tilePos.x + tilePos.y * kMaximumMapSizeTechnical);
+        const auto zoom = static_cast<uint64_t>(static_cast<int8_t>(session.DPI.zoom_level) + 8) & 0xF;
+        const auto key = (static_cast<uint64_t>(session.ViewFlags) << 32) | (zoom << 22)
+            | (static_cast<uint64_t>(session.CurrentRotation & 3) << 20) | tileIndex;
+        const auto stamp = _tileStamps[tileIndex];
+
+        std::shared_ptr<const TileRecord> record;
+        {
+            std::shared_lock lock(_entriesMutex);
+            auto it = _entries.find(key);
+            if (it != _entries.end() && it->second->Stamp == stamp && it->second->Epoch == _epoch
+                && it->second->FirstElement == firstElement)
+            {
+                record = it->second;
+            }
+        }
+
+        if (record != nullptr)
+        {
+            hits.Add();
+        }
+        else
+        {
+            misses.Add();
+            record = Capture(session, firstElement, paintFunc, stamp);
+
+            std::unique_lock lock(_entriesMutex);
+            _entries[key] = record;
+        }
+
+        if (record->Uncacheable)
+        {
+            uncacheable.Add();
+            PaintUncached(session, firstElement, paintFunc);
+            return;
+        }
+        Replay(session, record->Ops);
+    }
+
+    void ReportComparison(size_t differingPixels, size_t totalPixels)
+    {
+        static auto& mismatchedPixels = Metrics::GetCounter("paint.cache.mismatched_pixels");
+
+        mismatchedPixels.Add(differingPixels);
+        if (differingPixels != 0)
+        {
+            LOG_WARNING("Paint cache: %zu of %zu pixels differ from the uncached paint", differingPixels, totalPixels);
+        }
+    }
+
+} // namespace OpenRCT2::PaintCache
@@ -0,0 +1,131 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../drawing/ImageId.hpp"
+#include "../world/Location.hpp"
+#include "Boundbox.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct AttachedPaintStruct;
+struct PaintSession;
+struct PaintStruct;
+struct TileElement;
+enum class ViewportInteractionItem : uint8_t;
+
+/**
+ * A retained cache of the paint calls made for the tile elements of each tile.
+ *
+ * The first time a tile is painted its painters run against a capture session that does not cull anything,
+ * and every paint call they make is recorded. Later frames replay the recorded calls into the real session,
+ * which culls them against its own DPI exactly as the painters would have, instead of running the painters again.
+ * Entities are never cached.
+ *
+ * A recording is keyed by tile, rotation, zoom and viewport flags, and is dropped when the tile or one of its
+ * neighbours is invalidated through the MapInvalidate functions, which tile element changes and map animations
+ * already call so the dirty area is redrawn. Tiles whose painting depends on anything else (the current tick,
+ * scrolling text, ride and vehicle state) are marked as uncacheable and painted normally every frame.
+ */
+namespace OpenRCT2::PaintCache
+{
+    enum class Mode : uint8_t
+    {
+        Off,
+        On,
+        // Paints every viewport twice, with and without the cache, and reports the pixels that differ.
+        Compare,
+    };
+
+    enum class OpKind : uint8_t
+    {
+        AddImageAsParent,
+        AddImageAsChild,
+        AttachToPreviousPS,
+        AttachToPreviousAttach,
+        RestoreLastPS,
+        RestoreLastAttachedPS,
+    };
+
+    struct PaintOp
+    {
+        OpKind Kind{};
+        ViewportInteractionItem InteractionItem{};
+        bool IsMasked{};
+        // For the restore ops, the op after which the restored value was current, or -1 for the value the tile started with.
+        int32_t Target{};
+        ImageId Image{};
+        ImageId ColourImageId{};
+        CoordsXYZ Offset{};
+        BoundBoxXYZ BoundBox{};
+        CoordsXY SpritePosition{};
+        CoordsXY MapPosition{};
+        TileElement* Element{};
+    };
+
+    /**
+     * Records the paint calls made on a capture session. The paint functions hand their call over to the recorder
+     * when the session has one, which runs the call without the recorder and notes its effect on the session.
+     */
+    class Recorder
+    {
+        std::vector<PaintOp> _ops;
+        std::vector<PaintStruct*> _lastPS;
+        std::vector<AttachedPaintStruct*> _lastAttachedPS;
+        std::vector<AttachedPaintStruct*> _attached;
+        bool _uncacheable{};
+
+        PaintOp& BeginOp(const PaintSession& session, OpKind kind);
+        void EndOp(const PaintSession& session, AttachedPaintStruct* attached);
+        void RecordRestores(const PaintSession& session);
+
+    public:
+        void Reset();
+        void MarkUncacheable();
+        bool IsUncacheable() const;
+
+        PaintStruct* AddImageAsParent(
+            PaintSession& session, ImageId imageId, const CoordsXYZ& offset, const BoundBoxXYZ& boundBox);
+        PaintStruct* AddImageAsChild(
+            PaintSession& session, ImageId imageId, const CoordsXYZ& offset, const BoundBoxXYZ& boundBox);
+        bool AttachToPreviousPS(PaintSession& session, ImageId imageId, int32_t x, int32_t y);
+        bool AttachToPreviousAttach(PaintSession& session, ImageId imageId, int32_t x, int32_t y);
+
+        // Completes the recording, picking up changes the painters made to the structs after creating them.
+        std::vector<PaintOp> Finish(const PaintSession& session);
+    };
+
+    Mode GetMode();
+    void SetMode(Mode mode);
+
+    // Whether a viewport with the given flags can be painted from the cache, i.e. nothing is drawn over the
+    // tiles that depends on tools, selections or debug options.
+    bool IsUsable(uint32_t viewFlags);
+
+    // Drops the recordings of the tile and of its neighbours, which some painters look at.
+    void InvalidateTile(const CoordsXY& mapPos);
+    void InvalidateRegion(const CoordsXY& mins, const CoordsXY& maxs);
+    // Drops every recording, e.g. after loading a park or changing a setting that affects painting.
+    void InvalidateAll();
+
+    // Frees the recordings when there are too many of them. Must not be called while painting.
+    void Trim();
+
+    using TilePaintFunc = void (*)(PaintSession& session, TileElement* firstElement);
+
+    // Paints the tile elements of session.MapPosition by replaying its recording, capturing one with paintFunc first
+    // when there is no up to date recording.
+    void PaintTile(PaintSession& session, TileElement* firstElement, TilePaintFunc paintFunc);
+
+    void ReportComparison(size_t differingPixels, size_t totalPixels);
+
+} // namespace OpenRCT2::PaintCache
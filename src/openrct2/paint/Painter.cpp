@@ -175,6 +175,8 @@ PaintSession* Painter::CreateSession(DrawPixelInfo& dpi, uint32_t viewFlags, uin
     session->QuadrantBackIndex = std::numeric_limits<uint32_t>::max();
     session->QuadrantFrontIndex = 0;
     session->PaintEntryChain = _paintStructPool.Create();
+    session->UsePaintCache = false;
+    session->Recorder = nullptr;
     session->Flags = 0;
     session->CurrentRotation = rotation;
 
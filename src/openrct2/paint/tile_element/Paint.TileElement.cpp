@@ -29,6 +29,7 @@
 #include "../../world/tile_element/Slope.h"
 #include "../Paint.SessionFlags.h"
 #include "../Paint.h"
+#include "../PaintCache.h"
 #include "../VirtualFloor.h"
 #include "Paint.Surface.h"
 #include "Segment.h"
@@ -37,6 +38,7 @@ using namespace OpenRCT2;
 
 static void BlankTilesPaint(PaintSession& session, int32_t x, int32_t y);
 static void PaintTileElementBase(PaintSession& session, const CoordsXY& origCoords);
+static void PaintTileElements(PaintSession& session, TileElement* tile_element);
 
 /**
  *
@@ -210,6 +212,67 @@ static void PaintTileElementBase(PaintSession& session, const CoordsXY& origCoor
     session.SpritePosition.y = coords.y;
     session.Flags &= ~PaintSessionFlags::PassedSurface;
 
+    if (session.UsePaintCache)
+    {
+        PaintCache::PaintTile(session, tile_element, PaintTileElements);
+    }
+    else
+    {
+        PaintTileElements(session, tile_element);
+    }
+
+    if (Config::Get().general.VirtualFloorStyle != VirtualFloorStyles::Off && partOfVirtualFloor)
+    {
+        VirtualFloorPaint(session);
+    }
+
+    if (!gShowSupportSegmentHeights)
+    {
+        return;
+    }
+
+    if (element->GetType() == TileElementType::Surface)
+    {
+        return;
+    }
+
+    static constexpr int32_t segmentPositions[][3] = {
+        { 0, 6, 2 },
+        { 5, 4, 8 },
+        { 1, 7, 3 },
+    };
+
+    for (std::size_t sy = 0; sy < std::size(segmentPositions); sy++)
+    {
+        for (std::size_t sx = 0; sx < std::size(segmentPositions[sy]); sx++)
+        {
+            uint16_t segmentHeight = session.SupportSegments[segmentPositions[sy][sx]].height;
+            auto imageColourFlats = ImageId(SPR_LAND_TOOL_SIZE_1).WithTransparency(FilterPaletteID::PaletteGlassBlack);
+            if (segmentHeight == 0xFFFF)
+            {
+                segmentHeight = session.Support.height;
+                // white: 0b101101
+                imageColourFlats = ImageId(SPR_LAND_TOOL_SIZE_1)
+                                       .WithTransparency(FilterPaletteID::PaletteTranslucentBordeauxRedHighlight);
+            }
+
+            // Only draw supports below the clipping height.
+            if ((session.ViewFlags & VIEWPORT_FLAG_CLIP_VIEW) && (segmentHeight > gClipHeight))
+                continue;
+
+            int32_t xOffset = static_cast<int32_t>(sy) * 10;
+            int32_t yOffset = -22 + static_cast<int32_t>(sx) * 10;
+            PaintAddImageAsParent(
+                session, imageColourFlats, { xOffset, yOffset, segmentHeight },
+                { { xOffset + 1, yOffset + 16, segmentHeight }, { 10, 10, 1 } });
+        }
+    }
+}
+
+// Runs the painters of every element on the tile, tile_element being the first one.
+static void PaintTileElements(PaintSession& session, TileElement* tile_element)
+{
+    uint8_t rotation = session.CurrentRotation;
     int32_t previousBaseZ = 0;
     do
     {
@@ -284,53 +347,6 @@ static void PaintTileElementBase(PaintSession& session, const CoordsXY& origCoor
         }
         session.MapPosition = mapPosition;
     } while (!(tile_element++)->IsLastForTile());
-
-    if (Config::Get().general.VirtualFloorStyle != VirtualFloorStyles::Off && partOfVirtualFloor)
-    {
-        VirtualFloorPaint(session);
-    }
-
-    if (!gShowSupportSegmentHeights)
-    {
-        return;
-    }
-
-    if ((tile_element - 1)->GetType() == TileElementType::Surface)
-    {
-        return;
-    }
-
-    static constexpr int32_t segmentPositions[][3] = {
-        { 0, 6, 2 },
-        { 5, 4, 8 },
-        { 1, 7, 3 },
-    };
-
-    for (std::size_t sy = 0; sy < std::size(segmentPositions); sy++)
-    {
-        for (std::size_t sx = 0; sx < std::size(segmentPositions[sy]); sx++)
-        {
-            uint16_t segmentHeight = session.SupportSegments[segmentPositions[sy][sx]].height;
-            auto imageColourFlats = ImageId(SPR_LAND_TOOL_SIZE_1).WithTransparency(FilterPaletteID::PaletteGlassBlack);
-            if (segmentHeight == 0xFFFF)
-            {
-                segmentHeight = session.Support.height;
-                // white: 0b101101
-                imageColourFlats = ImageId(SPR_LAND_TOOL_SIZE_1)
-                                       .WithTransparency(FilterPaletteID::PaletteTranslucentBordeauxRedHighlight);
-            }
-
-            // Only draw supports below the clipping height.
-            if ((session.ViewFlags & VIEWPORT_FLAG_CLIP_VIEW) && (segmentHeight > gClipHeight))
-                continue;
-
-            int32_t xOffset = static_cast<int32_t>(sy) * 10;
-            int32_t yOffset = -22 + static_cast<int32_t>(sx) * 10;
-            PaintAddImageAsParent(
-                session, imageColourFlats, { xOffset, yOffset, segmentHeight },
-                { { xOffset + 1, yOffset + 16, segmentHeight }, { 10, 10, 1 } });
-        }
-    }
 }
 
 void PaintUtilSetGeneralSupportHeight(PaintSession& session, int16_t height)
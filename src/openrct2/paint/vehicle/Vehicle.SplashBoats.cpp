@@ -10,6 +10,7 @@
 #include "../../ride/Vehicle.h"
 
 #include "../../entity/EntityRegistry.h"
+#include "../../entity/EntityTweener.h"
 #include "../../ride/Ride.h"
 #include "../Paint.h"
 #include "VehiclePaint.h"
@@ -36,8 +37,9 @@ namespace OpenRCT2
         session.CurrentlyDrawnEntity = vehicleToPaint;
         imageDirection = OpenRCT2::Entity::Yaw::Add(
             OpenRCT2::Entity::Yaw::YawFrom4(session.CurrentRotation), vehicleToPaint->Orientation);
-        session.SpritePosition.x = vehicleToPaint->x;
-        session.SpritePosition.y = vehicleToPaint->y;
-        vehicleToPaint->Paint(session, imageDirection);
+        const auto paintLocation = EntityTweener::Get().GetPaintLocation(*vehicleToPaint);
+        session.SpritePosition.x = paintLocation.x;
+        session.SpritePosition.y = paintLocation.y;
+        vehicleToPaint->Paint(session, imageDirection, paintLocation);
     }
 } // namespace OpenRCT2
@@ -3960,14 +3960,15 @@ void VehicleVisualDefault(
     }
 }
 
-void Vehicle::Paint(PaintSession& session, int32_t imageDirection) const
+void Vehicle::Paint(PaintSession& session, int32_t imageDirection, const CoordsXYZ& location) const
 {
     const CarEntry* carEntry;
 
     if (HasFlag(VehicleFlags::Crashed))
     {
         PaintAddImageAsParent(
-            session, ImageId(SPR_WATER_PARTICLES_DENSE_0 + animation_frame), { 0, 0, z }, { { 0, 0, z + 2 }, { 1, 1, 0 } });
+            session, ImageId(SPR_WATER_PARTICLES_DENSE_0 + animation_frame), { 0, 0, location.z },
+            { { 0, 0, location.z + 2 }, { 1, 1, 0 } });
         return;
     }
 
@@ -4001,37 +4002,40 @@ void Vehicle::Paint(PaintSession& session, int32_t imageDirection) const
     switch (carEntry->PaintStyle)
     {
         case VEHICLE_VISUAL_DEFAULT:
-            VehicleVisualDefault(session, imageDirection, z + zOffset, this, carEntry);
+            VehicleVisualDefault(session, imageDirection, location.z + zOffset, this, carEntry);
             break;
         case VEHICLE_VISUAL_LAUNCHED_FREEFALL:
-            VehicleVisualLaunchedFreefall(session, x, imageDirection, y, z + zOffset, this, carEntry);
+            VehicleVisualLaunchedFreefall(
+                session, location.x, imageDirection, location.y, location.z + zOffset, this, carEntry);
             break;
         case VEHICLE_VISUAL_OBSERVATION_TOWER:
-            VehicleVisualObservationTower(session, x, imageDirection, y, z + zOffset, this, carEntry);
+            VehicleVisualObservationTower(
+                session, location.x, imageDirection, location.y, location.z + zOffset, this, carEntry);
             break;
         case VEHICLE_VISUAL_RIVER_RAPIDS:
-            VehicleVisualRiverRapids(session, x, imageDirection, y, z + zOffset, this, carEntry);
+            VehicleVisualRiverRapids(session, location.x, imageDirection, location.y, location.z + zOffset, this, carEntry);
             break;
         case VEHICLE_VISUAL_MINI_GOLF_PLAYER:
-            VehicleVisualMiniGolfPlayer(session, x, imageDirection, y, z + zOffset, this);
+            VehicleVisualMiniGolfPlayer(session, location.x, imageDirection, location.y, location.z + zOffset, this);
             break;
         case VEHICLE_VISUAL_MINI_GOLF_BALL:
-            VehicleVisualMiniGolfBall(session, x, imageDirection, y, z + zOffset, this);
+            VehicleVisualMiniGolfBall(session, location.x, imageDirection, location.y, location.z + zOffset, this);
             break;
         case VEHICLE_VISUAL_REVERSER:
-            VehicleVisualReverser(session, x, imageDirection, y, z + zOffset, this, carEntry);
+            VehicleVisualReverser(session, location.x, imageDirection, location.y, location.z + zOffset, this, carEntry);
             break;
         case VEHICLE_VISUAL_SPLASH_BOATS_OR_WATER_COASTER:
-            VehicleVisualSplashBoatsOrWaterCoaster(session, x, imageDirection, y, z + zOffset, this, carEntry);
+            VehicleVisualSplashBoatsOrWaterCoaster(
+                session, location.x, imageDirection, location.y, location.z + zOffset, this, carEntry);
             break;
         case VEHICLE_VISUAL_ROTO_DROP:
-            VehicleVisualRotoDrop(session, x, imageDirection, y, z + zOffset, this, carEntry);
+            VehicleVisualRotoDrop(session, location.x, imageDirection, location.y, location.z + zOffset, this, carEntry);
             break;
         case VEHICLE_VISUAL_VIRGINIA_REEL:
-            VehicleVisualVirginiaReel(session, x, imageDirection, y, z + zOffset, this, carEntry);
+            VehicleVisualVirginiaReel(session, location.x, imageDirection, location.y, location.z + zOffset, this, carEntry);
             break;
         case VEHICLE_VISUAL_SUBMARINE:
-            VehicleVisualSubmarine(session, x, imageDirection, y, z + zOffset, this, carEntry);
+            VehicleVisualSubmarine(session, location.x, imageDirection, location.y, location.z + zOffset, this, carEntry);
             break;
     }
 }
@@ -17,6 +17,7 @@
 #include "../OpenRCT2.h"
 #include "../ParkImporter.h"
 #include "../Version.h"
+#include "../config/Config.h"
 #include "../core/Console.hpp"
 #include "../core/Crypt.h"
 #include "../core/DataSerialiser.h"
@@ -44,6 +45,7 @@
 #include "../object/Object.h"
 #include "../object/ObjectManager.h"
 #include "../object/ObjectRepository.h"
+#include "../object/ObjectStore.h"
 #include "../peep/RideUseSystem.h"
 #include "../ride/ShopItem.h"
 #include "../ride/Vehicle.h"
@@ -101,6 +103,8 @@ namespace OpenRCT2
     public:
         ObjectList RequiredObjects;
         std::vector<const ObjectRepositoryItem*> ExportObjectsList;
+        // Write the packed objects to the object store and only reference them by hash.
+        bool ReferencePackedObjects{};
         bool OmitTracklessRides{};
 
     private:
@@ -687,6 +691,7 @@ namespace OpenRCT2
         {
             static constexpr uint8_t DESCRIPTOR_DAT = 0;
             static constexpr uint8_t DESCRIPTOR_PARKOBJ = 1;
+            static constexpr uint8_t DESCRIPTOR_STORED = 2;
 
             if (os.GetMode() == OrcaStream::Mode::WRITING && ExportObjectsList.size() == 0)
             {
@@ -694,7 +699,7 @@ namespace OpenRCT2
                 return;
             }
 
-            os.ReadWriteChunk(ParkFileChunkType::PACKED_OBJECTS, [this](OrcaStream::ChunkStream& cs) {
+            os.ReadWriteChunk(ParkFileChunkType::PACKED_OBJECTS, [this, &os](OrcaStream::ChunkStream& cs) {
                 if (cs.GetMode() == OrcaStream::Mode::READING)
                 {
                     auto& objRepository = GetContext()->GetObjectRepository();
@@ -702,38 +707,59 @@ namespace OpenRCT2
                     for (uint32_t i = 0; i < numObjects; i++)
                     {
                         auto type = cs.Read<uint8_t>();
+                        auto isStored = type == DESCRIPTOR_STORED;
+                        if (isStored)
+                        {
+                            type = cs.Read<uint8_t>();
+                        }
+
+                        RCTObjectEntry entry{};
+                        std::string identifier;
                         if (type == DESCRIPTOR_DAT)
                         {
-                            RCTObjectEntry entry;
                             cs.Read(&entry, sizeof(entry));
-                            auto size = cs.Read<uint32_t>();
-                            std::vector<uint8_t> data;
-                            data.resize(size);
-                            cs.Read(data.data(), data.size());
+                            identifier = entry.GetName();
+                        }
+                        else if (type == DESCRIPTOR_PARKOBJ)
+                        {
+                            identifier = cs.Read<std::string>();
+                        }
+                        else
+                        {
+                            throw std::runtime_error("Unsupported packed object");
+                        }
 
-                            auto legacyIdentifier = entry.GetName();
-                            if (objRepository.FindObjectLegacy(legacyIdentifier) == nullptr)
+                        std::vector<uint8_t> data;
+                        if (isStored)
+                        {
+                            ObjectStore::Hash hash;
+                            cs.Read(hash.data(), hash.size());
+                            if (IsPackedObjectInRepository(objRepository, type == DESCRIPTOR_DAT, identifier))
+                            {
+                                continue;
+                            }
+
+                            auto storedData = ObjectStore::Read(hash);
+                            if (!storedData.has_value())
                             {
-                                objRepository.AddObjectFromFile(
-                                    ObjectGeneration::DAT, legacyIdentifier, data.data(), data.size());
+                                LOG_WARNING("Packed object '%s' is not in the object store.", identifier.c_str());
+                                continue;
                             }
+                            data = std::move(*storedData);
                         }
-                        else if (type == DESCRIPTOR_PARKOBJ)
+                        else
                         {
-                            auto identifier = cs.Read<std::string>();
                             auto size = cs.Read<uint32_t>();
-                            std::vector<uint8_t> data;
                             data.resize(size);
                             cs.Read(data.data(), data.size());
-                            if (objRepository.FindObject(identifier) == nullptr)
+                            if (IsPackedObjectInRepository(objRepository, type == DESCRIPTOR_DAT, identifier))
                             {
-                                objRepository.AddObjectFromFile(ObjectGeneration::JSON, identifier, data.data(), data.size());
+                                continue;
                             }
                         }
-                        else
-                        {
-                            throw std::runtime_error("Unsupported packed object");
-                        }
+
+                        auto generation = type == DESCRIPTOR_DAT ? ObjectGeneration::DAT : ObjectGeneration::JSON;
+                        objRepository.AddObjectFromFile(generation, identifier, data.data(), data.size());
                     }
                 }
                 else
@@ -748,16 +774,15 @@ namespace OpenRCT2
                     // Write objects
                     for (const auto* ori : ExportObjectsList)
                     {
+                        uint8_t type;
                         auto extension = Path::GetExtension(ori->Path);
                         if (String::IEquals(extension, ".dat"))
                         {
-                            cs.Write(DESCRIPTOR_DAT);
-                            cs.Write(&ori->ObjectEntry, sizeof(RCTObjectEntry));
+                            type = DESCRIPTOR_DAT;
                         }
                         else if (String::IEquals(extension, ".parkobj"))
                         {
-                            cs.Write(DESCRIPTOR_PARKOBJ);
-                            cs.Write(ori->Identifier);
+                            type = DESCRIPTOR_PARKOBJ;
                         }
                         else
                         {
@@ -765,9 +790,39 @@ namespace OpenRCT2
                             continue;
                         }
 
-                        auto data = File::ReadAllBytes(ori->Path);
-                        cs.Write<uint32_t>(static_cast<uint32_t>(data.size()));
-                        cs.Write(data.data(), data.size());
+                        // Objects that cannot be stored are embedded instead.
+                        std::optional<ObjectStore::Hash> hash;
+                        if (ReferencePackedObjects)
+                        {
+                            hash = ObjectStore::AddFile(ori->Path);
+                        }
+
+                        if (hash.has_value())
+                        {
+                            cs.Write(DESCRIPTOR_STORED);
+                        }
+                        cs.Write(type);
+                        if (type == DESCRIPTOR_DAT)
+                        {
+                            cs.Write(&ori->ObjectEntry, sizeof(RCTObjectEntry));
+                        }
+                        else
+                        {
+                            cs.Write(ori->Identifier);
+                        }
+
+                        if (hash.has_value())
+                        {
+                            cs.Write(hash->data(), hash->size());
+                            auto& header = os.GetHeader();
+                            header.MinVersion = std::max<uint32_t>(header.MinVersion, kObjectStoreVersion);
+                        }
+                        else
+                        {
+                            auto data = File::ReadAllBytes(ori->Path);
+                            cs.Write<uint32_t>(static_cast<uint32_t>(data.size()));
+                            cs.Write(data.data(), data.size());
+                        }
                         count++;
                     }
 
@@ -779,6 +834,16 @@ namespace OpenRCT2
             });
         }
 
+        static bool IsPackedObjectInRepository(
+            const IObjectRepository& objRepository, bool isLegacy, const std::string& identifier)
+        {
+            if (isLegacy)
+            {
+                return objRepository.FindObjectLegacy(identifier) != nullptr;
+            }
+            return objRepository.FindObject(identifier) != nullptr;
+        }
+
         void ReadWriteClimateChunk(GameState_t& gameState, OrcaStream& os)
         {
             os.ReadWriteChunk(ParkFileChunkType::CLIMATE, [&gameState](OrcaStream::ChunkStream& cs) {
@@ -2568,6 +2633,7 @@ namespace OpenRCT2
 void ParkFileExporter::Export(GameState_t& gameState, std::string_view path)
 {
     auto parkFile = std::make_unique<OpenRCT2::ParkFile>();
+    parkFile->ExportObjectsList = ExportObjectsList;
     parkFile->Save(gameState, path);
 }
 
@@ -2608,7 +2674,15 @@ int32_t ScenarioSave(GameState_t& gameState, u8string_view path, int32_t flags)
     auto parkFile = std::make_unique<OpenRCT2::ParkFile>();
     try
     {
-        if (flags & S6_SAVE_FLAG_EXPORT)
+        if (Config::Get().general.UseObjectStore && !(flags & S6_SAVE_FLAG_SCENARIO))
+        {
+            // Saved games, including autosaves, reference all of their custom objects in the object store. Scenarios
+            // are made to be shared, so they keep embedding them.
+            auto& objManager = OpenRCT2::GetContext()->GetObjectManager();
+            parkFile->ExportObjectsList = objManager.GetPackableObjects();
+            parkFile->ReferencePackedObjects = true;
+        }
+        else if (flags & S6_SAVE_FLAG_EXPORT)
         {
             auto& objManager = OpenRCT2::GetContext()->GetObjectManager();
             parkFile->ExportObjectsList = objManager.GetPackableObjects();
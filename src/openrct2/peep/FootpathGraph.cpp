@@ -0,0 +1,428 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "FootpathGraph.h"
+
+#include "../GameState.h"
+#include "../core/Timer.hpp"
+#include "../profiling/Metrics.h"
+#include "../profiling/Profiling.h"
+#include "../ride/Ride.h"
+#include "../ride/RideData.h"
+#include "../world/Footpath.h"
+#include "../world/Map.h"
+#include "../world/tile_element/EntranceElement.h"
+#include "GuestPathfinding.h"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <vector>
+
+namespace OpenRCT2::PathFinding
+{
+    static constexpr uint32_t kNoNode = std::numeric_limits<uint32_t>::max();
+    static constexpr uint32_t kUnreachable = std::numeric_limits<uint32_t>::max();
+
+    // Each distance field costs 4 bytes per node, this bounds the memory used on parks with many rides.
+    static constexpr size_t kMaxDistanceFields = 64;
+
+    struct GraphNode
+    {
+        TileCoordsXYZ Location;
+        uint8_t PermittedEdges;
+        Direction SlopeDirection;
+        // Set when the node is a queue that guests heading elsewhere should not walk through.
+        RideId QueueRideIndex;
+    };
+
+    struct DistanceField
+    {
+        TileCoordsXYZ Goal;
+        bool IgnoreForeignQueues;
+        RideId QueueRideIndex;
+        uint64_t LastUsed;
+        std::vector<uint32_t> Distances;
+    };
+
+    struct FootpathGraph
+    {
+        bool Valid{};
+        TileCoordsXY MapSize;
+        std::vector<GraphNode> Nodes;
+        // The nodes of a tile are Nodes[TileStart[tile]..TileStart[tile + 1]), sorted by height.
+        std::vector<uint32_t> TileStart;
+        // The nodes a guest can walk from onto node i are Predecessors[PredecessorStart[i]..PredecessorStart[i + 1]).
+        std::vector<uint32_t> PredecessorStart;
+        std::vector<uint32_t> Predecessors;
+        std::vector<DistanceField> DistanceFields;
+        uint64_t UseCounter{};
+    };
+
+    static FootpathGraph _graph;
+
+    void InvalidateFootpathGraph()
+    {
+        _graph.Valid = false;
+    }
+
+    static bool IsTileInGraph(const TileCoordsXY& tile)
+    {
+        return tile.x >= 0 && tile.y >= 0 && tile.x < _graph.MapSize.x && tile.y < _graph.MapSize.y;
+    }
+
+    static size_t GetTileIndex(const TileCoordsXY& tile)
+    {
+        return static_cast<size_t>(tile.y) * _graph.MapSize.x + tile.x;
+    }
+
+    static uint32_t FindNode(const TileCoordsXYZ& loc)
+    {
+        if (!IsTileInGraph(loc))
+            return kNoNode;
+
+        const auto tileIndex = GetTileIndex(loc);
+        for (auto i = _graph.TileStart[tileIndex]; i < _graph.TileStart[tileIndex + 1]; i++)
+        {
+            if (_graph.Nodes[i].Location.z == loc.z)
+                return i;
+        }
+        return kNoNode;
+    }
+
+    static bool IsBlocked(const GraphNode& node, bool ignoreForeignQueues, RideId queueRideIndex)
+    {
+        return ignoreForeignQueues && !node.QueueRideIndex.IsNull() && node.QueueRideIndex != queueRideIndex;
+    }
+
+    // The height a guest leaving the node in the given direction arrives at.
+    static int32_t GetMoveHeight(const GraphNode& node, Direction direction)
+    {
+        return node.SlopeDirection == direction ? node.Location.z + 2 : node.Location.z;
+    }
+
+    // Matches FootpathIsZAndDirectionValid for the slope of the node.
+    static bool CanEnterNode(const GraphNode& node, int32_t z, Direction direction)
+    {
+        if (node.SlopeDirection == INVALID_DIRECTION || node.SlopeDirection == direction)
+            return z == node.Location.z;
+        return DirectionReverse(node.SlopeDirection) == direction && z == node.Location.z + 2;
+    }
+
+    template<typename TFunc> static void ForEachNodeInDirection(const GraphNode& node, Direction direction, TFunc&& func)
+    {
+        const auto nextTile = TileCoordsXY{ node.Location } + TileDirectionDelta[direction];
+        if (!IsTileInGraph(nextTile))
+            return;
+
+        const auto z = GetMoveHeight(node, direction);
+        const auto tileIndex = GetTileIndex(nextTile);
+        for (auto i = _graph.TileStart[tileIndex]; i < _graph.TileStart[tileIndex + 1]; i++)
+        {
+            if (CanEnterNode(_graph.Nodes[i], z, direction))
+                func(i);
+        }
+    }
+
+    /**
+     * Checks if leaving the node in the given direction reaches the goal, using the same rules as the
+     * heuristic search: the goal can be a path, a shop, a ride entrance or exit facing the guest or a park entrance.
+     */
+    static bool MoveReachesGoal(const GraphNode& node, Direction direction, const TileCoordsXYZ& goal)
+    {
+        const auto nextTile = TileCoordsXY{ node.Location } + TileDirectionDelta[direction];
+        if (nextTile != TileCoordsXY{ goal })
+            return false;
+
+        const auto z = GetMoveHeight(node, direction);
+        auto* tileElement = MapGetFirstElementAt(nextTile);
+        if (tileElement == nullptr)
+            return false;
+
+        do
+        {
+            if (tileElement->IsGhost())
+                continue;
+
+            switch (tileElement->GetType())
+            {
+                case TileElementType::Path:
+                    if (tileElement->BaseHeight == goal.z
+                        && FootpathIsZAndDirectionValid(*tileElement->AsPath(), z, direction))
+                        return true;
+                    break;
+                case TileElementType::Track:
+                {
+                    if (tileElement->BaseHeight != z || z != goal.z)
+                        break;
+                    auto ride = GetRide(tileElement->AsTrack()->GetRideIndex());
+                    if (ride != nullptr && ride->GetRideTypeDescriptor().HasFlag(RtdFlag::isShopOrFacility))
+                        return true;
+                    break;
+                }
+                case TileElementType::Entrance:
+                    if (tileElement->BaseHeight != z || z != goal.z)
+                        break;
+                    switch (tileElement->AsEntrance()->GetEntranceType())
+                    {
+                        case ENTRANCE_TYPE_RIDE_ENTRANCE:
+                        case ENTRANCE_TYPE_RIDE_EXIT:
+                            if (tileElement->GetDirection() == direction)
+                                return true;
+                            break;
+                        case ENTRANCE_TYPE_PARK_ENTRANCE:
+                            return true;
+                    }
+                    break;
+                default:
+                    break;
+            }
+        } while (!(tileElement++)->IsLastForTile());
+        return false;
+    }
+
+    static void AddPathElement(size_t firstNodeOfTile, const TileCoordsXY& tile, const PathElement& pathElement)
+    {
+        const auto permittedEdges = static_cast<uint8_t>(PathGetPermittedEdges(false, &pathElement));
+        const auto slopeDirection = pathElement.IsSloped() ? pathElement.GetSlopeDirection() : INVALID_DIRECTION;
+        auto queueRideIndex = RideId::GetNull();
+        if (pathElement.IsQueue() && std::popcount(pathElement.GetEdges()) == 2)
+        {
+            queueRideIndex = pathElement.GetRideIndex();
+        }
+
+        // Overlaid paths at the same height are walked as one, the first one decides the slope.
+        for (auto i = firstNodeOfTile; i < _graph.Nodes.size(); i++)
+        {
+            auto& node = _graph.Nodes[i];
+            if (node.Location.z == pathElement.BaseHeight)
+            {
+                node.PermittedEdges |= permittedEdges;
+                if (node.QueueRideIndex != queueRideIndex)
+                    node.QueueRideIndex = RideId::GetNull();
+                return;
+            }
+        }
+        _graph.Nodes.push_back({ { tile, pathElement.BaseHeight }, permittedEdges, slopeDirection, queueRideIndex });
+    }
+
+    static void BuildGraph()
+    {
+        PROFILED_FUNCTION();
+
+        static auto& builds = Metrics::GetCounter("pathfinding.graph.builds");
+        static auto& buildTime = Metrics::GetHistogram("pathfinding.graph.build_time_ms");
+        static auto& nodeCount = Metrics::GetGauge("pathfinding.graph.nodes");
+
+        Timer timer;
+
+        _graph.MapSize = GetGameState().MapSize;
+        _graph.Nodes.clear();
+        _graph.TileStart.assign(static_cast<size_t>(_graph.MapSize.x) * _graph.MapSize.y + 1, 0);
+        _graph.DistanceFields.clear();
+
+        for (int32_t y = 0; y < _graph.MapSize.y; y++)
+        {
+            for (int32_t x = 0; x < _graph.MapSize.x; x++)
+            {
+                const TileCoordsXY tile{ x, y };
+                const auto firstNodeOfTile = _graph.Nodes.size();
+                _graph.TileStart[GetTileIndex(tile)] = static_cast<uint32_t>(firstNodeOfTile);
+
+                auto* tileElement = MapGetFirstElementAt(tile);
+                if (tileElement == nullptr)
+                    continue;
+                do
+                {
+                    if (tileElement->GetType() != TileElementType::Path || tileElement->IsGhost())
+                        continue;
+                    AddPathElement(firstNodeOfTile, tile, *tileElement->AsPath());
+                } while (!(tileElement++)->IsLastForTile());
+
+                std::sort(
+                    _graph.Nodes.begin() + firstNodeOfTile, _graph.Nodes.end(),
+                    [](const GraphNode& a, const GraphNode& b) { return a.Location.z < b.Location.z; });
+            }
+        }
+        _graph.TileStart.back() = static_cast<uint32_t>(_graph.Nodes.size());
+
+        // Count the links into each node, then fill them in.
+        _graph.PredecessorStart.assign(_graph.Nodes.size() + 1, 0);
+        for (const auto& node : _graph.Nodes)
+        {
+            for (Direction direction = 0; direction < kNumOrthogonalDirections; direction++)
+            {
+                if (node.PermittedEdges & (1 << direction))
+                    ForEachNodeInDirection(node, direction, [](uint32_t next) { _graph.PredecessorStart[next + 1]++; });
+            }
+        }
+        for (size_t i = 1; i < _graph.PredecessorStart.size(); i++)
+        {
+            _graph.PredecessorStart[i] += _graph.PredecessorStart[i - 1];
+        }
+
+        _graph.Predecessors.resize(_graph.PredecessorStart.back());
+        std::vector<uint32_t> fillPosition(_graph.PredecessorStart.begin(), _graph.PredecessorStart.end() - 1);
+        for (uint32_t i = 0; i < _graph.Nodes.size(); i++)
+        {
+            const auto& node = _graph.Nodes[i];
+            for (Direction direction = 0; direction < kNumOrthogonalDirections; direction++)
+            {
+                if (node.PermittedEdges & (1 << direction))
+                    ForEachNodeInDirection(
+                        node, direction, [&](uint32_t next) { _graph.Predecessors[fillPosition[next]++] = i; });
+            }
+        }
+
+        _graph.Valid = true;
+
+        builds.Add();
+        buildTime.Record(timer.GetElapsedTime().count() * 1000.0);
+        nodeCount.Set(static_cast<double>(_graph.Nodes.size()));
+    }
+
+    /**
+     * Walks the links backwards from the goal, breadth first, so each node gets the least number of
+     * steps needed to reach the goal. Queues guests should not walk through get a distance but are never walked through.
+     */
+    static void BuildDistanceField(DistanceField& field)
+    {
+        PROFILED_FUNCTION();
+
+        static auto& builds = Metrics::GetCounter("pathfinding.graph.distance_field_builds");
+
+        const auto& goal = field.Goal;
+        auto& distances = field.Distances;
+        distances.assign(_graph.Nodes.size(), kUnreachable);
+
+        std::vector<uint32_t> open;
+        const auto goalNode = FindNode(goal);
+        if (goalNode != kNoNode)
+        {
+            distances[goalNode] = 0;
+            open.push_back(goalNode);
+        }
+
+        // The goal might not be a path (e.g. a shop), seed the nodes that step onto it.
+        for (Direction direction = 0; direction < kNumOrthogonalDirections; direction++)
+        {
+            const auto tile = TileCoordsXY{ goal } + TileDirectionDelta[DirectionReverse(direction)];
+            if (!IsTileInGraph(tile))
+                continue;
+
+            const auto tileIndex = GetTileIndex(tile);
+            for (auto i = _graph.TileStart[tileIndex]; i < _graph.TileStart[tileIndex + 1]; i++)
+            {
+                const auto& node = _graph.Nodes[i];
+                if (distances[i] == kUnreachable && (node.PermittedEdges & (1 << direction))
+                    && MoveReachesGoal(node, direction, goal))
+                {
+                    distances[i] = 1;
+                    open.push_back(i);
+                }
+            }
+        }
+
+        for (size_t head = 0; head < open.size(); head++)
+        {
+            const auto current = open[head];
+            if (current != goalNode && IsBlocked(_graph.Nodes[current], field.IgnoreForeignQueues, field.QueueRideIndex))
+                continue;
+
+            for (auto i = _graph.PredecessorStart[current]; i < _graph.PredecessorStart[current + 1]; i++)
+            {
+                const auto previous = _graph.Predecessors[i];
+                if (distances[previous] == kUnreachable)
+                {
+                    distances[previous] = distances[current] + 1;
+                    open.push_back(previous);
+                }
+            }
+        }
+
+        builds.Add();
+    }
+
+    static const DistanceField& GetDistanceField(const TileCoordsXYZ& goal, bool ignoreForeignQueues, RideId queueRideIndex)
+    {
+        // The queue ride only matters when foreign queues are ignored, share the field otherwise.
+        if (!ignoreForeignQueues)
+            queueRideIndex = RideId::GetNull();
+
+        _graph.UseCounter++;
+        for (auto& field : _graph.DistanceFields)
+        {
+            if (field.Goal == goal && field.IgnoreForeignQueues == ignoreForeignQueues
+                && field.QueueRideIndex == queueRideIndex)
+            {
+                field.LastUsed = _graph.UseCounter;
+                return field;
+            }
+        }
+
+        DistanceField* field;
+        if (_graph.DistanceFields.size() < kMaxDistanceFields)
+        {
+            field = &_graph.DistanceFields.emplace_back();
+        }
+        else
+        {
+            field = &*std::min_element(
+                _graph.DistanceFields.begin(), _graph.DistanceFields.end(),
+                [](const DistanceField& a, const DistanceField& b) { return a.LastUsed < b.LastUsed; });
+        }
+        field->Goal = goal;
+        field->IgnoreForeignQueues = ignoreForeignQueues;
+        field->QueueRideIndex = queueRideIndex;
+        field->LastUsed = _graph.UseCounter;
+        BuildDistanceField(*field);
+        return *field;
+    }
+
+    Direction FootpathGraphChooseDirection(
+        const TileCoordsXYZ& loc, const TileCoordsXYZ& goal, bool ignoreForeignQueues, RideId queueRideIndex)
+    {
+        PROFILED_FUNCTION();
+
+        if (!_graph.Valid)
+            BuildGraph();
+
+        const auto nodeIndex = FindNode(loc);
+        if (nodeIndex == kNoNode)
+            return INVALID_DIRECTION;
+
+        const auto& field = GetDistanceField(goal, ignoreForeignQueues, queueRideIndex);
+        const auto& node = _graph.Nodes[nodeIndex];
+
+        // Ties go to the lowest direction so the choice does not depend on anything but the map.
+        Direction bestDirection = INVALID_DIRECTION;
+        uint32_t bestDistance = kUnreachable;
+        for (Direction direction = 0; direction < kNumOrthogonalDirections; direction++)
+        {
+            if (!(node.PermittedEdges & (1 << direction)))
+                continue;
+
+            if (MoveReachesGoal(node, direction, goal))
+                return direction;
+
+            ForEachNodeInDirection(node, direction, [&](uint32_t next) {
+                const auto distance = field.Distances[next];
+                if (distance == kUnreachable || IsBlocked(_graph.Nodes[next], ignoreForeignQueues, queueRideIndex))
+                    return;
+                if (distance + 1 < bestDistance)
+                {
+                    bestDistance = distance + 1;
+                    bestDirection = direction;
+                }
+            });
+        }
+        return bestDirection;
+    }
+
+} // namespace OpenRCT2::PathFinding
@@ -0,0 +1,37 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../ride/RideTypes.h"
+#include "../world/Location.hpp"
+
+/**
+ * A navigation graph of the footpaths in the park, used by the footpath graph pathfinding mode.
+ *
+ * Every footpath location is a node, linked to the footpaths a guest can walk onto from it. For each
+ * goal that is asked for, the walking distance of every node to the goal is calculated once and cached,
+ * so choosing a direction only has to compare the distances of the neighbouring nodes.
+ *
+ * The graph and the distances only depend on the tile elements, so the chosen directions are the same
+ * on every client regardless of which distances happen to be cached.
+ */
+namespace OpenRCT2::PathFinding
+{
+    // Marks the graph as out of date, it is rebuilt from the tile elements the next time it is used.
+    void InvalidateFootpathGraph();
+
+    /**
+     * Returns the direction of the shortest walk from loc to goal, or INVALID_DIRECTION when there is
+     * no path element at loc or the goal can not be reached from it.
+     */
+    Direction FootpathGraphChooseDirection(
+        const TileCoordsXYZ& loc, const TileCoordsXYZ& goal, bool ignoreForeignQueues, RideId queueRideIndex);
+
+} // namespace OpenRCT2::PathFinding
@@ -23,6 +23,7 @@
 #include "../world/Entrance.h"
 #include "../world/Footpath.h"
 #include "../world/tile_element/EntranceElement.h"
+#include "FootpathGraph.h"
 
 #include <bit>
 #include <bitset>
@@ -184,7 +185,7 @@ namespace OpenRCT2::PathFinding
     /**
      * Gets the connected edges of a path that are permitted (i.e. no 'no entry' signs)
      */
-    static int32_t PathGetPermittedEdges(bool ignoreBanners, const PathElement* pathElement)
+    int32_t PathGetPermittedEdges(bool ignoreBanners, const PathElement* pathElement)
     {
         return BannerClearPathEdges(ignoreBanners, pathElement, pathElement->GetEdgesAndCorners()) & 0x0F;
     }
@@ -1220,6 +1221,25 @@ namespace OpenRCT2::PathFinding
         }
     }
 
+    /**
+     * If this is a new goal for the peep, store it and reset the peep's PathfindHistory.
+     */
+    static void SetPathfindGoal(Peep& peep, const TileCoordsXYZ& goal)
+    {
+        if (!DirectionValid(peep.PathfindGoal.direction) || peep.PathfindGoal != goal)
+        {
+            peep.PathfindGoal = { goal, 0 };
+
+            // Clear pathfinding history
+            TileCoordsXYZD nullPos;
+            nullPos.SetNull();
+
+            std::fill(std::begin(peep.PathfindHistory), std::end(peep.PathfindHistory), nullPos);
+
+            LogPathfinding(&peep, "New goal; clearing pf_history.");
+        }
+    }
+
     /**
      * Returns:
      *   -1   - no direction chosen
@@ -1298,6 +1318,19 @@ namespace OpenRCT2::PathFinding
             return INVALID_DIRECTION;
 
         permittedEdges &= 0xF;
+
+        // Guests can walk the shortest route instead, when there is one. Staff keep the heuristic search as it
+        // knows about patrol areas and wide paths they can walk along.
+        if (peep.Is<Guest>() && GetGameState().Cheats.FootpathGraphPathfinding)
+        {
+            auto direction = FootpathGraphChooseDirection(loc, goal, ignoreForeignQueues, queueRideIndex);
+            if (direction != INVALID_DIRECTION)
+            {
+                SetPathfindGoal(peep, goal);
+                return direction;
+            }
+        }
+
         uint32_t edges = permittedEdges;
         if (isThin && peep.PathfindGoal == goal)
         {
@@ -1354,20 +1387,7 @@ namespace OpenRCT2::PathFinding
             }
         }
 
-        /* If this is a new goal for the peep. Store it and reset the peep's
-         * PathfindHistory. */
-        if (!DirectionValid(peep.PathfindGoal.direction) || peep.PathfindGoal != goal)
-        {
-            peep.PathfindGoal = { goal, 0 };
-
-            // Clear pathfinding history
-            TileCoordsXYZD nullPos;
-            nullPos.SetNull();
-
-            std::fill(std::begin(peep.PathfindHistory), std::end(peep.PathfindHistory), nullPos);
-
-            LogPathfinding(&peep, "New goal; clearing pf_history.");
-        }
+        SetPathfindGoal(peep, goal);
 
         // Peep has tried all edges.
         if (edges == 0)
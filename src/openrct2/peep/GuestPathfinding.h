@@ -17,6 +17,7 @@
 struct Peep;
 struct Guest;
 struct TileElement;
+struct PathElement;
 
 namespace OpenRCT2::PathFinding
 {
@@ -31,4 +32,9 @@ namespace OpenRCT2::PathFinding
 
     int32_t GuestPathFindParkEntranceLeaving(Peep& peep, uint8_t edges);
 
+    /**
+     * Gets the connected edges of a path that are permitted (i.e. no 'no entry' signs)
+     */
+    int32_t PathGetPermittedEdges(bool ignoreBanners, const PathElement* pathElement);
+
 }; // namespace OpenRCT2::PathFinding
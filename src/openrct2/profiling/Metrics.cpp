@@ -0,0 +1,261 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "Metrics.h"
+
+#include "../core/Json.hpp"
+#include "../core/String.hpp"
+#include "../core/Timer.hpp"
+#include "../entity/EntityList.h"
+#include "../world/Map.h"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+
+namespace OpenRCT2::Metrics
+{
+    Metric::Metric(std::string_view name)
+        : _name(name)
+    {
+    }
+
+    const std::string& Metric::GetName() const noexcept
+    {
+        return _name;
+    }
+
+    json_t Counter::ToJson() const
+    {
+        return { { "type", "counter" }, { "value", GetValue() } };
+    }
+
+    std::string Counter::ToString() const
+    {
+        return String::StdFormat("%s: %llu", GetName().c_str(), static_cast<unsigned long long>(GetValue()));
+    }
+
+    json_t Gauge::ToJson() const
+    {
+        return { { "type", "gauge" }, { "value", GetValue() } };
+    }
+
+    std::string Gauge::ToString() const
+    {
+        return String::StdFormat("%s: %.3f", GetName().c_str(), GetValue());
+    }
+
+    void Histogram::Record(double value)
+    {
+        std::scoped_lock lock(_mutex);
+        if (_count == 0)
+        {
+            _min = value;
+            _max = value;
+        }
+        else
+        {
+            _min = std::min(_min, value);
+            _max = std::max(_max, value);
+        }
+        _samples[_count % kMaxSamples] = value;
+        _total += value;
+        _count++;
+    }
+
+    void Histogram::Reset()
+    {
+        std::scoped_lock lock(_mutex);
+        _count = 0;
+        _min = 0;
+        _max = 0;
+        _total = 0;
+    }
+
+    HistogramSummary Histogram::GetSummary() const
+    {
+        std::vector<double> recent;
+        HistogramSummary summary;
+        {
+            std::scoped_lock lock(_mutex);
+            if (_count == 0)
+                return summary;
+
+            summary.Count = _count;
+            summary.Min = _min;
+            summary.Max = _max;
+            summary.Mean = _total / _count;
+            recent.assign(_samples.begin(), _samples.begin() + std::min<uint64_t>(_count, kMaxSamples));
+        }
+
+        std::sort(recent.begin(), recent.end());
+        auto percentile = [&recent](double p) { return recent[static_cast<size_t>(p * (recent.size() - 1))]; };
+        summary.P50 = percentile(0.50);
+        summary.P90 = percentile(0.90);
+        summary.P99 = percentile(0.99);
+        return summary;
+    }
+
+    json_t Histogram::ToJson() const
+    {
+        const auto summary = GetSummary();
+        return {
+            { "type", "histogram" }, { "count", summary.Count }, { "min", summary.Min }, { "max", summary.Max },
+            { "mean", summary.Mean }, { "p50", summary.P50 },    { "p90", summary.P90 }, { "p99", summary.P99 },
+        };
+    }
+
+    std::string Histogram::ToString() const
+    {
+        const auto summary = GetSummary();
+        return String::StdFormat(
+            "%s: count %llu, min %.3f, mean %.3f, p50 %.3f, p90 %.3f, p99 %.3f, max %.3f", GetName().c_str(),
+            static_cast<unsigned long long>(summary.Count), summary.Min, summary.Mean, summary.P50, summary.P90, summary.P99,
+            summary.Max);
+    }
+
+    template<typename T> using MetricMap = std::map<std::string, std::unique_ptr<T>, std::less<>>;
+
+    static std::mutex _registryMutex;
+    static MetricMap<Counter> _counters;
+    static MetricMap<Gauge> _gauges;
+    static MetricMap<Histogram> _histograms;
+
+    template<typename T> static T& GetOrCreate(MetricMap<T>& metrics, std::string_view name)
+    {
+        std::scoped_lock lock(_registryMutex);
+        auto it = metrics.find(name);
+        if (it == metrics.end())
+        {
+            it = metrics.emplace(std::string(name), std::make_unique<T>(name)).first;
+        }
+        return *it->second;
+    }
+
+    Counter& GetCounter(std::string_view name)
+    {
+        return GetOrCreate(_counters, name);
+    }
+
+    Gauge& GetGauge(std::string_view name)
+    {
+        return GetOrCreate(_gauges, name);
+    }
+
+    Histogram& GetHistogram(std::string_view name)
+    {
+        return GetOrCreate(_histograms, name);
+    }
+
+    std::vector<const Metric*> GetAll()
+    {
+        std::vector<const Metric*> result;
+        {
+            std::scoped_lock lock(_registryMutex);
+            for (const auto& [name, metric] : _counters)
+                result.push_back(metric.get());
+            for (const auto& [name, metric] : _gauges)
+                result.push_back(metric.get());
+            for (const auto& [name, metric] : _histograms)
+                result.push_back(metric.get());
+        }
+        std::sort(result.begin(), result.end(), [](const Metric* a, const Metric* b) { return a->GetName() < b->GetName(); });
+        return result;
+    }
+
+    // Indexed by EntityType.
+    // clang-format off
+    static constexpr std::string_view kEntityTypeNames[] = {
+        "vehicle", "guest", "staff", "litter", "steam_particle", "money_effect", "crashed_vehicle_particle",
+        "explosion_cloud", "crash_splash", "explosion_flare", "jumping_fountain", "balloon", "duck",
+    };
+    // clang-format on
+    static_assert(std::size(kEntityTypeNames) == static_cast<size_t>(EntityType::Count));
+
+    static void UpdateTickRate()
+    {
+        static Timer timer;
+        static uint64_t lastTicks = 0;
+        static auto& ticks = GetCounter("game.ticks");
+        static auto& ticksPerSecond = GetGauge("game.ticks_per_second");
+
+        const auto elapsed = timer.GetElapsedTime().count();
+        if (elapsed < 1.0f)
+            return;
+
+        const auto currentTicks = ticks.GetValue();
+        ticksPerSecond.Set((currentTicks - lastTicks) / elapsed);
+        lastTicks = currentTicks;
+        timer.Restart();
+    }
+
+    static void UpdateEntityCounts()
+    {
+        static const auto gauges = []() {
+            std::array<Gauge*, std::size(kEntityTypeNames)> result{};
+            for (size_t i = 0; i < result.size(); i++)
+            {
+                result[i] = &GetGauge(std::string("entities.") + std::string(kEntityTypeNames[i]));
+            }
+            return result;
+        }();
+
+        for (size_t i = 0; i < gauges.size(); i++)
+        {
+            gauges[i]->Set(GetEntityListCount(static_cast<EntityType>(i)));
+        }
+    }
+
+    static void UpdateTileElements()
+    {
+        static auto& capacity = GetGauge("map.tile_elements.capacity");
+        static auto& allocated = GetGauge("map.tile_elements.allocated");
+        static auto& inUse = GetGauge("map.tile_elements.in_use");
+        static auto& fragmentation = GetGauge("map.tile_elements.fragmentation");
+        static auto& compactionProgress = GetGauge("map.tile_elements.compaction_progress");
+
+        const auto stats = GetTileElementStats();
+        capacity.Set(static_cast<double>(stats.Capacity));
+        allocated.Set(static_cast<double>(stats.Allocated));
+        inUse.Set(static_cast<double>(stats.InUse));
+        fragmentation.Set(stats.Allocated != 0 ? 1.0 - static_cast<double>(stats.InUse) / stats.Allocated : 0.0);
+        compactionProgress.Set(stats.CompactionProgress);
+    }
+
+    void Update()
+    {
+        UpdateTickRate();
+        UpdateEntityCounts();
+        UpdateTileElements();
+    }
+
+    json_t ToJson()
+    {
+        json_t result = json_t::object();
+        for (const auto* metric : GetAll())
+        {
+            result[metric->GetName()] = metric->ToJson();
+        }
+        return result;
+    }
+
+    bool ExportJson(u8string_view path)
+    {
+        try
+        {
+            Json::WriteToFile(path, ToJson());
+            return true;
+        }
+        catch (const std::exception&)
+        {
+            return false;
+        }
+    }
+
+} // namespace OpenRCT2::Metrics
@@ -0,0 +1,171 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+#pragma once
+
+#include "../core/JsonFwd.hpp"
+#include "../core/StringTypes.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Always-on, low overhead metrics that are cheap enough to update from hot paths.
+ * Unlike the profiler, metrics are never disabled: counters and gauges are single relaxed atomics.
+ *
+ * Metrics are looked up by name once and the returned reference stays valid for the lifetime
+ * of the process, so callers are expected to cache it in a static:
+ *
+ *     static auto& ticks = Metrics::GetCounter("game.ticks");
+ *     ticks.Add();
+ */
+namespace OpenRCT2::Metrics
+{
+    enum class MetricType : uint8_t
+    {
+        Counter,
+        Gauge,
+        Histogram,
+    };
+
+    class Metric
+    {
+        std::string _name;
+
+    public:
+        explicit Metric(std::string_view name);
+        virtual ~Metric() = default;
+
+        const std::string& GetName() const noexcept;
+        virtual MetricType GetType() const noexcept = 0;
+        virtual json_t ToJson() const = 0;
+        virtual std::string ToString() const = 0;
+    };
+
+    // A value that only ever goes up, e.g. bytes sent.
+    class Counter final : public Metric
+    {
+        std::atomic<uint64_t> _value{};
+
+    public:
+        using Metric::Metric;
+
+        void Add(uint64_t amount = 1) noexcept
+        {
+            _value.fetch_add(amount, std::memory_order_relaxed);
+        }
+
+        uint64_t GetValue() const noexcept
+        {
+            return _value.load(std::memory_order_relaxed);
+        }
+
+        MetricType GetType() const noexcept override
+        {
+            return MetricType::Counter;
+        }
+
+        json_t ToJson() const override;
+        std::string ToString() const override;
+    };
+
+    // A value that can go up and down, e.g. a queue depth.
+    class Gauge final : public Metric
+    {
+        std::atomic<double> _value{};
+
+    public:
+        using Metric::Metric;
+
+        void Set(double value) noexcept
+        {
+            _value.store(value, std::memory_order_relaxed);
+        }
+
+        void Add(double amount) noexcept
+        {
+            // std::atomic<double>::fetch_add is missing from some of the standard libraries we support.
+            auto current = _value.load(std::memory_order_relaxed);
+            while (!_value.compare_exchange_weak(current, current + amount, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        double GetValue() const noexcept
+        {
+            return _value.load(std::memory_order_relaxed);
+        }
+
+        MetricType GetType() const noexcept override
+        {
+            return MetricType::Gauge;
+        }
+
+        json_t ToJson() const override;
+        std::string ToString() const override;
+    };
+
+    struct HistogramSummary
+    {
+        uint64_t Count{};
+        double Min{};
+        double Max{};
+        double Mean{};
+        double P50{};
+        double P90{};
+        double P99{};
+    };
+
+    // A distribution of samples, e.g. tick times. Percentiles are computed over the most recent samples only.
+    class Histogram final : public Metric
+    {
+        static constexpr size_t kMaxSamples = 1024;
+
+        mutable std::mutex _mutex;
+        std::array<double, kMaxSamples> _samples{};
+        uint64_t _count{};
+        double _min{};
+        double _max{};
+        double _total{};
+
+    public:
+        using Metric::Metric;
+
+        void Record(double value);
+        void Reset();
+        HistogramSummary GetSummary() const;
+
+        MetricType GetType() const noexcept override
+        {
+            return MetricType::Histogram;
+        }
+
+        json_t ToJson() const override;
+        std::string ToString() const override;
+    };
+
+    Counter& GetCounter(std::string_view name);
+    Gauge& GetGauge(std::string_view name);
+    Histogram& GetHistogram(std::string_view name);
+
+    // Returns all metrics sorted by name.
+    std::vector<const Metric*> GetAll();
+
+    // Samples the metrics that are derived from the game state (entity counts, tile elements, tick rate).
+    // Called once per frame.
+    void Update();
+
+    json_t ToJson();
+    bool ExportJson(u8string_view path);
+
+} // namespace OpenRCT2::Metrics
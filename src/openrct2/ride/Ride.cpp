@@ -347,12 +347,33 @@ int32_t Ride::GetMaxQueueTime() const
     return static_cast<int32_t>(queueTime);
 }
 
+/**
+ * Stations keep both ends of their queue, and guests link to the guest ahead of them (GuestNextInQueue, which is saved)
+ * and behind them (GuestBehindInQueue, which is rebuilt on load), so guests join and leave the queue without walking
+ * it. The links are checked before they are used; when they do not match the saved links, the queue is walked from the
+ * back as before. QueueLength is kept exactly as before, including the recount when a guest skips to the front.
+ */
+static bool IsGuestInQueueBehind(const Guest* behind, const Guest* peep)
+{
+    return behind != nullptr && behind->GuestNextInQueue == peep->Id;
+}
+
 Guest* Ride::GetQueueHeadGuest(StationIndex stationIndex) const
 {
+    const auto& station = GetStation(stationIndex);
+    auto* head = TryGetEntity<Guest>(station.FirstPeepInQueue);
+    if (head != nullptr && head->CurrentRide == id && head->CurrentRideStation == stationIndex
+        && TryGetEntity<Guest>(head->GuestNextInQueue) == nullptr
+        && (head->Id == station.LastPeepInQueue
+            || IsGuestInQueueBehind(TryGetEntity<Guest>(head->GuestBehindInQueue), head)))
+    {
+        return head;
+    }
+
     Guest* peep;
     Guest* result = nullptr;
-    auto spriteIndex = GetStation(stationIndex).LastPeepInQueue;
-    while ((peep = TryGetEntity<Guest>(spriteIndex)) != nullptr)
+    auto spriteIndex = station.LastPeepInQueue;
+    for (uint32_t i = 0; i < MAX_ENTITIES && (peep = TryGetEntity<Guest>(spriteIndex)) != nullptr; i++)
     {
         spriteIndex = peep->GuestNextInQueue;
         result = peep;
@@ -360,18 +381,25 @@ Guest* Ride::GetQueueHeadGuest(StationIndex stationIndex) const
     return result;
 }
 
-void Ride::UpdateQueueLength(StationIndex stationIndex)
+void Ride::QueueAppendGuest(StationIndex stationIndex, Guest* peep)
 {
-    uint16_t count = 0;
-    Guest* peep;
+    assert(peep != nullptr);
+
     auto& station = GetStation(stationIndex);
-    auto spriteIndex = station.LastPeepInQueue;
-    while ((peep = TryGetEntity<Guest>(spriteIndex)) != nullptr)
+    auto* lastPeep = TryGetEntity<Guest>(station.LastPeepInQueue);
+    if (lastPeep != nullptr)
     {
-        spriteIndex = peep->GuestNextInQueue;
-        count++;
+        lastPeep->GuestBehindInQueue = peep->Id;
     }
-    station.QueueLength = count;
+    else
+    {
+        station.FirstPeepInQueue = peep->Id;
+    }
+
+    peep->GuestNextInQueue = station.LastPeepInQueue;
+    peep->GuestBehindInQueue = EntityId::GetNull();
+    station.LastPeepInQueue = peep->Id;
+    station.QueueLength++;
 }
 
 void Ride::QueueInsertGuestAtFront(StationIndex stationIndex, Guest* peep)
@@ -379,17 +407,149 @@ void Ride::QueueInsertGuestAtFront(StationIndex stationIndex, Guest* peep)
     assert(stationIndex.ToUnderlying() < OpenRCT2::Limits::kMaxStationsPerRide);
     assert(peep != nullptr);
 
+    auto& station = GetStation(stationIndex);
     peep->GuestNextInQueue = EntityId::GetNull();
-    auto* queueHeadGuest = GetQueueHeadGuest(peep->CurrentRideStation);
+    auto* queueHeadGuest = GetQueueHeadGuest(stationIndex);
     if (queueHeadGuest == nullptr)
     {
-        GetStation(peep->CurrentRideStation).LastPeepInQueue = peep->Id;
+        station.LastPeepInQueue = peep->Id;
+        peep->GuestBehindInQueue = EntityId::GetNull();
     }
     else
     {
         queueHeadGuest->GuestNextInQueue = peep->Id;
+        peep->GuestBehindInQueue = queueHeadGuest->Id;
+    }
+    station.FirstPeepInQueue = peep->Id;
+    UpdateQueueLength(stationIndex);
+}
+
+bool Ride::QueueRemoveGuest(StationIndex stationIndex, Guest* peep)
+{
+    assert(peep != nullptr);
+
+    auto& station = GetStation(stationIndex);
+    // Make sure we don't underflow, building while paused might reset it to 0 where peeps have
+    // not yet left the queue.
+    if (station.QueueLength > 0)
+    {
+        station.QueueLength--;
+    }
+
+    Guest* behind = nullptr;
+    if (peep->Id != station.LastPeepInQueue)
+    {
+        behind = TryGetEntity<Guest>(peep->GuestBehindInQueue);
+        if (!IsGuestInQueueBehind(behind, peep))
+        {
+            behind = TryGetEntity<Guest>(station.LastPeepInQueue);
+            if (behind == nullptr)
+            {
+                LOG_ERROR("Invalid Guest Queue list!");
+                return false;
+            }
+            for (uint32_t i = 0; i < MAX_ENTITIES && behind != nullptr && !IsGuestInQueueBehind(behind, peep); i++)
+            {
+                behind = TryGetEntity<Guest>(behind->GuestNextInQueue);
+            }
+            if (!IsGuestInQueueBehind(behind, peep))
+            {
+                return false;
+            }
+        }
+    }
+
+    if (behind == nullptr)
+    {
+        station.LastPeepInQueue = peep->GuestNextInQueue;
+    }
+    else
+    {
+        behind->GuestNextInQueue = peep->GuestNextInQueue;
+    }
+
+    const auto behindId = behind != nullptr ? behind->Id : EntityId::GetNull();
+    auto* ahead = TryGetEntity<Guest>(peep->GuestNextInQueue);
+    if (ahead != nullptr)
+    {
+        ahead->GuestBehindInQueue = behindId;
+    }
+    else
+    {
+        station.FirstPeepInQueue = behindId;
+    }
+    peep->GuestBehindInQueue = EntityId::GetNull();
+    return true;
+}
+
+void Ride::UpdateQueueLength(StationIndex stationIndex)
+{
+    uint16_t count = 0;
+    Guest* peep;
+    auto& station = GetStation(stationIndex);
+    auto spriteIndex = station.LastPeepInQueue;
+    for (uint32_t i = 0; i < MAX_ENTITIES && (peep = TryGetEntity<Guest>(spriteIndex)) != nullptr; i++)
+    {
+        spriteIndex = peep->GuestNextInQueue;
+        count++;
+    }
+    station.QueueLength = count;
+}
+
+void Ride::RebuildQueue(StationIndex stationIndex)
+{
+    auto& station = GetStation(stationIndex);
+    auto behindId = EntityId::GetNull();
+    auto spriteIndex = station.LastPeepInQueue;
+    Guest* peep;
+    for (uint32_t i = 0; i < MAX_ENTITIES && (peep = TryGetEntity<Guest>(spriteIndex)) != nullptr; i++)
+    {
+        peep->GuestBehindInQueue = behindId;
+        behindId = peep->Id;
+        spriteIndex = peep->GuestNextInQueue;
+    }
+    station.FirstPeepInQueue = behindId;
+}
+
+bool Ride::ValidateQueue(StationIndex stationIndex) const
+{
+    const auto& station = GetStation(stationIndex);
+    auto behindId = EntityId::GetNull();
+    auto spriteIndex = station.LastPeepInQueue;
+    Guest* peep;
+    bool valid = true;
+    for (uint32_t i = 0; i < MAX_ENTITIES && (peep = TryGetEntity<Guest>(spriteIndex)) != nullptr; i++)
+    {
+        if (peep->GuestBehindInQueue != behindId)
+        {
+            LOG_ERROR(
+                "Ride %u station %u: guest %u is behind guest %u in the queue, not guest %u.", id.ToUnderlying(),
+                stationIndex.ToUnderlying(), behindId.ToUnderlying(), peep->Id.ToUnderlying(),
+                peep->GuestBehindInQueue.ToUnderlying());
+            valid = false;
+        }
+        behindId = peep->Id;
+        spriteIndex = peep->GuestNextInQueue;
+    }
+    if (station.FirstPeepInQueue != behindId)
+    {
+        LOG_ERROR(
+            "Ride %u station %u: guest %u is at the front of the queue, not guest %u.", id.ToUnderlying(),
+            stationIndex.ToUnderlying(), behindId.ToUnderlying(), station.FirstPeepInQueue.ToUnderlying());
+        valid = false;
+    }
+    return valid;
+}
+
+void RideRebuildQueues()
+{
+    for (auto& ride : GetRideManager())
+    {
+        for (const auto& station : ride.GetStations())
+        {
+            ride.RebuildQueue(ride.GetStationIndex(&station));
+        }
     }
-    UpdateQueueLength(peep->CurrentRideStation);
 }
 
 /**
@@ -1110,6 +1270,11 @@ void Ride::Update()
         for (StationIndex::UnderlyingType i = 0; i < OpenRCT2::Limits::kMaxStationsPerRide; i++)
             RideUpdateStation(*this, StationIndex::FromUnderlying(i));
 
+#if DEBUG_LEVEL_1
+    for (StationIndex::UnderlyingType i = 0; i < OpenRCT2::Limits::kMaxStationsPerRide; i++)
+        ValidateQueue(StationIndex::FromUnderlying(i));
+#endif
+
     // Update financial statistics
     num_customers_timeout++;
 
@@ -75,10 +75,15 @@ struct RideStation
     uint8_t QueueTime{};
     uint16_t QueueLength{};
     EntityId LastPeepInQueue{ EntityId::GetNull() };
+    // The guest at the front of the queue. Not saved, rebuilt from LastPeepInQueue when a park is loaded.
+    EntityId FirstPeepInQueue{ EntityId::GetNull() };
 
     int32_t GetBaseZ() const;
     void SetBaseZ(int32_t newZ);
     CoordsXYZ GetStart() const;
+
+    // Empties the queue, leaving the guests that were in it to leave on their own.
+    void ResetQueue();
 };
 
 struct RideMeasurement
@@ -308,7 +313,6 @@ public:
 
 private:
     void Update();
-    void UpdateQueueLength(StationIndex stationIndex);
     ResultWithMessage CreateVehicles(const CoordsXYE& element, bool isApplying);
     void MoveTrainsToBlockBrakes(const CoordsXYZ& firstBlockPosition, TrackElement& firstBlock);
     money64 CalculateIncomePerHour() const;
@@ -367,8 +371,16 @@ public:
     int32_t GetTotalQueueLength() const;
     int32_t GetMaxQueueTime() const;
 
+    void QueueAppendGuest(StationIndex stationIndex, Guest* peep);
     void QueueInsertGuestAtFront(StationIndex stationIndex, Guest* peep);
+    // Returns false if the guest was not in the queue.
+    bool QueueRemoveGuest(StationIndex stationIndex, Guest* peep);
     Guest* GetQueueHeadGuest(StationIndex stationIndex) const;
+    void UpdateQueueLength(StationIndex stationIndex);
+    // Rebuilds the queue links that are not saved.
+    void RebuildQueue(StationIndex stationIndex);
+    // Checks the queue links against a walk of the queue, logging any difference.
+    bool ValidateQueue(StationIndex stationIndex) const;
 
     void SetNameToDefault();
     std::string GetName() const;
@@ -993,6 +1005,7 @@ std::string_view GetRideEntryName(ObjectEntryIndex index);
 
 int32_t RideGetCount();
 void RideInitAll();
+void RideRebuildQueues();
 void ResetAllRideBuildDates();
 void RideUpdateFavouritedStat();
 void RideCheckAllReachable();
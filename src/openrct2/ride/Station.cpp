@@ -11,6 +11,7 @@
 
 #include "../Game.h"
 #include "../GameState.h"
+#include "../entity/EntityRegistry.h"
 #include "../entity/Guest.h"
 #include "../scenario/Scenario.h"
 #include "../world/Location.hpp"
@@ -422,3 +423,22 @@ CoordsXYZ RideStation::GetStart() const
 {
     return { Start, GetBaseZ() };
 }
+
+void RideStation::ResetQueue()
+{
+    // Clear the links back through the queue, so that the guests that were in it are not taken for being in it.
+    auto spriteIndex = LastPeepInQueue;
+    for (uint32_t i = 0; i < MAX_ENTITIES; i++)
+    {
+        auto* peep = TryGetEntity<Guest>(spriteIndex);
+        if (peep == nullptr)
+            break;
+
+        peep->GuestBehindInQueue = EntityId::GetNull();
+        spriteIndex = peep->GuestNextInQueue;
+    }
+
+    LastPeepInQueue = EntityId::GetNull();
+    FirstPeepInQueue = EntityId::GetNull();
+    QueueLength = 0;
+}
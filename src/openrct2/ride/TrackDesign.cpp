@@ -53,6 +53,7 @@
 #include "../ride/RideConstruction.h"
 #include "../util/SawyerCoding.h"
 #include "../util/Util.h"
+#include "../world/ConstructionClearance.h"
 #include "../world/Footpath.h"
 #include "../world/Park.h"
 #include "../world/Scenery.h"
@@ -69,6 +70,7 @@
 
 #include <iterator>
 #include <memory>
+#include <optional>
 
 using namespace OpenRCT2;
 
@@ -1812,6 +1814,15 @@ GameActions::Result TrackDesignPlace(
     }
     bool isReplay = flags & GAME_COMMAND_FLAG_REPLAY;
 
+    // A query only queries the nested actions, so the map does not change and the pieces can share the clearance
+    // summaries of the tiles they cover. Callers trying several heights open a scope around all of them, which this
+    // one then joins.
+    std::optional<ClearanceQueryScope> clearanceScope;
+    if (ptdOperation == TrackPlaceOperation::placeQuery)
+    {
+        clearanceScope.emplace();
+    }
+
     TrackDesignState tds{};
     return TrackDesignPlaceVirtual(tds, td, ptdOperation, placeScenery, ride, coords, isReplay);
 }
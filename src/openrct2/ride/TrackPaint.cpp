@@ -1936,6 +1936,9 @@ ImageId GetShopSupportColourScheme(PaintSession& session, const TrackElement& tr
  */
 void PaintTrack(PaintSession& session, Direction direction, int32_t height, const TrackElement& trackElement)
 {
+    // Track pieces show the state of their ride and its vehicles, which changes without the tile being invalidated.
+    session.Flags |= PaintSessionFlags::IsUncacheable;
+
     RideId rideIndex = trackElement.GetRideIndex();
     auto ride = GetRide(rideIndex);
     if (ride == nullptr)
@@ -23,6 +23,7 @@
 #include "../core/FixedPoint.hpp"
 #include "../core/Memory.hpp"
 #include "../core/Speed.hpp"
+#include "../core/Timer.hpp"
 #include "../entity/EntityRegistry.h"
 #include "../entity/Particle.h"
 #include "../entity/Yaw.hpp"
@@ -33,6 +34,7 @@
 #include "../object/SmallSceneryEntry.h"
 #include "../paint/vehicle/Vehicle.MiniGolf.h"
 #include "../platform/Platform.h"
+#include "../profiling/Metrics.h"
 #include "../profiling/Profiling.h"
 #include "../rct12/RCT12.h"
 #include "../scenario/Scenario.h"
@@ -602,10 +604,21 @@ void VehicleUpdateAll()
     if ((gScreenFlags & SCREEN_FLAGS_TRACK_DESIGNER) && GetGameState().EditorStep != EditorStep::RollercoasterDesigner)
         return;
 
+    static auto& trainsMetric = Metrics::GetGauge("vehicles.trains");
+    static auto& updateTimeMetric = Metrics::GetHistogram("vehicles.update_time_ms");
+    Timer updateTimer;
+
+    // Trains must be updated in list order: rides interact through the scenario random number generator, the motion
+    // globals (_vehicleCurPosition etc.), the spatial index and boarding peeps, so the order is part of the game state.
+    int32_t numTrains = 0;
     for (auto vehicle : TrainManager::View())
     {
         vehicle->Update();
+        numTrains++;
     }
+
+    trainsMetric.Set(numTrains);
+    updateTimeMetric.Record(updateTimer.GetElapsedTime().count() * 1000.0);
 }
 
 /**
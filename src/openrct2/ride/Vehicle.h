@@ -273,7 +273,7 @@ struct Vehicle : EntityBase
     }
     void ApplyMass(int16_t appliedMass);
     void Serialise(DataSerialiser& stream);
-    void Paint(PaintSession& session, int32_t imageDirection) const;
+    void Paint(PaintSession& session, int32_t imageDirection, const CoordsXYZ& location) const;
     bool IsCableLift() const;
 
     friend void UpdateRotatingDefault(Vehicle& vehicle);
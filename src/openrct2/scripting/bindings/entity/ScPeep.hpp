@@ -11,6 +11,7 @@
 
 #ifdef ENABLE_SCRIPTING
 
+#    include "../../../windows/Intent.h"
 #    include "ScEntity.hpp"
 
 namespace OpenRCT2::Scripting
@@ -86,9 +87,11 @@ namespace OpenRCT2::Scripting
         {
             ThrowIfGameStateNotMutable();
             auto peep = GetPeep();
-            if (peep != nullptr)
+            if (peep != nullptr && peep->SetName(value))
             {
-                peep->SetName(value);
+                auto intent = Intent(
+                    peep->Type == EntityType::Staff ? INTENT_ACTION_REFRESH_STAFF_LIST : INTENT_ACTION_REFRESH_GUEST_LIST);
+                ContextBroadcastIntent(&intent);
             }
         }
 
@@ -11,6 +11,7 @@
 
 #ifdef ENABLE_SCRIPTING
 
+#    include "../../../profiling/Metrics.h"
 #    include "../../../profiling/Profiling.h"
 #    include "../../Duktape.hpp"
 
@@ -69,6 +70,41 @@ namespace OpenRCT2::Scripting
             return DukValue::take_from_stack(_ctx);
         }
 
+        DukValue getMetrics()
+        {
+            DukObject result(_ctx);
+            for (const auto* metric : OpenRCT2::Metrics::GetAll())
+            {
+                DukObject obj(_ctx);
+                switch (metric->GetType())
+                {
+                    case OpenRCT2::Metrics::MetricType::Counter:
+                        obj.Set("type", "counter");
+                        obj.Set("value", static_cast<const OpenRCT2::Metrics::Counter*>(metric)->GetValue());
+                        break;
+                    case OpenRCT2::Metrics::MetricType::Gauge:
+                        obj.Set("type", "gauge");
+                        obj.Set("value", static_cast<const OpenRCT2::Metrics::Gauge*>(metric)->GetValue());
+                        break;
+                    case OpenRCT2::Metrics::MetricType::Histogram:
+                    {
+                        const auto summary = static_cast<const OpenRCT2::Metrics::Histogram*>(metric)->GetSummary();
+                        obj.Set("type", "histogram");
+                        obj.Set("count", summary.Count);
+                        obj.Set("min", summary.Min);
+                        obj.Set("max", summary.Max);
+                        obj.Set("mean", summary.Mean);
+                        obj.Set("p50", summary.P50);
+                        obj.Set("p90", summary.P90);
+                        obj.Set("p99", summary.P99);
+                        break;
+                    }
+                }
+                result.Set(metric->GetName().c_str(), obj.Take());
+            }
+            return result.Take();
+        }
+
         void start()
         {
             OpenRCT2::Profiling::Enable();
@@ -93,6 +129,7 @@ namespace OpenRCT2::Scripting
         static void Register(duk_context* ctx)
         {
             dukglue_register_method(ctx, &ScProfiler::getData, "getData");
+            dukglue_register_method(ctx, &ScProfiler::getMetrics, "getMetrics");
             dukglue_register_method(ctx, &ScProfiler::start, "start");
             dukglue_register_method(ctx, &ScProfiler::stop, "stop");
             dukglue_register_method(ctx, &ScProfiler::reset, "reset");
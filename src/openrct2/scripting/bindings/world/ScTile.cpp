@@ -15,6 +15,7 @@
 #    include "../../../core/Guard.hpp"
 #    include "../../../entity/EntityRegistry.h"
 #    include "../../../object/LargeSceneryEntry.h"
+#    include "../../../peep/FootpathGraph.h"
 #    include "../../../ride/Track.h"
 #    include "../../../world/Footpath.h"
 #    include "../../../world/Scenery.h"
@@ -60,7 +61,7 @@ namespace OpenRCT2::Scripting
             result.reserve(currentNumElements);
             for (size_t i = 0; i < currentNumElements; i++)
             {
-                result.push_back(std::make_shared<ScTileElement>(_coords, &first[i]));
+                result.push_back(std::make_shared<ScTileElement>(_coords, i));
             }
         }
         return result;
@@ -126,6 +127,7 @@ namespace OpenRCT2::Scripting
                 }
             }
             MapInvalidateTileFull(_coords);
+            PathFinding::InvalidateFootpathGraph();
         }
     }
 
@@ -134,7 +136,7 @@ namespace OpenRCT2::Scripting
         auto first = GetFirstElement();
         if (static_cast<size_t>(index) < GetNumElements(first))
         {
-            return std::make_shared<ScTileElement>(_coords, &first[index]);
+            return std::make_shared<ScTileElement>(_coords, index);
         }
         return {};
     }
@@ -178,7 +180,8 @@ namespace OpenRCT2::Scripting
                 }
                 first[origNumElements].SetLastForTile(true);
                 MapInvalidateTileFull(_coords);
-                result = std::make_shared<ScTileElement>(_coords, &first[index]);
+                PathFinding::InvalidateFootpathGraph();
+                result = std::make_shared<ScTileElement>(_coords, index);
             }
         }
         else
@@ -204,6 +207,7 @@ namespace OpenRCT2::Scripting
             }
             TileElementRemove(&first[index]);
             MapInvalidateTileFull(_coords);
+            PathFinding::InvalidateFootpathGraph();
         }
     }
 
@@ -16,6 +16,7 @@
 #    include "../../../entity/EntityRegistry.h"
 #    include "../../../object/LargeSceneryEntry.h"
 #    include "../../../object/WallSceneryEntry.h"
+#    include "../../../peep/FootpathGraph.h"
 #    include "../../../ride/Ride.h"
 #    include "../../../ride/RideData.h"
 #    include "../../../ride/Track.h"
@@ -33,9 +34,37 @@
 
 namespace OpenRCT2::Scripting
 {
-    ScTileElement::ScTileElement(const CoordsXY& coords, TileElement* element)
+    ScTileElement::ElementRef::ElementRef(const CoordsXY& coords, size_t index)
         : _coords(coords)
-        , _element(element)
+        , _index(index)
+    {
+    }
+
+    TileElement* ScTileElement::ElementRef::operator->() const
+    {
+        auto* element = MapGetFirstElementAt(_coords);
+        if (element != nullptr)
+        {
+            for (size_t i = 0; i < _index; i++)
+            {
+                if ((element++)->IsLastForTile())
+                {
+                    element = nullptr;
+                    break;
+                }
+            }
+        }
+        if (element == nullptr)
+        {
+            auto ctx = GetContext()->GetScriptEngine().GetContext();
+            duk_error(ctx, DUK_ERR_RANGE_ERROR, "Tile element no longer exists.");
+        }
+        return element;
+    }
+
+    ScTileElement::ScTileElement(const CoordsXY& coords, size_t index)
+        : _coords(coords)
+        , _element(coords, index)
     {
     }
 
@@ -2148,6 +2177,7 @@ namespace OpenRCT2::Scripting
     void ScTileElement::Invalidate()
     {
         MapInvalidateTileFull(_coords);
+        PathFinding::InvalidateFootpathGraph();
     }
 
     const LargeSceneryElement* ScTileElement::GetOtherLargeSceneryElement(
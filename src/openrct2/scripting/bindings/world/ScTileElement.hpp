@@ -30,11 +30,25 @@ namespace OpenRCT2::Scripting
     class ScTileElement
     {
     protected:
+        /**
+         * Refers to a tile element by its tile and its index on the tile. The tile element arrays are replaced when
+         * they are compacted, so the element is looked up again whenever it is accessed.
+         */
+        class ElementRef
+        {
+            CoordsXY _coords;
+            size_t _index;
+
+        public:
+            ElementRef(const CoordsXY& coords, size_t index);
+            TileElement* operator->() const;
+        };
+
         CoordsXY _coords;
-        TileElement* _element;
+        ElementRef _element;
 
     public:
-        ScTileElement(const CoordsXY& coords, TileElement* element);
+        ScTileElement(const CoordsXY& coords, size_t index);
 
     private:
         std::string type_get() const;
@@ -26,8 +26,131 @@
 #include "tile_element/Slope.h"
 #include "tile_element/WallElement.h"
 
+#include <algorithm>
+#include <array>
+#include <unordered_map>
+
 using namespace OpenRCT2;
 
+/**
+ * The heights that the elements of a tile occupy, as far as MapCanConstructWithClearAt is concerned: one bit per height
+ * unit in each quadrant for every element that is neither the surface nor a ghost.
+ */
+struct TileOccupancy
+{
+    static constexpr int32_t kNumWords = 4;
+
+    std::array<std::array<uint64_t, kNumWords>, 4> QuadrantHeights{};
+    // Null if the tile has no single surface element, in which case its elements are always walked.
+    TileElement* Surface{};
+};
+
+static std::unordered_map<int32_t, TileOccupancy> _tileOccupancies;
+static int32_t _clearanceQueryScopeDepth;
+static bool _clearanceSummariesEnabled = true;
+
+// Returns the bits of the word at wordIndex for the height units [first, last).
+static uint64_t GetHeightWordMask(int32_t wordIndex, int32_t first, int32_t last)
+{
+    const auto wordBegin = wordIndex * 64;
+    const auto low = std::max(first - wordBegin, 0);
+    const auto high = std::min(last - wordBegin, 64);
+    if (low >= high)
+        return 0;
+
+    const auto width = high - low;
+    return (width == 64 ? ~uint64_t{ 0 } : ((uint64_t{ 1 } << width) - 1)) << low;
+}
+
+static const TileOccupancy& GetTileOccupancy(const CoordsXY& pos, TileElement* firstElement)
+{
+    const auto tilePos = TileCoordsXY(pos);
+    auto [it, inserted] = _tileOccupancies.try_emplace(tilePos.x + tilePos.y * kMaximumMapSizeTechnical);
+    auto& occupancy = it->second;
+    if (!inserted)
+        return occupancy;
+
+    auto* tileElement = firstElement;
+    int32_t numSurfaces = 0;
+    do
+    {
+        if (tileElement->GetType() == TileElementType::Surface)
+        {
+            occupancy.Surface = numSurfaces++ == 0 ? tileElement : nullptr;
+            continue;
+        }
+        if (tileElement->IsGhost())
+            continue;
+
+        // An element with no height is in the way of anything that spans its base height.
+        const int32_t baseHeight = tileElement->BaseHeight;
+        const int32_t clearanceHeight = tileElement->ClearanceHeight;
+        const auto first = std::min(baseHeight, clearanceHeight);
+        const auto last = baseHeight < clearanceHeight ? clearanceHeight : baseHeight + 1;
+        const auto quadrants = tileElement->GetOccupiedQuadrants();
+        for (int32_t quadrant = 0; quadrant < 4; quadrant++)
+        {
+            if (!(quadrants & (1 << quadrant)))
+                continue;
+
+            auto& heights = occupancy.QuadrantHeights[quadrant];
+            for (int32_t word = 0; word < TileOccupancy::kNumWords; word++)
+            {
+                heights[word] |= GetHeightWordMask(word, first, last);
+            }
+        }
+    } while (!(tileElement++)->IsLastForTile());
+
+    return occupancy;
+}
+
+// Whether any element other than the surface may be in the way, i.e. whether the elements of the tile have to be walked.
+static bool TileOccupancyOverlaps(const TileOccupancy& occupancy, const CoordsXYRangedZ& pos, uint8_t baseQuarters)
+{
+    const auto first = std::max(pos.baseZ, 0) / kCoordsZStep;
+    const auto last = std::max((std::max(pos.clearanceZ, 0) + kCoordsZStep - 1) / kCoordsZStep, first + 1);
+    for (int32_t quadrant = 0; quadrant < 4; quadrant++)
+    {
+        if (!(baseQuarters & (1 << quadrant)))
+            continue;
+
+        const auto& heights = occupancy.QuadrantHeights[quadrant];
+        for (int32_t word = 0; word < TileOccupancy::kNumWords; word++)
+        {
+            if (heights[word] & GetHeightWordMask(word, first, last))
+                return true;
+        }
+    }
+    return false;
+}
+
+ClearanceQueryScope::ClearanceQueryScope()
+{
+    _clearanceQueryScopeDepth++;
+}
+
+ClearanceQueryScope::~ClearanceQueryScope()
+{
+    if (--_clearanceQueryScopeDepth == 0)
+    {
+        MapInvalidateClearanceSummaries();
+    }
+}
+
+void MapInvalidateClearanceSummaries()
+{
+    if (!_tileOccupancies.empty())
+    {
+        _tileOccupancies.clear();
+    }
+}
+
+void MapSetClearanceSummariesEnabled(bool enabled)
+{
+    _clearanceSummariesEnabled = enabled;
+    MapInvalidateClearanceSummaries();
+}
+
 static int32_t MapPlaceClearFunc(
     TileElement** tile_element, const CoordsXY& coords, uint8_t flags, money64* price, bool is_scenery)
 {
@@ -155,6 +278,19 @@ GameActions::Result MapCanConstructWithClearAt(
         return res;
     }
 
+    // Elements that do not overlap the position are skipped without any effect, so when only the surface can be in
+    // the way the result is the same as walking every element.
+    bool surfaceOnly = false;
+    if (_clearanceQueryScopeDepth > 0 && _clearanceSummariesEnabled)
+    {
+        const auto& occupancy = GetTileOccupancy(pos, tileElement);
+        if (occupancy.Surface != nullptr && !TileOccupancyOverlaps(occupancy, pos, quarterTile.GetBaseQuarterOccupied()))
+        {
+            tileElement = occupancy.Surface;
+            surfaceOnly = true;
+        }
+    }
+
     do
     {
         if (tileElement->GetType() != TileElementType::Surface)
@@ -272,7 +408,7 @@ GameActions::Result MapCanConstructWithClearAt(
                 return res;
             }
         }
-    } while (!(tileElement++)->IsLastForTile());
+    } while (!surfaceOnly && !(tileElement++)->IsLastForTile());
 
     res.SetData(ConstructClearResult{ groundFlags });
 
@@ -46,3 +46,26 @@ struct ConstructClearResult
 [[nodiscard]] OpenRCT2::GameActions::Result MapCanConstructAt(const CoordsXYRangedZ& pos, QuarterTile bl);
 
 void MapGetObstructionErrorText(TileElement* tileElement, OpenRCT2::GameActions::Result& res);
+
+/**
+ * While a scope is active, MapCanConstructWithClearAt summarises the heights that the elements of a tile occupy in each
+ * quadrant the first time it checks the tile. Later checks on the tile that do not overlap any of those heights only
+ * look at the surface element instead of walking every element of the tile.
+ *
+ * The tile elements must not change while a scope is active, e.g. while querying where a track design can be placed.
+ * Inserting or removing elements drops the summaries as a precaution.
+ */
+class ClearanceQueryScope
+{
+public:
+    ClearanceQueryScope();
+    ~ClearanceQueryScope();
+
+    ClearanceQueryScope(const ClearanceQueryScope&) = delete;
+    ClearanceQueryScope& operator=(const ClearanceQueryScope&) = delete;
+};
+
+void MapInvalidateClearanceSummaries();
+
+// Enables or disables the summaries, e.g. to compare placement performance with and without them.
+void MapSetClearanceSummariesEnabled(bool enabled);
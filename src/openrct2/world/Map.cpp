@@ -37,6 +37,9 @@
 #include "../object/ObjectManager.h"
 #include "../object/SmallSceneryEntry.h"
 #include "../object/TerrainSurfaceObject.h"
+#include "../paint/PaintCache.h"
+#include "../peep/FootpathGraph.h"
+#include "../profiling/Metrics.h"
 #include "../profiling/Profiling.h"
 #include "../ride/RideConstruction.h"
 #include "../ride/RideData.h"
@@ -49,9 +52,11 @@
 #include "../world/TilePointerIndex.hpp"
 #include "Banner.h"
 #include "Climate.h"
+#include "ConstructionClearance.h"
 #include "Entrance.h"
 #include "Footpath.h"
 #include "MapAnimation.h"
+#include "MapChanges.h"
 #include "Park.h"
 #include "Scenery.h"
 #include "Surface.h"
@@ -86,6 +91,9 @@ const TileCoordsXY TileDirectionDelta[] = {
 };
 
 constexpr size_t MIN_TILE_ELEMENTS = 1024;
+constexpr size_t kCompactionMinFreeElements = 4096;
+constexpr int32_t kCompactionTilesPerTick = 16384;
+constexpr int32_t kNumTechnicalTiles = kMaximumMapSizeTechnical * kMaximumMapSizeTechnical;
 
 uint16_t gMapSelectFlags;
 uint16_t gMapSelectType;
@@ -108,8 +116,18 @@ static size_t _tileElementsInUse;
 static size_t _tileElementsInUseStash;
 static TileCoordsXY _mapSizeStash;
 
+// An incremental compaction copies the tiles in tile order to a new array, a bounded number of tiles per tick.
+// Tiles before _compactionNextTile have been copied to _compactedTileElements, the others are still in the
+// game state's array. When all tiles have been copied the new array replaces the old one.
+static std::vector<TileElement> _compactedTileElements;
+static int32_t _compactionNextTile = -1;
+
+static void FinishTileElementCompaction();
+
 void StashMap()
 {
+    FinishTileElementCompaction();
+
     auto& gameState = GetGameState();
     _tileIndexStash = std::move(_tileIndex);
     _tileElementsStash = std::move(gameState.TileElements);
@@ -144,15 +162,39 @@ CoordsXY GetMapSizeMaxXY()
 
 const std::vector<TileElement>& GetTileElements()
 {
+    FinishTileElementCompaction();
     return GetGameState().TileElements;
 }
 
+TileElementStats GetTileElementStats()
+{
+    const auto& tileElements = GetGameState().TileElements;
+    TileElementStats stats{};
+    stats.Capacity = tileElements.capacity() + _compactedTileElements.capacity();
+    stats.Allocated = tileElements.size() + _compactedTileElements.size();
+    stats.InUse = _tileElementsInUse;
+    if (_compactionNextTile != -1)
+    {
+        stats.CompactionProgress = static_cast<double>(_compactionNextTile) / kNumTechnicalTiles;
+    }
+    return stats;
+}
+
 void SetTileElements(GameState_t& gameState, std::vector<TileElement>&& tileElements)
 {
     gameState.TileElements = std::move(tileElements);
     _tileIndex = TilePointerIndex<TileElement>(
         kMaximumMapSizeTechnical, gameState.TileElements.data(), gameState.TileElements.size());
     _tileElementsInUse = gameState.TileElements.size();
+
+    // Any compaction in progress is superseded by the new elements
+    _compactedTileElements = std::vector<TileElement>();
+    _compactionNextTile = -1;
+
+    PathFinding::InvalidateFootpathGraph();
+    PaintCache::InvalidateAll();
+    MapChanges::MarkAll();
+    MapInvalidateClearanceSummaries();
 }
 
 static TileElement GetDefaultSurfaceElement()
@@ -212,6 +254,9 @@ std::vector<TileElement> GetReorganisedTileElementsWithoutGhosts()
 
 static void ReorganiseTileElements(GameState_t& gameState, size_t capacity)
 {
+    static auto& reorganisationsMetric = Metrics::GetCounter("map.tile_elements.reorganisations");
+    reorganisationsMetric.Add();
+
     ContextSetCurrentCursor(CursorID::ZZZ);
 
     std::vector<TileElement> newElements;
@@ -250,7 +295,126 @@ void ReorganiseTileElements()
     ReorganiseTileElements(gameState, gameState.TileElements.size());
 }
 
-static bool MapCheckFreeElementsAndReorganise(size_t numElementsOnTile, size_t numNewElements)
+static bool IsTileCompacted(const TileCoordsXY& tilePos)
+{
+    return _compactionNextTile != -1 && tilePos.x + (tilePos.y * kMaximumMapSizeTechnical) < _compactionNextTile;
+}
+
+// Returns the array that holds the elements of the given tile, this is only not the game state's array while a
+// compaction is in progress.
+static std::vector<TileElement>& GetTileElementStorage(const TileCoordsXY& tilePos)
+{
+    return IsTileCompacted(tilePos) ? _compactedTileElements : GetGameState().TileElements;
+}
+
+// Copies the elements of the next tile to the compacted array, fails if the compacted array is full.
+static bool CompactNextTile()
+{
+    const TileCoordsXY tilePos{ _compactionNextTile % kMaximumMapSizeTechnical,
+                                _compactionNextTile / kMaximumMapSizeTechnical };
+    const auto* element = _tileIndex.GetFirstElementAt(tilePos);
+
+    size_t numElements = 1;
+    if (element != nullptr)
+    {
+        while (!element[numElements - 1].IsLastForTile())
+        {
+            numElements++;
+        }
+    }
+
+    // The compacted array must never reallocate, the tile index points into it
+    if (_compactedTileElements.size() + numElements > _compactedTileElements.capacity())
+    {
+        return false;
+    }
+
+    auto* newFirstElement = _compactedTileElements.data() + _compactedTileElements.size();
+    if (element == nullptr)
+    {
+        _compactedTileElements.push_back(GetDefaultSurfaceElement());
+        _tileElementsInUse++;
+    }
+    else
+    {
+        _compactedTileElements.insert(_compactedTileElements.end(), element, element + numElements);
+    }
+    _tileIndex.SetTile(tilePos, newFirstElement);
+    _compactionNextTile++;
+    return true;
+}
+
+static void CompleteTileElementCompaction()
+{
+    static auto& compactionsMetric = Metrics::GetCounter("map.tile_elements.compactions");
+    compactionsMetric.Add();
+
+    // Moving the array keeps its storage, so the tile index stays valid
+    GetGameState().TileElements = std::move(_compactedTileElements);
+    _compactedTileElements = std::vector<TileElement>();
+    _compactionNextTile = -1;
+}
+
+// Copies the tiles before endTile to the compacted array, completing the compaction once every tile is copied.
+static void AdvanceTileElementCompaction(int32_t endTile)
+{
+    while (_compactionNextTile < endTile)
+    {
+        if (!CompactNextTile())
+        {
+            // Out of space, fall back to a full reorganisation which also ends the compaction
+            ReorganiseTileElements();
+            return;
+        }
+    }
+    if (_compactionNextTile == kNumTechnicalTiles)
+    {
+        CompleteTileElementCompaction();
+    }
+}
+
+static void FinishTileElementCompaction()
+{
+    if (_compactionNextTile == -1)
+        return;
+
+    AdvanceTileElementCompaction(kNumTechnicalTiles);
+}
+
+/**
+ * Removes the gaps left by moved and removed tile elements, spread over many ticks so that no single
+ * tile element insertion has to pay for a full reorganisation.
+ */
+void MapUpdateTileElementCompaction()
+{
+    PROFILED_FUNCTION();
+
+    // Saving a track design keeps pointers to the selected tile elements
+    if (gTrackDesignSaveMode)
+        return;
+
+    if (_compactionNextTile == -1)
+    {
+        const auto& tileElements = GetGameState().TileElements;
+        if (tileElements.size() <= _tileElementsInUse)
+            return;
+
+        // Start once a quarter of the array is unused, or earlier if the array is close to full
+        const auto numFreeElements = tileElements.size() - _tileElementsInUse;
+        const auto numSpareElements = tileElements.capacity() - tileElements.size();
+        if (numFreeElements < kCompactionMinFreeElements
+            || (numFreeElements < tileElements.size() / 4 && numSpareElements > tileElements.capacity() / 4))
+            return;
+
+        _compactedTileElements.reserve(std::max(MIN_TILE_ELEMENTS, _tileElementsInUse + _tileElementsInUse / 2));
+        _compactionNextTile = 0;
+    }
+
+    AdvanceTileElementCompaction(std::min(_compactionNextTile + kCompactionTilesPerTick, kNumTechnicalTiles));
+}
+
+static bool MapCheckFreeElementsAndReorganise(
+    const TileCoordsXY& tilePos, size_t numElementsOnTile, size_t numNewElements)
 {
     // Check hard cap on num in use tiles (this would be the size of _tileElements immediately after a reorg)
     if (_tileElementsInUse + numNewElements > MAX_TILE_ELEMENTS)
@@ -260,12 +424,32 @@ static bool MapCheckFreeElementsAndReorganise(size_t numElementsOnTile, size_t n
 
     auto& gameState = GetGameState();
     auto totalElementsRequired = numElementsOnTile + numNewElements;
-    auto freeElements = gameState.TileElements.capacity() - gameState.TileElements.size();
+    auto* storage = &GetTileElementStorage(tilePos);
+    auto freeElements = storage->capacity() - storage->size();
     if (freeElements >= totalElementsRequired)
     {
         return true;
     }
 
+    // While a compaction is in progress the old array is always fragmented, so rather than reorganising every tile
+    // move the compaction past this tile, the compacted array has been reserved with room to grow.
+    if (_compactionNextTile != -1)
+    {
+        AdvanceTileElementCompaction(tilePos.x + (tilePos.y * kMaximumMapSizeTechnical) + 1);
+        storage = &GetTileElementStorage(tilePos);
+        freeElements = storage->capacity() - storage->size();
+        if (freeElements >= totalElementsRequired)
+        {
+            return true;
+        }
+        FinishTileElementCompaction();
+        freeElements = gameState.TileElements.capacity() - gameState.TileElements.size();
+        if (freeElements >= totalElementsRequired)
+        {
+            return true;
+        }
+    }
+
     // if space issue is due to fragmentation then Reorg Tiles without increasing capacity
     if (gameState.TileElements.size() > totalElementsRequired + _tileElementsInUse)
     {
@@ -289,7 +473,7 @@ static size_t CountElementsOnTile(const CoordsXY& loc);
 bool MapCheckCapacityAndReorganise(const CoordsXY& loc, size_t numElements)
 {
     auto numElementsOnTile = CountElementsOnTile(loc);
-    return MapCheckFreeElementsAndReorganise(numElementsOnTile, numElements);
+    return MapCheckFreeElementsAndReorganise(TileCoordsXY(loc), numElementsOnTile, numElements);
 }
 
 static void ClearElementsAt(const CoordsXY& loc);
@@ -532,6 +716,10 @@ void MapStripGhostFlagFromElements()
     {
         element.SetGhost(false);
     }
+    for (auto& element : _compactedTileElements)
+    {
+        element.SetGhost(false);
+    }
 }
 
 /**
@@ -1022,6 +1210,8 @@ bool MapIsLocationAtEdge(const CoordsXY& loc)
  */
 void TileElementRemove(TileElement* tileElement)
 {
+    MapInvalidateClearanceSummaries();
+
     // Replace Nth element by (N+1)th element.
     // This loop will make tileElement point to the old last element position,
     // after copy it to it's new position
@@ -1042,6 +1232,10 @@ void TileElementRemove(TileElement* tileElement)
     {
         gameState.TileElements.pop_back();
     }
+    else if (!_compactedTileElements.empty() && tileElement == &_compactedTileElements.back())
+    {
+        _compactedTileElements.pop_back();
+    }
 }
 
 /**
@@ -1078,6 +1272,9 @@ void MapRemoveAllRides()
                 break;
         }
     } while (TileElementIteratorNext(&it));
+
+    PathFinding::InvalidateFootpathGraph();
+    MapChanges::MarkAll();
 }
 
 /**
@@ -1157,19 +1354,72 @@ static size_t CountElementsOnTile(const CoordsXY& loc)
     return count;
 }
 
-static TileElement* AllocateTileElements(size_t numElementsOnTile, size_t numNewElements)
+static TileElement* AllocateTileElements(const TileCoordsXY& tilePos, size_t numElementsOnTile, size_t numNewElements)
 {
-    if (!MapCheckFreeElementsAndReorganise(numElementsOnTile, numNewElements))
+    if (!MapCheckFreeElementsAndReorganise(tilePos, numElementsOnTile, numNewElements))
     {
         LOG_ERROR("Cannot insert new element");
         return nullptr;
     }
 
-    auto& gameState = GetGameState();
-    auto oldSize = gameState.TileElements.size();
-    gameState.TileElements.resize(gameState.TileElements.size() + numElementsOnTile + numNewElements);
+    auto& storage = GetTileElementStorage(tilePos);
+    auto oldSize = storage.size();
+    storage.resize(storage.size() + numElementsOnTile + numNewElements);
     _tileElementsInUse += numNewElements;
-    return &gameState.TileElements[oldSize];
+    return &storage[oldSize];
+}
+
+static void InitialiseInsertedElement(
+    TileElement* tileElement, TileElementType type, int32_t z, int32_t occupiedQuadrants, bool isLastForTile)
+{
+    tileElement->Type = 0;
+    tileElement->SetType(type);
+    tileElement->SetBaseZ(z);
+    tileElement->Flags = 0;
+    tileElement->SetLastForTile(isLastForTile);
+    tileElement->SetOccupiedQuadrants(occupiedQuadrants);
+    tileElement->SetClearanceZ(z);
+    tileElement->Owner = 0;
+    std::memset(&tileElement->Pad05, 0, sizeof(tileElement->Pad05));
+    std::memset(&tileElement->Pad08, 0, sizeof(tileElement->Pad08));
+}
+
+/**
+ * Inserts an element without moving the tile, which is possible when the tile is at the end of its array and the
+ * array has spare capacity. This is the common case when building on the same tile repeatedly.
+ * @returns nullptr if the tile has to be moved instead.
+ */
+static TileElement* TileElementInsertInPlace(
+    const CoordsXYZ& loc, size_t numElementsOnTile, int32_t occupiedQuadrants, TileElementType type)
+{
+    const auto tilePos = TileCoordsXY(loc);
+    auto& storage = GetTileElementStorage(tilePos);
+    auto* firstElement = _tileIndex.GetFirstElementAt(tilePos);
+    if (firstElement == nullptr || firstElement + numElementsOnTile != storage.data() + storage.size()
+        || storage.size() == storage.capacity() || _tileElementsInUse + 1 > MAX_TILE_ELEMENTS)
+    {
+        return nullptr;
+    }
+
+    storage.emplace_back();
+    _tileElementsInUse++;
+
+    size_t insertIndex = 0;
+    while (insertIndex < numElementsOnTile && loc.z >= firstElement[insertIndex].GetBaseZ())
+    {
+        insertIndex++;
+    }
+    std::copy_backward(firstElement + insertIndex, firstElement + numElementsOnTile, firstElement + numElementsOnTile + 1);
+
+    const bool isLastForTile = insertIndex == numElementsOnTile;
+    if (isLastForTile)
+    {
+        firstElement[insertIndex - 1].SetLastForTile(false);
+    }
+
+    auto* insertedElement = &firstElement[insertIndex];
+    InitialiseInsertedElement(insertedElement, type, loc.z, occupiedQuadrants, isLastForTile);
+    return insertedElement;
 }
 
 /**
@@ -1179,9 +1429,16 @@ static TileElement* AllocateTileElements(size_t numElementsOnTile, size_t numNew
 TileElement* TileElementInsert(const CoordsXYZ& loc, int32_t occupiedQuadrants, TileElementType type)
 {
     const auto& tileLoc = TileCoordsXYZ(loc);
+    MapChanges::MarkTile(loc);
+    MapInvalidateClearanceSummaries();
 
     auto numElementsOnTileOld = CountElementsOnTile(loc);
-    auto* newTileElement = AllocateTileElements(numElementsOnTileOld, 1);
+    if (auto* insertedElement = TileElementInsertInPlace(loc, numElementsOnTileOld, occupiedQuadrants, type))
+    {
+        return insertedElement;
+    }
+
+    auto* newTileElement = AllocateTileElements(tileLoc, numElementsOnTileOld, 1);
     auto* originalTileElement = _tileIndex.GetFirstElementAt(tileLoc);
     if (newTileElement == nullptr)
     {
@@ -1219,16 +1476,7 @@ TileElement* TileElementInsert(const CoordsXYZ& loc, int32_t occupiedQuadrants,
 
     // Insert new map element
     auto* insertedElement = newTileElement;
-    newTileElement->Type = 0;
-    newTileElement->SetType(type);
-    newTileElement->SetBaseZ(loc.z);
-    newTileElement->Flags = 0;
-    newTileElement->SetLastForTile(isLastForTile);
-    newTileElement->SetOccupiedQuadrants(occupiedQuadrants);
-    newTileElement->SetClearanceZ(loc.z);
-    newTileElement->Owner = 0;
-    std::memset(&newTileElement->Pad05, 0, sizeof(newTileElement->Pad05));
-    std::memset(&newTileElement->Pad08, 0, sizeof(newTileElement->Pad08));
+    InitialiseInsertedElement(newTileElement, type, loc.z, occupiedQuadrants, isLastForTile);
     newTileElement++;
 
     // Insert rest of map elements above insert height
@@ -1734,6 +1982,9 @@ bool MapLargeScenerySignSetColour(const CoordsXYZD& signPos, int32_t sequence, u
 
 static void MapInvalidateTileUnderZoom(int32_t x, int32_t y, int32_t z0, int32_t z1, ZoomLevel maxZoom)
 {
+    PaintCache::InvalidateTile({ x, y });
+    MapChanges::MarkTile({ x, y });
+
     if (gOpenRCT2Headless)
         return;
 
@@ -1783,6 +2034,9 @@ void MapInvalidateElement(const CoordsXY& elementPos, TileElement* tileElement)
 
 void MapInvalidateRegion(const CoordsXY& mins, const CoordsXY& maxs)
 {
+    PaintCache::InvalidateRegion(mins, maxs);
+    MapChanges::MarkRegion(mins, maxs);
+
     int32_t x0, y0, x1, y1, left, right, top, bottom;
 
     x0 = mins.x + 16;
@@ -2171,6 +2425,8 @@ void FixLandOwnershipTilesWithOwnership(std::vector<TileCoordsXY> tiles, uint8_t
         {
             surfaceElement->SetOwnership(ownership);
             Park::UpdateFencesAroundTile(tile.ToCoordsXY());
+            uint16_t baseZ = surfaceElement->GetBaseZ();
+            MapInvalidateTile({ tile.ToCoordsXY(), baseZ, baseZ + 16 });
         }
     }
 }
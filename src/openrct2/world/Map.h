@@ -116,9 +116,23 @@ namespace OpenRCT2
     struct GameState_t;
 }
 
+struct TileElementStats
+{
+    // Number of elements the tile element array can hold before it has to grow.
+    size_t Capacity;
+    // Number of elements in the array, including removed elements that have not been compacted yet.
+    size_t Allocated;
+    // Number of elements that are actually part of the map.
+    size_t InUse;
+    // Fraction of the tiles copied by the compaction in progress, 0 if no compaction is running.
+    double CompactionProgress;
+};
+
 void ReorganiseTileElements();
 const std::vector<TileElement>& GetTileElements();
+TileElementStats GetTileElementStats();
 void SetTileElements(OpenRCT2::GameState_t& gameState, std::vector<TileElement>&& tileElements);
+void MapUpdateTileElementCompaction();
 void StashMap();
 void UnstashMap();
 std::vector<TileElement> GetReorganisedTileElementsWithoutGhosts();
@@ -13,6 +13,7 @@
 #include "../Diagnostic.h"
 #include "../Game.h"
 #include "../GameState.h"
+#include "../OpenRCT2.h"
 #include "../entity/EntityList.h"
 #include "../entity/Peep.h"
 #include "../interface/Viewport.h"
@@ -31,45 +32,90 @@
 #include "tile_element/EntranceElement.h"
 #include "tile_element/WallElement.h"
 
+#include <algorithm>
+#include <numeric>
+#include <tuple>
+#include <unordered_map>
+
 using namespace OpenRCT2;
 
 using map_animation_invalidate_event_handler = bool (*)(const CoordsXYZ& loc);
 
+// The animations in the order they were created, which is the order they are updated in.
 static std::vector<MapAnimation> _mapAnimations;
-
-constexpr size_t MAX_ANIMATED_OBJECTS = 2000;
+// The index in _mapAnimations of each animation, keyed by its type and location.
+static std::unordered_map<uint64_t, size_t> _mapAnimationIndices;
+// The indices in _mapAnimations sorted by location, rebuilt for every clock tick.
+static std::vector<size_t> _mapAnimationsByLocation;
 
 static bool InvalidateMapAnimation(const MapAnimation& obj);
 
-static bool DoesAnimationExist(int32_t type, const CoordsXYZ& location)
+static uint64_t GetMapAnimationKey(int32_t type, const CoordsXYZ& location)
+{
+    return (static_cast<uint64_t>(type & 0xFF) << 48) | (static_cast<uint64_t>(location.x & 0xFFFF) << 32)
+        | (static_cast<uint64_t>(location.y & 0xFFFF) << 16) | static_cast<uint64_t>(location.z & 0xFFFF);
+}
+
+static void RebuildMapAnimationIndices()
 {
-    for (const auto& a : _mapAnimations)
+    _mapAnimationIndices.clear();
+    for (size_t i = 0; i < _mapAnimations.size(); i++)
     {
-        if (a.type == type && a.location == location)
-        {
-            // Animation already exists
-            return true;
-        }
+        const auto& a = _mapAnimations[i];
+        _mapAnimationIndices.emplace(GetMapAnimationKey(a.type, a.location), i);
+    }
+}
+
+// Removes the finished animations, keeping the others in the order they were created.
+static void RemoveMapAnimations(const std::vector<bool>& finished)
+{
+    size_t numKept = 0;
+    for (size_t i = 0; i < _mapAnimations.size(); i++)
+    {
+        if (i >= finished.size() || !finished[i])
+            _mapAnimations[numKept++] = _mapAnimations[i];
     }
-    return false;
+    _mapAnimations.resize(numKept);
+    RebuildMapAnimationIndices();
 }
 
 void MapAnimationCreate(int32_t type, const CoordsXYZ& loc)
 {
-    if (!DoesAnimationExist(type, loc))
+    auto [it, inserted] = _mapAnimationIndices.emplace(GetMapAnimationKey(type, loc), _mapAnimations.size());
+    if (inserted)
     {
-        if (_mapAnimations.size() < MAX_ANIMATED_OBJECTS)
-        {
-            // Create new animation
-            _mapAnimations.push_back({ static_cast<uint8_t>(type), loc });
-        }
-        else
-        {
-            LOG_ERROR("Exceeded the maximum number of animations");
-        }
+        // Create new animation
+        _mapAnimations.push_back({ static_cast<uint8_t>(type), loc });
+    }
+}
+
+/**
+ * Whether the animation changes the game state, rather than only redrawing its tile, so must be updated whether it is
+ * visible or not.
+ */
+static bool MapAnimationChangesGameState(const MapAnimation& a, bool isClockTick)
+{
+    switch (a.type)
+    {
+        case MAP_ANIMATION_TYPE_TRACK_ONRIDEPHOTO:
+        case MAP_ANIMATION_TYPE_WALL_DOOR:
+            return true;
+        case MAP_ANIMATION_TYPE_SMALL_SCENERY:
+            // Clocks make guests check the time.
+            return isClockTick;
+        default:
+            return false;
     }
 }
 
+static bool IsInAnyMapRange(const CoordsXY& location, const std::vector<MapRange>& ranges)
+{
+    return std::any_of(ranges.begin(), ranges.end(), [&location](const MapRange& range) {
+        return location.x >= range.GetLeft() && location.x <= range.GetRight() && location.y >= range.GetTop()
+            && location.y <= range.GetBottom();
+    });
+}
+
 /**
  *
  *  rct2: 0x0068AFAD
@@ -78,19 +124,47 @@ void MapAnimationInvalidateAll()
 {
     PROFILED_FUNCTION();
 
-    auto it = _mapAnimations.begin();
-    while (it != _mapAnimations.end())
+    // Redrawing an animation only has an effect in viewports zoomed in up to 1, see MapInvalidateTileZoom1. The tiles
+    // that are not visible are redrawn in full when they are scrolled into view.
+    const auto visibleRanges = gOpenRCT2Headless ? std::vector<MapRange>{} : ViewportsGetVisibleMapRanges(ZoomLevel{ 1 });
+    const bool isClockTick = !(GetGameState().CurrentTicks & 0x3FF) && GameIsNotPaused();
+
+    // Animations that finished while not visible are only removed when they are updated again, so a clock that is
+    // created again can keep its old place in the creation order on one client and not on another. Clocks can pick
+    // the same guest, so on clock ticks the animations are updated by location, which is the same on every client.
+    const auto numAnimations = _mapAnimations.size();
+    if (isClockTick)
     {
-        if (InvalidateMapAnimation(*it))
+        _mapAnimationsByLocation.resize(numAnimations);
+        std::iota(_mapAnimationsByLocation.begin(), _mapAnimationsByLocation.end(), 0);
+        std::sort(_mapAnimationsByLocation.begin(), _mapAnimationsByLocation.end(), [](size_t indexA, size_t indexB) {
+            const auto& a = _mapAnimations[indexA];
+            const auto& b = _mapAnimations[indexB];
+            return std::tie(a.location.x, a.location.y, a.location.z, a.type)
+                < std::tie(b.location.x, b.location.y, b.location.z, b.type);
+        });
+    }
+
+    std::vector<bool> finished;
+    for (size_t i = 0; i < numAnimations; i++)
+    {
+        const auto index = isClockTick ? _mapAnimationsByLocation[i] : i;
+        const auto a = _mapAnimations[index];
+        if (!MapAnimationChangesGameState(a, isClockTick) && !IsInAnyMapRange(a.location, visibleRanges))
+            continue;
+
+        if (InvalidateMapAnimation(a))
         {
             // Map animation has finished, remove it
-            it = _mapAnimations.erase(it);
-        }
-        else
-        {
-            it++;
+            finished.resize(numAnimations);
+            finished[index] = true;
         }
     }
+
+    if (!finished.empty())
+    {
+        RemoveMapAnimations(finished);
+    }
 }
 
 /**
@@ -605,6 +679,7 @@ const std::vector<MapAnimation>& GetMapAnimations()
 void ClearMapAnimations()
 {
     _mapAnimations.clear();
+    _mapAnimationIndices.clear();
 }
 
 void MapAnimationAutoCreate()
@@ -721,4 +796,5 @@ void ShiftAllMapAnimations(CoordsXY amount)
     {
         a.location += amount;
     }
+    RebuildMapAnimationIndices();
 }
@@ -0,0 +1,122 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "MapChanges.h"
+
+#include "Map.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+
+namespace OpenRCT2::MapChanges
+{
+    static constexpr size_t kNumTiles = kMaximumMapSizeTechnical * kMaximumMapSizeTechnical;
+    static constexpr size_t kBitsPerWord = 64;
+
+    // One bit per tile, empty while nothing is tracking the changes.
+    static std::vector<uint64_t> _changedTiles;
+    static bool _anyChanged{};
+    static bool _allChanged{};
+
+    void StartTracking()
+    {
+        _changedTiles.assign((kNumTiles + kBitsPerWord - 1) / kBitsPerWord, 0);
+        _anyChanged = false;
+        _allChanged = true;
+    }
+
+    void StopTracking()
+    {
+        _changedTiles = {};
+        _anyChanged = false;
+        _allChanged = false;
+    }
+
+    static void MarkTileIndex(int32_t x, int32_t y)
+    {
+        const auto index = static_cast<size_t>(x + y * kMaximumMapSizeTechnical);
+        _changedTiles[index / kBitsPerWord] |= uint64_t{ 1 } << (index % kBitsPerWord);
+    }
+
+    void MarkTile(const CoordsXY& mapPos)
+    {
+        if (_changedTiles.empty())
+            return;
+
+        const auto tilePos = TileCoordsXY(mapPos);
+        if (tilePos.x < 0 || tilePos.y < 0 || tilePos.x >= kMaximumMapSizeTechnical || tilePos.y >= kMaximumMapSizeTechnical)
+            return;
+
+        MarkTileIndex(tilePos.x, tilePos.y);
+        _anyChanged = true;
+    }
+
+    void MarkRegion(const CoordsXY& mins, const CoordsXY& maxs)
+    {
+        if (_changedTiles.empty())
+            return;
+
+        const auto tileMin = TileCoordsXY(mins);
+        const auto tileMax = TileCoordsXY(maxs);
+        const auto minX = std::max(tileMin.x, 0);
+        const auto minY = std::max(tileMin.y, 0);
+        const auto maxX = std::min(tileMax.x, kMaximumMapSizeTechnical - 1);
+        const auto maxY = std::min(tileMax.y, kMaximumMapSizeTechnical - 1);
+        for (int32_t y = minY; y <= maxY; y++)
+        {
+            for (int32_t x = minX; x <= maxX; x++)
+            {
+                MarkTileIndex(x, y);
+            }
+        }
+        _anyChanged |= minX <= maxX && minY <= maxY;
+    }
+
+    void MarkAll()
+    {
+        if (_changedTiles.empty())
+            return;
+
+        _allChanged = true;
+    }
+
+    bool TakeChangedTiles(std::vector<TileCoordsXY>& tiles)
+    {
+        tiles.clear();
+        if (_allChanged)
+        {
+            std::fill(_changedTiles.begin(), _changedTiles.end(), 0);
+            _anyChanged = false;
+            _allChanged = false;
+            return false;
+        }
+        if (!_anyChanged)
+            return true;
+
+        for (size_t wordIndex = 0; wordIndex < _changedTiles.size(); wordIndex++)
+        {
+            auto word = _changedTiles[wordIndex];
+            if (word == 0)
+                continue;
+
+            _changedTiles[wordIndex] = 0;
+            while (word != 0)
+            {
+                const auto index = wordIndex * kBitsPerWord + std::countr_zero(word);
+                tiles.emplace_back(
+                    static_cast<int32_t>(index % kMaximumMapSizeTechnical),
+                    static_cast<int32_t>(index / kMaximumMapSizeTechnical));
+                word &= word - 1;
+            }
+        }
+        _anyChanged = false;
+        return true;
+    }
+} // namespace OpenRCT2::MapChanges
@@ -0,0 +1,35 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "Location.hpp"
+
+#include <vector>
+
+/**
+ * Records which tiles have changed, so that a view of the whole map such as the minimap only has to look at those
+ * tiles again. Tiles are marked through the MapInvalidate functions, which tile element changes already call so the
+ * dirty area is redrawn, and when tile elements are inserted. Nothing is recorded until tracking is started.
+ */
+namespace OpenRCT2::MapChanges
+{
+    // Starts recording changed tiles, with every tile marked as changed.
+    void StartTracking();
+    void StopTracking();
+
+    void MarkTile(const CoordsXY& mapPos);
+    void MarkRegion(const CoordsXY& mins, const CoordsXY& maxs);
+    void MarkAll();
+
+    // Moves the tiles changed since the last call into tiles. Returns false instead when the whole map may have
+    // changed, e.g. after loading a park, in which case tiles is left empty.
+    bool TakeChangedTiles(std::vector<TileCoordsXY>& tiles);
+
+} // namespace OpenRCT2::MapChanges
@@ -15,7 +15,9 @@
 #include "../GameState.h"
 #include "../core/Guard.hpp"
 #include "../core/Imaging.h"
+#include "../core/JobPool.h"
 #include "../core/String.hpp"
+#include "../core/Timer.hpp"
 #include "../localisation/StringIds.h"
 #include "../object/ObjectEntryManager.h"
 #include "../object/ObjectList.h"
@@ -34,6 +36,10 @@
 #include <cmath>
 #include <cstring>
 #include <iterator>
+#include <memory>
+#include <numbers>
+#include <optional>
+#include <random>
 #include <vector>
 
 using namespace OpenRCT2;
@@ -49,6 +55,85 @@ static struct
 
 #pragma endregion Height map struct
 
+#pragma region Random and parallel helpers
+
+// All randomness used by the generator comes from this engine so that a map can be regenerated from its seed.
+static std::mt19937 _mapGenRandom;
+static std::optional<float> _mapGenNormalSpare;
+
+static uint32_t MapGenRand()
+{
+    return _mapGenRandom();
+}
+
+/**
+ * Returns a standard normal distributed value using the Box-Muller transform. std::normal_distribution is not used as
+ * its output differs between standard libraries, which would make the same seed produce different maps.
+ */
+static float MapGenRandNormalDistributed()
+{
+    if (_mapGenNormalSpare.has_value())
+    {
+        const auto value = *_mapGenNormalSpare;
+        _mapGenNormalSpare.reset();
+        return value;
+    }
+
+    // u1 is in (0, 1] so that its logarithm is finite, u2 is in [0, 1).
+    constexpr double kScale = 1.0 / 16777216.0;
+    const double u1 = ((MapGenRand() >> 8) + 1) * kScale;
+    const double u2 = (MapGenRand() >> 8) * kScale;
+    const double radius = std::sqrt(-2.0 * std::log(u1));
+    const double angle = 2.0 * std::numbers::pi * u2;
+    _mapGenNormalSpare = static_cast<float>(radius * std::sin(angle));
+    return static_cast<float>(radius * std::cos(angle));
+}
+
+// Only set while a map is being generated, the pool is owned by MapGenGenerate.
+static JobPool* _mapGenJobs;
+
+/**
+ * Splits the rows [begin, end) into bands and runs fn(bandBegin, bandEnd) for each band on the job pool.
+ * Every band must only write to its own rows so that the result does not depend on scheduling.
+ */
+template<typename TFn> static void MapGenForEachRowBand(int32_t begin, int32_t end, TFn&& fn)
+{
+    constexpr int32_t kRowsPerBand = 16;
+    for (int32_t bandBegin = begin; bandBegin < end; bandBegin += kRowsPerBand)
+    {
+        const int32_t bandEnd = std::min(bandBegin + kRowsPerBand, end);
+        _mapGenJobs->AddTask([&fn, bandBegin, bandEnd]() { fn(bandBegin, bandEnd); });
+    }
+    _mapGenJobs->Join();
+}
+
+static std::vector<MapGenPhaseTiming>* _phaseTimings;
+
+/**
+ * Records the time spent in the enclosing scope as a phase of the generator, if timings were requested.
+ */
+class MapGenPhaseTimer
+{
+    std::string_view _name;
+    Timer _timer;
+
+public:
+    explicit MapGenPhaseTimer(std::string_view name)
+        : _name(name)
+    {
+    }
+
+    ~MapGenPhaseTimer()
+    {
+        if (_phaseTimings != nullptr)
+        {
+            _phaseTimings->push_back({ _name, _timer.GetElapsedTime().count() * 1000.0f });
+        }
+    }
+};
+
+#pragma endregion
+
 #pragma region Random objects
 
 static constexpr const char* GrassTrees[] = {
@@ -100,8 +185,14 @@ static void MapGenGenerateFromHeightmapImage(MapGenSettings* settings);
 static void MapGenPlaceTrees(MapGenSettings* settings);
 static void MapGenAddBeaches(MapGenSettings* settings);
 
-void MapGenGenerate(MapGenSettings* settings)
+void MapGenGenerate(MapGenSettings* settings, std::vector<MapGenPhaseTiming>* timings)
 {
+    JobPool jobs;
+    _mapGenJobs = &jobs;
+    _phaseTimings = timings;
+    _mapGenRandom.seed(settings->seed != 0 ? settings->seed : UtilRand());
+    _mapGenNormalSpare.reset();
+
     // First, generate the height map
     switch (settings->algorithm)
     {
@@ -125,6 +216,9 @@ void MapGenGenerate(MapGenSettings* settings)
     // Place trees?
     if (settings->trees)
         MapGenPlaceTrees(settings);
+
+    _phaseTimings = nullptr;
+    _mapGenJobs = nullptr;
 }
 
 static void MapGenSetWaterLevel(int32_t waterLevel);
@@ -132,6 +226,8 @@ static void MapGenSmoothHeight(int32_t iterations);
 static void MapGenSetHeight(MapGenSettings* settings);
 
 static float FractalNoise(int32_t x, int32_t y, float frequency, int32_t octaves, float lacunarity, float persistence);
+static void FractalNoiseRow(
+    int32_t y, int32_t width, float frequency, int32_t octaves, float lacunarity, float persistence, float* output);
 static void MapGenSimplex(MapGenSettings* settings);
 
 static TileCoordsXY _heightSize;
@@ -169,7 +265,7 @@ static ObjectEntryIndex MapGenSurfaceTextureId(MapGenSettings* settings)
             // Fall back to the first available surface texture that is available in the park
             surfaceTexture = TerrainSurfaceObject::GetById(0)->GetIdentifier();
         else
-            surfaceTexture = availableTerrains[UtilRand() % availableTerrains.size()];
+            surfaceTexture = availableTerrains[MapGenRand() % availableTerrains.size()];
     }
 
     auto surfaceTextureId = objectManager.GetLoadedObjectEntryIndex(ObjectEntryDescriptor(surfaceTexture));
@@ -207,6 +303,8 @@ static ObjectEntryIndex MapGenEdgeTextureId(MapGenSettings* settings, ObjectEntr
 
 static void MapGenResetSurfaces(MapGenSettings* settings)
 {
+    MapGenPhaseTimer phaseTimer("reset surfaces");
+
     MapClearAllElements();
     MapInit(settings->mapSize);
 
@@ -246,7 +344,7 @@ static void MapGenGenerateSimplex(MapGenSettings* settings)
     std::fill_n(_height, _heightSize.y * _heightSize.x, 0x00);
 
     MapGenSimplex(settings);
-    MapGenSmoothHeight(2 + (UtilRand() % 6));
+    MapGenSmoothHeight(2 + (MapGenRand() % 6));
 
     // Set the game map to the height map
     MapGenSetHeight(settings);
@@ -254,6 +352,8 @@ static void MapGenGenerateSimplex(MapGenSettings* settings)
 
     if (settings->smoothTileEdges)
     {
+        MapGenPhaseTimer phaseTimer("smooth tile edges");
+
         // Set the tile slopes so that there are no cliffs
         while (MapSmooth(1, 1, mapSize.x - 1, mapSize.y - 1))
         {
@@ -266,6 +366,8 @@ static void MapGenGenerateSimplex(MapGenSettings* settings)
 
 static void MapGenAddBeaches(MapGenSettings* settings)
 {
+    MapGenPhaseTimer phaseTimer("beaches");
+
     auto& objectManager = OpenRCT2::GetContext()->GetObjectManager();
 
     // Figure out what beach texture to use
@@ -278,21 +380,23 @@ static void MapGenAddBeaches(MapGenSettings* settings)
     if (availableBeachTextures.empty())
         return;
 
-    std::string_view beachTexture = availableBeachTextures[UtilRand() % availableBeachTextures.size()];
+    std::string_view beachTexture = availableBeachTextures[MapGenRand() % availableBeachTextures.size()];
     auto beachTextureId = objectManager.GetLoadedObjectEntryIndex(ObjectEntryDescriptor(beachTexture));
 
     // Add sandy beaches
     const auto& mapSize = settings->mapSize;
-    for (auto y = 1; y < mapSize.y - 1; y++)
-    {
-        for (auto x = 1; x < mapSize.x - 1; x++)
+    MapGenForEachRowBand(1, mapSize.y - 1, [&](int32_t yBegin, int32_t yEnd) {
+        for (auto y = yBegin; y < yEnd; y++)
         {
-            auto surfaceElement = MapGetSurfaceElementAt(TileCoordsXY{ x, y });
+            for (auto x = 1; x < mapSize.x - 1; x++)
+            {
+                auto surfaceElement = MapGetSurfaceElementAt(TileCoordsXY{ x, y });
 
-            if (surfaceElement != nullptr && surfaceElement->BaseHeight < settings->waterLevel + 6)
-                surfaceElement->SetSurfaceObjectIndex(beachTextureId);
+                if (surfaceElement != nullptr && surfaceElement->BaseHeight < settings->waterLevel + 6)
+                    surfaceElement->SetSurfaceObjectIndex(beachTextureId);
+            }
         }
-    }
+    });
 }
 
 static void MapGenPlaceTree(ObjectEntryIndex type, const CoordsXY& loc)
@@ -309,7 +413,7 @@ static void MapGenPlaceTree(ObjectEntryIndex type, const CoordsXY& loc)
     Guard::Assert(sceneryElement != nullptr);
 
     sceneryElement->SetClearanceZ(surfaceZ + sceneryEntry->height);
-    sceneryElement->SetDirection(UtilRand() & 3);
+    sceneryElement->SetDirection(MapGenRand() & 3);
     sceneryElement->SetEntryIndex(type);
     sceneryElement->SetAge(0);
     sceneryElement->SetPrimaryColour(COLOUR_YELLOW);
@@ -349,6 +453,8 @@ template<typename T> static bool TryFindTreeInList(std::string_view id, const T&
  */
 static void MapGenPlaceTrees(MapGenSettings* settings)
 {
+    MapGenPhaseTimer phaseTimer("trees");
+
     std::vector<int32_t> grassTreeIds;
     std::vector<int32_t> desertTreeIds;
     std::vector<int32_t> snowTreeIds;
@@ -379,31 +485,32 @@ static void MapGenPlaceTrees(MapGenSettings* settings)
     float treeToLandRatio = static_cast<float>(settings->treeToLandRatio) / 100.0f;
 
     auto& gameState = GetGameState();
-    for (int32_t y = 1; y < gameState.MapSize.y - 1; y++)
-    {
-        for (int32_t x = 1; x < gameState.MapSize.x - 1; x++)
+    const auto mapSize = gameState.MapSize;
+
+    // The oasis score and the grouping noise only read the map, so they are computed for every tile in parallel up front.
+    // Only the random rolls and the element insertion below have to happen in order.
+    std::vector<float> oasisScores(mapSize.x * mapSize.y);
+    std::vector<float> noiseValues(mapSize.x * mapSize.y);
+    MapGenForEachRowBand(1, mapSize.y - 1, [&](int32_t yBegin, int32_t yEnd) {
+        for (int32_t y = yBegin; y < yEnd; y++)
         {
-            auto pos = CoordsXY{ x, y } * kCoordsXYStep;
-            auto* surfaceElement = MapGetSurfaceElementAt(pos);
-            if (surfaceElement == nullptr)
-                continue;
+            for (int32_t x = 1; x < mapSize.x - 1; x++)
+            {
+                // Use fractal noise to group tiles that are likely to spawn trees together
+                noiseValues[x + y * mapSize.x] = FractalNoise(x, y, 0.025f, 2, 2.0f, 0.65f);
 
-            // Don't place on water
-            if (surfaceElement->GetWaterHeight() > 0)
-                continue;
+                // On sand surfaces, give the tile a score based on nearby water, to be used to determine whether to spawn
+                // vegetation
+                auto pos = CoordsXY{ x, y } * kCoordsXYStep;
+                auto* surfaceElement = MapGetSurfaceElementAt(pos);
+                if (surfaceElement == nullptr)
+                    continue;
 
-            if (settings->minTreeAltitude > surfaceElement->BaseHeight
-                || settings->maxTreeAltitude < surfaceElement->BaseHeight)
-                continue;
+                const auto& surfaceStyleObject = *TerrainSurfaceObject::GetById(surfaceElement->GetSurfaceObjectIndex());
+                if (!MapGenSurfaceTakesSandTrees(surfaceStyleObject))
+                    continue;
 
-            // On sand surfaces, give the tile a score based on nearby water, to be used to determine whether to spawn
-            // vegetation
-            float oasisScore = 0.0f;
-            ObjectEntryIndex treeObjectEntryIndex = OBJECT_ENTRY_INDEX_NULL;
-            const auto& surfaceStyleObject = *TerrainSurfaceObject::GetById(surfaceElement->GetSurfaceObjectIndex());
-            if (MapGenSurfaceTakesSandTrees(surfaceStyleObject))
-            {
-                oasisScore = -0.5f;
+                float oasisScore = -0.5f;
                 constexpr auto maxOasisDistance = 4;
                 for (int32_t offsetY = -maxOasisDistance; offsetY <= maxOasisDistance; offsetY++)
                 {
@@ -412,8 +519,8 @@ static void MapGenPlaceTrees(MapGenSettings* settings)
                         // Get map coord, clamped to the edges
                         const auto offset = CoordsXY{ offsetX * kCoordsXYStep, offsetY * kCoordsXYStep };
                         auto neighbourPos = pos + offset;
-                        neighbourPos.x = std::clamp(neighbourPos.x, kCoordsXYStep, kCoordsXYStep * (gameState.MapSize.x - 1));
-                        neighbourPos.y = std::clamp(neighbourPos.y, kCoordsXYStep, kCoordsXYStep * (gameState.MapSize.y - 1));
+                        neighbourPos.x = std::clamp(neighbourPos.x, kCoordsXYStep, kCoordsXYStep * (mapSize.x - 1));
+                        neighbourPos.y = std::clamp(neighbourPos.y, kCoordsXYStep, kCoordsXYStep * (mapSize.y - 1));
 
                         const auto neighboutSurface = MapGetSurfaceElementAt(neighbourPos);
                         if (neighboutSurface != nullptr && neighboutSurface->GetWaterHeight() > 0)
@@ -423,31 +530,54 @@ static void MapGenPlaceTrees(MapGenSettings* settings)
                         }
                     }
                 }
+                oasisScores[x + y * mapSize.x] = oasisScore;
             }
+        }
+    });
+
+    for (int32_t y = 1; y < mapSize.y - 1; y++)
+    {
+        for (int32_t x = 1; x < mapSize.x - 1; x++)
+        {
+            auto pos = CoordsXY{ x, y } * kCoordsXYStep;
+            auto* surfaceElement = MapGetSurfaceElementAt(pos);
+            if (surfaceElement == nullptr)
+                continue;
+
+            // Don't place on water
+            if (surfaceElement->GetWaterHeight() > 0)
+                continue;
+
+            if (settings->minTreeAltitude > surfaceElement->BaseHeight
+                || settings->maxTreeAltitude < surfaceElement->BaseHeight)
+                continue;
+
+            float oasisScore = oasisScores[x + y * mapSize.x];
+            ObjectEntryIndex treeObjectEntryIndex = OBJECT_ENTRY_INDEX_NULL;
+            const auto& surfaceStyleObject = *TerrainSurfaceObject::GetById(surfaceElement->GetSurfaceObjectIndex());
 
             // Use tree:land ratio except when near an oasis
             constexpr static auto randModulo = 0xFFFF;
-            if (static_cast<float>(UtilRand() & randModulo) / randModulo > std::max(treeToLandRatio, oasisScore))
+            if (static_cast<float>(MapGenRand() & randModulo) / randModulo > std::max(treeToLandRatio, oasisScore))
                 continue;
 
-            // Use fractal noise to group tiles that are likely to spawn trees together
-            float noiseValue = FractalNoise(x, y, 0.025f, 2, 2.0f, 0.65f);
+            float noiseValue = noiseValues[x + y * mapSize.x];
             // Reduces the range to rarely stray further than 0.5 from the mean.
-            float noiseOffset = UtilRandNormalDistributed() * 0.25f;
+            float noiseOffset = MapGenRandNormalDistributed() * 0.25f;
             if (noiseValue + oasisScore < noiseOffset)
                 continue;
 
             if (!grassTreeIds.empty() && MapGenSurfaceTakesGrassTrees(surfaceStyleObject))
             {
-                treeObjectEntryIndex = grassTreeIds[UtilRand() % grassTreeIds.size()];
+                treeObjectEntryIndex = grassTreeIds[MapGenRand() % grassTreeIds.size()];
             }
             else if (!desertTreeIds.empty() && MapGenSurfaceTakesSandTrees(surfaceStyleObject))
             {
-                treeObjectEntryIndex = desertTreeIds[UtilRand() % desertTreeIds.size()];
+                treeObjectEntryIndex = desertTreeIds[MapGenRand() % desertTreeIds.size()];
             }
             else if (!snowTreeIds.empty() && MapGenSurfaceTakesSnowTrees(surfaceStyleObject))
             {
-                treeObjectEntryIndex = snowTreeIds[UtilRand() % snowTreeIds.size()];
+                treeObjectEntryIndex = snowTreeIds[MapGenRand() % snowTreeIds.size()];
             }
 
             if (treeObjectEntryIndex != OBJECT_ENTRY_INDEX_NULL)
@@ -461,49 +591,63 @@ static void MapGenPlaceTrees(MapGenSettings* settings)
  */
 static void MapGenSetWaterLevel(int32_t waterLevel)
 {
-    auto& gameState = GetGameState();
-    for (int32_t y = 1; y < gameState.MapSize.y - 1; y++)
-    {
-        for (int32_t x = 1; x < gameState.MapSize.x - 1; x++)
+    MapGenPhaseTimer phaseTimer("water level");
+
+    const auto mapSize = GetGameState().MapSize;
+    MapGenForEachRowBand(1, mapSize.y - 1, [&](int32_t yBegin, int32_t yEnd) {
+        for (int32_t y = yBegin; y < yEnd; y++)
         {
-            auto surfaceElement = MapGetSurfaceElementAt(TileCoordsXY{ x, y });
-            if (surfaceElement != nullptr && surfaceElement->BaseHeight < waterLevel)
-                surfaceElement->SetWaterHeight(waterLevel * kCoordsZStep);
+            for (int32_t x = 1; x < mapSize.x - 1; x++)
+            {
+                auto surfaceElement = MapGetSurfaceElementAt(TileCoordsXY{ x, y });
+                if (surfaceElement != nullptr && surfaceElement->BaseHeight < waterLevel)
+                    surfaceElement->SetWaterHeight(waterLevel * kCoordsZStep);
+            }
         }
-    }
+    });
 }
 
 /**
- * Smooths the height map.
+ * Smooths the height map with a 3x3 box filter, applied as a horizontal and a vertical pass.
  */
 static void MapGenSmoothHeight(int32_t iterations)
 {
-    int32_t i, x, y, xx, yy, avg;
-    int32_t arraySize = _heightSize.y * _heightSize.x * sizeof(uint8_t);
-    uint8_t* copyHeight = new uint8_t[arraySize];
+    MapGenPhaseTimer phaseTimer("smooth height");
 
-    for (i = 0; i < iterations; i++)
+    const int32_t width = _heightSize.x;
+    const int32_t height = _heightSize.y;
+    std::vector<uint16_t> rowSums(width * height);
+
+    for (int32_t i = 0; i < iterations; i++)
     {
-        std::memcpy(copyHeight, _height, arraySize);
-        for (y = 1; y < _heightSize.y - 1; y++)
-        {
-            for (x = 1; x < _heightSize.x - 1; x++)
+        // Sum each pixel with its left and right neighbours
+        MapGenForEachRowBand(0, height, [&](int32_t yBegin, int32_t yEnd) {
+            for (int32_t y = yBegin; y < yEnd; y++)
             {
-                avg = 0;
-                for (yy = -1; yy <= 1; yy++)
+                const uint8_t* src = &_height[y * width];
+                uint16_t* dst = &rowSums[y * width];
+                for (int32_t x = 1; x < width - 1; x++)
                 {
-                    for (xx = -1; xx <= 1; xx++)
-                    {
-                        avg += copyHeight[(y + yy) * _heightSize.x + (x + xx)];
-                    }
+                    dst[x] = src[x - 1] + src[x] + src[x + 1];
                 }
-                avg /= 9;
-                SetHeight(x, y, avg);
             }
-        }
-    }
+        });
 
-    delete[] copyHeight;
+        // Sum the row sums above and below, which gives the same average as the full 3x3 kernel
+        MapGenForEachRowBand(1, height - 1, [&](int32_t yBegin, int32_t yEnd) {
+            for (int32_t y = yBegin; y < yEnd; y++)
+            {
+                const uint16_t* above = &rowSums[(y - 1) * width];
+                const uint16_t* centre = &rowSums[y * width];
+                const uint16_t* below = &rowSums[(y + 1) * width];
+                uint8_t* dst = &_height[y * width];
+                for (int32_t x = 1; x < width - 1; x++)
+                {
+                    dst[x] = (above[x] + centre[x] + below[x]) / 9;
+                }
+            }
+        });
+    }
 }
 
 /**
@@ -511,47 +655,49 @@ static void MapGenSmoothHeight(int32_t iterations)
  */
 static void MapGenSetHeight(MapGenSettings* settings)
 {
-    int32_t x, y, heightX, heightY;
+    MapGenPhaseTimer phaseTimer("set height");
 
-    for (y = 1; y < _heightSize.y / 2 - 1; y++)
-    {
-        for (x = 1; x < _heightSize.x / 2 - 1; x++)
+    MapGenForEachRowBand(1, _heightSize.y / 2 - 1, [&](int32_t yBegin, int32_t yEnd) {
+        for (int32_t y = yBegin; y < yEnd; y++)
         {
-            heightX = x * 2;
-            heightY = y * 2;
+            for (int32_t x = 1; x < _heightSize.x / 2 - 1; x++)
+            {
+                const int32_t heightX = x * 2;
+                const int32_t heightY = y * 2;
 
-            uint8_t q00 = GetHeight(heightX + 0, heightY + 0);
-            uint8_t q01 = GetHeight(heightX + 0, heightY + 1);
-            uint8_t q10 = GetHeight(heightX + 1, heightY + 0);
-            uint8_t q11 = GetHeight(heightX + 1, heightY + 1);
+                uint8_t q00 = GetHeight(heightX + 0, heightY + 0);
+                uint8_t q01 = GetHeight(heightX + 0, heightY + 1);
+                uint8_t q10 = GetHeight(heightX + 1, heightY + 0);
+                uint8_t q11 = GetHeight(heightX + 1, heightY + 1);
 
-            uint8_t baseHeight = (q00 + q01 + q10 + q11) / 4;
+                uint8_t baseHeight = (q00 + q01 + q10 + q11) / 4;
 
-            auto surfaceElement = MapGetSurfaceElementAt(TileCoordsXY{ x, y });
-            if (surfaceElement == nullptr)
-                continue;
-            surfaceElement->BaseHeight = std::max(2, baseHeight * 2);
+                auto surfaceElement = MapGetSurfaceElementAt(TileCoordsXY{ x, y });
+                if (surfaceElement == nullptr)
+                    continue;
+                surfaceElement->BaseHeight = std::max(2, baseHeight * 2);
 
-            // If base height is below water level, lower it to create more natural shorelines
-            if (surfaceElement->BaseHeight >= 4 && surfaceElement->BaseHeight <= settings->waterLevel)
-                surfaceElement->BaseHeight -= 2;
+                // If base height is below water level, lower it to create more natural shorelines
+                if (surfaceElement->BaseHeight >= 4 && surfaceElement->BaseHeight <= settings->waterLevel)
+                    surfaceElement->BaseHeight -= 2;
 
-            surfaceElement->ClearanceHeight = surfaceElement->BaseHeight;
+                surfaceElement->ClearanceHeight = surfaceElement->BaseHeight;
 
-            uint8_t currentSlope = surfaceElement->GetSlope();
+                uint8_t currentSlope = surfaceElement->GetSlope();
 
-            if (q00 > baseHeight)
-                currentSlope |= kTileSlopeSCornerUp;
-            if (q01 > baseHeight)
-                currentSlope |= kTileSlopeWCornerUp;
-            if (q10 > baseHeight)
-                currentSlope |= kTileSlopeECornerUp;
-            if (q11 > baseHeight)
-                currentSlope |= kTileSlopeNCornerUp;
+                if (q00 > baseHeight)
+                    currentSlope |= kTileSlopeSCornerUp;
+                if (q01 > baseHeight)
+                    currentSlope |= kTileSlopeWCornerUp;
+                if (q10 > baseHeight)
+                    currentSlope |= kTileSlopeECornerUp;
+                if (q11 > baseHeight)
+                    currentSlope |= kTileSlopeNCornerUp;
 
-            surfaceElement->SetSlope(currentSlope);
+                surfaceElement->SetSlope(currentSlope);
+            }
         }
-    }
+    });
 }
 
 #pragma region Noise
@@ -573,7 +719,7 @@ static void NoiseRand()
 {
     for (auto& i : perm)
     {
-        i = UtilRand() & 0xFF;
+        i = MapGenRand() & 0xFF;
     }
 }
 
@@ -590,13 +736,45 @@ static float FractalNoise(int32_t x, int32_t y, float frequency, int32_t octaves
     return total;
 }
 
+/**
+ * Evaluates FractalNoise for the samples (0, y) to (width - 1, y). The samples are processed octave by octave in fixed
+ * size batches so the compiler can vectorise the branch-free Generate, the result is identical to calling FractalNoise
+ * for every sample.
+ */
+static void FractalNoiseRow(
+    int32_t y, int32_t width, float frequency, int32_t octaves, float lacunarity, float persistence, float* output)
+{
+    constexpr int32_t kBatchSize = 8;
+
+    std::fill_n(output, width, 0.0f);
+
+    float amplitude = persistence;
+    for (int32_t i = 0; i < octaves; i++)
+    {
+        const float sampleY = y * frequency;
+        for (int32_t batchStart = 0; batchStart < width; batchStart += kBatchSize)
+        {
+            const int32_t batchSize = std::min(kBatchSize, width - batchStart);
+            float samples[kBatchSize];
+            for (int32_t lane = 0; lane < batchSize; lane++)
+            {
+                samples[lane] = Generate((batchStart + lane) * frequency, sampleY);
+            }
+            for (int32_t lane = 0; lane < batchSize; lane++)
+            {
+                output[batchStart + lane] += samples[lane] * amplitude;
+            }
+        }
+        frequency *= lacunarity;
+        amplitude *= persistence;
+    }
+}
+
 static float Generate(float x, float y)
 {
     const float F2 = 0.366025403f; // F2 = 0.5*(sqrt(3.0)-1.0)
     const float G2 = 0.211324865f; // G2 = (3.0-sqrt(3.0))/6.0
 
-    float n0, n1, n2; // Noise contributions from the three corners
-
     // Skew the input space to determine which simplex cell we're in
     float s = (x + y) * F2; // Hairy factor for 2D
     float xs = x + s;
@@ -611,18 +789,11 @@ static float Generate(float x, float y)
     float y0 = y - Y0;
 
     // For the 2D case, the simplex shape is an equilateral triangle.
-    // Determine which simplex we are in.
-    int32_t i1, j1; // Offsets for second (middle) corner of simplex in (i,j) coords
-    if (x0 > y0)
-    {
-        i1 = 1;
-        j1 = 0;
-    } // lower triangle, XY order: (0,0)->(1,0)->(1,1)
-    else
-    {
-        i1 = 0;
-        j1 = 1;
-    } // upper triangle, YX order: (0,0)->(0,1)->(1,1)
+    // Determine which simplex we are in. Offsets for second (middle) corner of simplex in (i,j) coords:
+    // lower triangle, XY order: (0,0)->(1,0)->(1,1)
+    // upper triangle, YX order: (0,0)->(0,1)->(1,1)
+    int32_t i1 = x0 > y0 ? 1 : 0;
+    int32_t j1 = 1 - i1;
 
     // A step of (1,0) in (i,j) means a step of (1-c,-c) in (x,y), and
     // a step of (0,1) in (i,j) means a step of (-c,1-c) in (x,y), where
@@ -634,42 +805,20 @@ static float Generate(float x, float y)
     float y2 = y0 - 1.0f + 2.0f * G2;
 
     // Wrap the integer indices at 256, to avoid indexing perm[] out of bounds
-    int32_t ii = i % 256;
-    int32_t jj = j % 256;
+    int32_t ii = i & 0xFF;
+    int32_t jj = j & 0xFF;
 
-    // Calculate the contribution from the three corners
+    // Calculate the contribution from the three corners. The contributions are computed unconditionally and masked
+    // afterwards so that there are no branches in the loops calling this.
     float t0 = 0.5f - x0 * x0 - y0 * y0;
-    if (t0 < 0.0f)
-    {
-        n0 = 0.0f;
-    }
-    else
-    {
-        t0 *= t0;
-        n0 = t0 * t0 * Grad(perm[ii + perm[jj]], x0, y0);
-    }
-
     float t1 = 0.5f - x1 * x1 - y1 * y1;
-    if (t1 < 0.0f)
-    {
-        n1 = 0.0f;
-    }
-    else
-    {
-        t1 *= t1;
-        n1 = t1 * t1 * Grad(perm[ii + i1 + perm[jj + j1]], x1, y1);
-    }
-
     float t2 = 0.5f - x2 * x2 - y2 * y2;
-    if (t2 < 0.0f)
-    {
-        n2 = 0.0f;
-    }
-    else
-    {
-        t2 *= t2;
-        n2 = t2 * t2 * Grad(perm[ii + 1 + perm[jj + 1]], x2, y2);
-    }
+    float tt0 = t0 * t0;
+    float tt1 = t1 * t1;
+    float tt2 = t2 * t2;
+    float n0 = t0 < 0.0f ? 0.0f : tt0 * tt0 * Grad(perm[ii + perm[jj]], x0, y0);
+    float n1 = t1 < 0.0f ? 0.0f : tt1 * tt1 * Grad(perm[ii + i1 + perm[jj + j1]], x1, y1);
+    float n2 = t2 < 0.0f ? 0.0f : tt2 * tt2 * Grad(perm[ii + 1 + perm[jj + 1]], x2, y2);
 
     // Add contributions from each corner to get the final noise value.
     // The result is scaled to return values in the interval [-1,1].
@@ -691,6 +840,8 @@ static float Grad(int32_t hash, float x, float y)
 
 static void MapGenSimplex(MapGenSettings* settings)
 {
+    MapGenPhaseTimer phaseTimer("simplex noise");
+
     float freq = settings->simplex_base_freq / 100.0f * (1.0f / _heightSize.x);
     int32_t octaves = settings->simplex_octaves;
 
@@ -698,16 +849,22 @@ static void MapGenSimplex(MapGenSettings* settings)
     int32_t high = settings->heightmapHigh / 2 - low;
 
     NoiseRand();
-    for (int32_t y = 0; y < _heightSize.y; y++)
-    {
-        for (int32_t x = 0; x < _heightSize.x; x++)
+
+    // Each row only depends on the permutation table, so bands of rows can be generated in parallel.
+    MapGenForEachRowBand(0, _heightSize.y, [&](int32_t yBegin, int32_t yEnd) {
+        std::vector<float> noiseRow(_heightSize.x);
+        for (int32_t y = yBegin; y < yEnd; y++)
         {
-            float noiseValue = std::clamp(FractalNoise(x, y, freq, octaves, 2.0f, 0.65f), -1.0f, 1.0f);
-            float normalisedNoiseValue = (noiseValue + 1.0f) / 2.0f;
+            FractalNoiseRow(y, _heightSize.x, freq, octaves, 2.0f, 0.65f, noiseRow.data());
+            for (int32_t x = 0; x < _heightSize.x; x++)
+            {
+                float noiseValue = std::clamp(noiseRow[x], -1.0f, 1.0f);
+                float normalisedNoiseValue = (noiseValue + 1.0f) / 2.0f;
 
-            SetHeight(x, y, low + static_cast<int32_t>(normalisedNoiseValue * high));
+                SetHeight(x, y, low + static_cast<int32_t>(normalisedNoiseValue * high));
+            }
         }
-    }
+    });
 }
 
 #pragma endregion
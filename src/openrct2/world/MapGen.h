@@ -12,6 +12,9 @@
 #include "../core/StringTypes.h"
 #include "Location.hpp"
 
+#include <string_view>
+#include <vector>
+
 enum class MapGenAlgorithm : uint8_t
 {
     blank,
@@ -30,6 +33,7 @@ struct MapGenSettings
     int32_t heightmapLow = 14;
     int32_t heightmapHigh = 60;
     bool smoothTileEdges = true;
+    uint32_t seed = 0; // 0 picks a random seed
 
     // Features (e.g. tree, rivers, lakes etc.)
     bool trees = true;
@@ -48,6 +52,12 @@ struct MapGenSettings
     bool normalize_height = true;
 };
 
-void MapGenGenerate(MapGenSettings* settings);
+struct MapGenPhaseTiming
+{
+    std::string_view name;
+    float milliseconds;
+};
+
+void MapGenGenerate(MapGenSettings* settings, std::vector<MapGenPhaseTiming>* timings = nullptr);
 bool MapGenLoadHeightmapImage(const utf8* path);
 void MapGenUnloadHeightmapImage();
@@ -0,0 +1,92 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TestData.h"
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <openrct2/Context.h>
+#include <openrct2/Game.h>
+#include <openrct2/GameState.h>
+#include <openrct2/OpenRCT2.h>
+#include <openrct2/world/ConstructionClearance.h>
+#include <openrct2/world/Map.h>
+#include <openrct2/world/QuarterTile.h>
+#include <openrct2/world/Surface.h>
+
+using namespace OpenRCT2;
+
+class ConstructionClearanceTests : public testing::Test
+{
+protected:
+    static void SetUpTestCase()
+    {
+        std::string parkPath = TestData::GetParkPath("bpb.sv6");
+        gOpenRCT2Headless = true;
+        gOpenRCT2NoGraphics = true;
+        _context = CreateContext();
+        bool initialised = _context->Initialise();
+        ASSERT_TRUE(initialised);
+
+        GetContext()->LoadParkFromFile(parkPath);
+        GameLoadInit();
+    }
+
+    static void TearDownTestCase()
+    {
+        if (_context)
+            _context.reset();
+    }
+
+private:
+    static std::shared_ptr<IContext> _context;
+};
+
+std::shared_ptr<IContext> ConstructionClearanceTests::_context;
+
+TEST_F(ConstructionClearanceTests, SummariesGiveSameResults)
+{
+    static constexpr QuarterTile kQuarterTiles[] = { { 0b1111, 0 }, { 0b1111, 0b1111 }, { 0b0001, 0 }, { 0b0110, 0b0010 } };
+
+    const auto& mapSize = GetGameState().MapSize;
+    int32_t numChecks = 0;
+    for (int32_t y = 1; y < mapSize.y - 1; y += 3)
+    {
+        for (int32_t x = 1; x < mapSize.x - 1; x += 3)
+        {
+            const auto mapCoords = TileCoordsXY{ x, y }.ToCoordsXY();
+            const auto* surfaceElement = MapGetSurfaceElementAt(mapCoords);
+            ASSERT_NE(surfaceElement, nullptr);
+
+            for (int32_t z = surfaceElement->GetBaseZ() - 16; z <= surfaceElement->GetBaseZ() + 96; z += kCoordsZStep)
+            {
+                for (const auto quarterTile : kQuarterTiles)
+                {
+                    const CoordsXYRangedZ pos{ mapCoords, z, z + 4 * kCoordsZStep };
+                    const auto expected = MapCanConstructWithClearAt(pos, &MapPlaceNonSceneryClearFunc, quarterTile, 0);
+
+                    ClearanceQueryScope scope;
+                    // Check twice, the first check summarises the tile and the second one uses the summary.
+                    for (int32_t i = 0; i < 2; i++)
+                    {
+                        const auto actual = MapCanConstructWithClearAt(pos, &MapPlaceNonSceneryClearFunc, quarterTile, 0);
+                        ASSERT_EQ(actual.Error, expected.Error);
+                        ASSERT_EQ(actual.ErrorMessage, expected.ErrorMessage);
+                        ASSERT_EQ(actual.Cost, expected.Cost);
+                        ASSERT_EQ(
+                            actual.GetData<ConstructClearResult>().GroundFlags,
+                            expected.GetData<ConstructClearResult>().GroundFlags);
+                    }
+                    numChecks++;
+                }
+            }
+        }
+    }
+    ASSERT_GT(numChecks, 0);
+}
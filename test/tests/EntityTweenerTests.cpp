@@ -0,0 +1,137 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TestData.h"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <memory>
+#include <openrct2/Context.h>
+#include <openrct2/Game.h>
+#include <openrct2/GameState.h>
+#include <openrct2/OpenRCT2.h>
+#include <openrct2/entity/EntityList.h>
+#include <openrct2/entity/EntityRegistry.h>
+#include <openrct2/entity/EntityTweener.h>
+#include <openrct2/entity/Guest.h>
+#include <openrct2/entity/Staff.h>
+#include <openrct2/ride/Vehicle.h>
+#include <string>
+#include <unordered_map>
+
+using namespace OpenRCT2;
+
+class EntityTweenerTests : public testing::Test
+{
+protected:
+    static void SetUpTestCase()
+    {
+        gOpenRCT2Headless = true;
+        gOpenRCT2NoGraphics = true;
+        _context = CreateContext();
+        ASSERT_TRUE(_context->Initialise());
+
+        std::string parkPath = TestData::GetParkPath("bpb.sv6");
+        ASSERT_TRUE(GetContext()->LoadParkFromFile(parkPath));
+        GameLoadInit();
+    }
+
+    static void TearDownTestCase()
+    {
+        EntityTweener::Get().Reset();
+        _context = nullptr;
+    }
+
+    template<typename T> static void AddLocations(std::unordered_map<uint16_t, CoordsXYZ>& locations)
+    {
+        for (auto* entity : EntityList<T>())
+        {
+            locations[entity->Id.ToUnderlying()] = entity->GetLocation();
+        }
+    }
+
+    // Returns the locations of the entities that are tweened, by entity id.
+    static std::unordered_map<uint16_t, CoordsXYZ> GetLocations()
+    {
+        std::unordered_map<uint16_t, CoordsXYZ> locations;
+        AddLocations<Guest>(locations);
+        AddLocations<Staff>(locations);
+        AddLocations<Vehicle>(locations);
+        return locations;
+    }
+
+    static bool IsListedAsDisplaced(const EntityBase& entity, const CoordsXY& paintPos)
+    {
+        const auto displaced = EntityTweener::Get().GetDisplacedEntities(paintPos);
+        return std::any_of(displaced.begin(), displaced.end(), [&](const EntityTweener::DisplacedEntity& item) {
+            return item.Entity == &entity;
+        });
+    }
+
+private:
+    static std::shared_ptr<IContext> _context;
+};
+
+std::shared_ptr<IContext> EntityTweenerTests::_context;
+
+TEST_F(EntityTweenerTests, PaintsAtTickPositionsAtTheEnds)
+{
+    auto& tweener = EntityTweener::Get();
+    bool anyMoved = false;
+    bool anyDisplaced = false;
+    for (int32_t tick = 0; tick < 100 && !anyDisplaced; tick++)
+    {
+        const auto preLocations = GetLocations();
+        tweener.PreTick();
+        gameStateUpdateLogic();
+        tweener.PostTick();
+        const auto postLocations = GetLocations();
+
+        // At the start of the frame entities are painted where they were before the tick.
+        tweener.Tween(0.0f);
+        for (const auto& [index, postPos] : postLocations)
+        {
+            const auto* entity = GetEntity(EntityId::FromUnderlying(index));
+            ASSERT_NE(entity, nullptr);
+
+            const auto pre = preLocations.find(index);
+            auto expected = postPos;
+            if (pre != preLocations.end() && pre->second.x != kLocationNull && postPos.x != kLocationNull)
+            {
+                expected = pre->second;
+            }
+            ASSERT_EQ(tweener.GetPaintLocation(*entity), expected);
+
+            const bool displaced = expected.x != kLocationNull && TileCoordsXY(expected) != TileCoordsXY(postPos);
+            ASSERT_EQ(tweener.IsDisplaced(*entity), displaced);
+            ASSERT_EQ(IsListedAsDisplaced(*entity, expected), displaced);
+            ASSERT_FALSE(IsListedAsDisplaced(*entity, postPos));
+            anyMoved |= expected != postPos;
+            anyDisplaced |= displaced;
+        }
+
+        // At the end of the frame entities are painted where they are after the tick.
+        tweener.Tween(1.0f);
+        for (const auto& [index, postPos] : postLocations)
+        {
+            const auto* entity = GetEntity(EntityId::FromUnderlying(index));
+            ASSERT_EQ(tweener.GetPaintLocation(*entity), postPos);
+            ASSERT_FALSE(tweener.IsDisplaced(*entity));
+            ASSERT_FALSE(IsListedAsDisplaced(*entity, postPos));
+        }
+
+        tweener.Restore();
+        for (const auto& [index, postPos] : postLocations)
+        {
+            ASSERT_EQ(tweener.GetPaintLocation(*GetEntity(EntityId::FromUnderlying(index))), postPos);
+        }
+    }
+    ASSERT_TRUE(anyMoved);
+    ASSERT_TRUE(anyDisplaced);
+}
@@ -0,0 +1,109 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TestData.h"
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include <memory>
+#include <openrct2/Context.h>
+#include <openrct2/Game.h>
+#include <openrct2/GameState.h>
+#include <openrct2/GameStateSnapshots.h>
+#include <openrct2/OpenRCT2.h>
+#include <openrct2/core/DataSerialiser.h>
+#include <openrct2/core/MemoryStream.h>
+#include <openrct2/scenario/Scenario.h>
+#include <string>
+
+using namespace OpenRCT2;
+
+class GameStateSnapshotsTests : public testing::Test
+{
+protected:
+    static void SetUpTestCase()
+    {
+        gOpenRCT2Headless = true;
+        gOpenRCT2NoGraphics = true;
+        _context = CreateContext();
+        ASSERT_TRUE(_context->Initialise());
+
+        std::string parkPath = TestData::GetParkPath("small_park_with_ferris_wheel.sv6");
+        ASSERT_TRUE(GetContext()->LoadParkFromFile(parkPath));
+        GameLoadInit();
+    }
+
+    static void TearDownTestCase()
+    {
+        _context = nullptr;
+    }
+
+    static void RunTicks(int32_t numTicks)
+    {
+        for (int32_t i = 0; i < numTicks; i++)
+        {
+            gameStateUpdateLogic();
+        }
+    }
+
+    static MemoryStream Serialise(IGameStateSnapshots& snapshots, GameStateSnapshot_t& snapshot)
+    {
+        MemoryStream stream;
+        DataSerialiser ds(true, stream);
+        snapshots.SerialiseSnapshot(snapshot, ds);
+        return stream;
+    }
+
+    static bool StreamsEqual(const MemoryStream& a, const MemoryStream& b)
+    {
+        return a.GetLength() == b.GetLength()
+            && std::memcmp(a.GetData(), b.GetData(), static_cast<size_t>(a.GetLength())) == 0;
+    }
+
+private:
+    static std::shared_ptr<IContext> _context;
+};
+
+std::shared_ptr<IContext> GameStateSnapshotsTests::_context;
+
+TEST_F(GameStateSnapshotsTests, LazySerialisationMatchesEager)
+{
+    auto snapshots = CreateGameStateSnapshots();
+    auto& gameState = GetGameState();
+
+    // The eager snapshots are serialised straight after capturing, the lazy ones only after the game has moved on.
+    auto& eagerFirst = snapshots->CreateSnapshot();
+    auto& lazyFirst = snapshots->CreateSnapshot();
+    snapshots->Capture(eagerFirst);
+    snapshots->LinkSnapshot(eagerFirst, gameState.CurrentTicks, ScenarioRandState().s0);
+    snapshots->Capture(lazyFirst);
+    snapshots->LinkSnapshot(lazyFirst, gameState.CurrentTicks, ScenarioRandState().s0);
+    auto eagerFirstData = Serialise(*snapshots, eagerFirst);
+
+    RunTicks(100);
+
+    auto& eagerSecond = snapshots->CreateSnapshot();
+    auto& lazySecond = snapshots->CreateSnapshot();
+    snapshots->Capture(eagerSecond);
+    snapshots->LinkSnapshot(eagerSecond, gameState.CurrentTicks, ScenarioRandState().s0);
+    snapshots->Capture(lazySecond);
+    snapshots->LinkSnapshot(lazySecond, gameState.CurrentTicks, ScenarioRandState().s0);
+    auto eagerSecondData = Serialise(*snapshots, eagerSecond);
+    auto eagerCmp = snapshots->Compare(eagerFirst, eagerSecond);
+
+    RunTicks(100);
+
+    auto lazyCmp = snapshots->Compare(lazyFirst, lazySecond);
+    ASSERT_TRUE(StreamsEqual(Serialise(*snapshots, lazyFirst), eagerFirstData));
+    ASSERT_TRUE(StreamsEqual(Serialise(*snapshots, lazySecond), eagerSecondData));
+
+    ASSERT_FALSE(eagerCmp.spriteChanges.empty());
+    ASSERT_EQ(lazyCmp.spriteChanges.size(), eagerCmp.spriteChanges.size());
+    ASSERT_EQ(snapshots->GetCompareDataText(lazyCmp), snapshots->GetCompareDataText(eagerCmp));
+}
@@ -10,7 +10,9 @@
 #include "TestData.h"
 
 #include <gtest/gtest.h>
+#include <openrct2/core/MemoryStream.h>
 #include <openrct2/core/Path.hpp>
+#include <openrct2/drawing/ImageImportCache.h>
 #include <openrct2/drawing/ImageImporter.h>
 #include <string_view>
 
@@ -34,6 +36,28 @@ public:
         }
         return hash;
     }
+
+    static Image CreateTestImage()
+    {
+        Image image;
+        image.Width = 64;
+        image.Height = 32;
+        image.Depth = 32;
+        image.Stride = image.Width * 4;
+        image.Pixels.resize(image.Stride * image.Height);
+        for (uint32_t y = 0; y < image.Height; y++)
+        {
+            for (uint32_t x = 0; x < image.Width; x++)
+            {
+                auto* pixel = &image.Pixels[y * image.Stride + x * 4];
+                pixel[0] = static_cast<uint8_t>(x * 4);
+                pixel[1] = static_cast<uint8_t>(y * 8);
+                pixel[2] = static_cast<uint8_t>((x * y) % 256);
+                pixel[3] = 255;
+            }
+        }
+        return image;
+    }
 };
 
 TEST_F(ImageImporterTests, Import_Logo)
@@ -58,3 +82,105 @@ TEST_F(ImageImporterTests, Import_Logo)
     auto hash = GetHash(result.Buffer.data(), result.Buffer.size());
     ASSERT_EQ(uint32_t(0x212A99BC), hash);
 }
+
+TEST_F(ImageImporterTests, Import_Closest_MatchesLinearSearch)
+{
+    auto image = CreateTestImage();
+    auto meta = ImageImportMeta{ .importFlags = 0, .importMode = ImportMode::Closest };
+
+    ImageImporter importer;
+    auto result = importer.Import(image, meta);
+    ASSERT_EQ(image.Width * image.Height, result.Buffer.size());
+
+    // Colours in the palette are kept, other colours get the closest colour not used for special purposes or the
+    // primary remap.
+    auto isCandidate = [](uint32_t index) {
+        return !(index <= 9 || (index >= 230 && index <= 239) || index >= 243);
+    };
+    for (uint32_t i = 0; i < result.Buffer.size(); i++)
+    {
+        const auto* pixel = &image.Pixels[i * 4];
+        uint32_t expected = 0;
+        int32_t smallestError = std::numeric_limits<int32_t>::max();
+        for (uint32_t index = 0; index < PALETTE_SIZE; index++)
+        {
+            const auto& entry = StandardPalette[index];
+            if (entry.Red == pixel[0] && entry.Green == pixel[1] && entry.Blue == pixel[2])
+            {
+                expected = index;
+                break;
+            }
+            if (!isCandidate(index))
+                continue;
+
+            const int32_t dr = entry.Red - pixel[0];
+            const int32_t dg = entry.Green - pixel[1];
+            const int32_t db = entry.Blue - pixel[2];
+            const int32_t error = dr * dr + dg * dg + db * db;
+            if (error < smallestError)
+            {
+                smallestError = error;
+                expected = index;
+            }
+        }
+        ASSERT_EQ(expected, result.Buffer[i]) << "pixel " << i;
+    }
+}
+
+TEST_F(ImageImporterTests, ImportCache_RoundTrip)
+{
+    auto image = CreateTestImage();
+    const auto meta = ImageImportMeta{ .offset = { 1, 2 }, .importMode = ImportMode::Dithering };
+    auto importMeta = meta;
+
+    ImageImporter importer;
+    auto expected = importer.Import(image, importMeta);
+
+    ImageImportCache cache({}, image.Pixels, IMAGE_FORMAT::PNG_32);
+    ASSERT_EQ(nullptr, cache.Find(meta));
+    cache.Add(meta, importer.Import(image, importMeta));
+
+    MemoryStream stream;
+    cache.WriteEntries(stream);
+    stream.SetPosition(0);
+
+    ImageImportCache loadedCache({}, image.Pixels, IMAGE_FORMAT::PNG_32);
+    loadedCache.ReadEntries(stream);
+
+    auto otherMeta = meta;
+    otherMeta.importMode = ImportMode::Closest;
+    ASSERT_EQ(nullptr, loadedCache.Find(otherMeta));
+
+    const auto* loaded = loadedCache.Find(meta);
+    ASSERT_NE(nullptr, loaded);
+    ASSERT_EQ(loaded->Buffer.data(), loaded->Element.offset);
+    ASSERT_EQ(expected.Buffer, loaded->Buffer);
+    ASSERT_EQ(expected.Element.width, loaded->Element.width);
+    ASSERT_EQ(expected.Element.height, loaded->Element.height);
+    ASSERT_EQ(1, loaded->Element.x_offset);
+    ASSERT_EQ(2, loaded->Element.y_offset);
+    ASSERT_EQ(expected.Element.flags, loaded->Element.flags);
+}
+
+TEST_F(ImageImporterTests, ImportCache_RejectsTruncatedImage)
+{
+    auto image = CreateTestImage();
+    const auto meta = ImageImportMeta{};
+    auto importMeta = meta;
+
+    ImageImporter importer;
+    auto result = importer.Import(image, importMeta);
+    ASSERT_TRUE(result.Element.flags & G1_FLAG_RLE_COMPRESSION);
+    result.Buffer.resize(result.Buffer.size() - 1);
+
+    ImageImportCache cache({}, image.Pixels, IMAGE_FORMAT::PNG_32);
+    cache.Add(meta, std::move(result));
+
+    MemoryStream stream;
+    cache.WriteEntries(stream);
+    stream.SetPosition(0);
+
+    ImageImportCache loadedCache({}, image.Pixels, IMAGE_FORMAT::PNG_32);
+    ASSERT_THROW(loadedCache.ReadEntries(stream), std::runtime_error);
+    ASSERT_EQ(nullptr, loadedCache.Find(meta));
+}
@@ -54,6 +54,27 @@ TEST_F(LanguagePackTest, language_pack_simple)
     ASSERT_EQ(lang->GetScenarioOverrideStringId("No such park", 0), STR_NONE);
 }
 
+TEST_F(LanguagePackTest, language_pack_crlf)
+{
+    auto lang = LanguagePackFactory::FromText(0, "STR_0000    :first\r\n\r\n  STR_0002    :third\r\nSTR_0003:");
+    ASSERT_EQ(lang->GetCount(), 4u);
+    ASSERT_STREQ(lang->GetString(0), "first");
+    ASSERT_EQ(lang->GetString(1), nullptr);
+    ASSERT_STREQ(lang->GetString(2), "third");
+    ASSERT_EQ(lang->GetString(3), nullptr);
+    lang->RemoveString(2);
+    ASSERT_EQ(lang->GetString(2), nullptr);
+    ASSERT_STREQ(lang->GetString(0), "first");
+}
+
+TEST_F(LanguagePackTest, language_pack_bom)
+{
+    auto lang = LanguagePackFactory::FromText(0, "\xEF\xBB\xBFSTR_0000    :first\nSTR_0001    :second\n");
+    ASSERT_EQ(lang->GetCount(), 2u);
+    ASSERT_STREQ(lang->GetString(0), "first");
+    ASSERT_STREQ(lang->GetString(1), "second");
+}
+
 TEST_F(LanguagePackTest, language_pack_multibyte)
 {
     auto lang = LanguagePackFactory::FromText(0, reinterpret_cast<const utf8*>(LanguageZhTW));
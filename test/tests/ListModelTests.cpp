@@ -0,0 +1,127 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <openrct2-ui/interface/ListModel.h>
+#include <openrct2/Identifiers.h>
+#include <random>
+#include <vector>
+
+using namespace OpenRCT2::Ui;
+
+static bool CompareInt(const int32_t& a, const int32_t& b)
+{
+    return a < b;
+}
+
+static bool CompareIntDescending(const int32_t& a, const int32_t& b)
+{
+    return a > b;
+}
+
+static std::vector<int32_t> GetKeys(const ListModel<EntityId, int32_t>& model)
+{
+    std::vector<int32_t> keys;
+    for (size_t i = 0; i < model.size(); i++)
+    {
+        keys.push_back(model[i].Key);
+    }
+    return keys;
+}
+
+TEST(ListModelTest, KeepsItemsSortedAcrossUpdates)
+{
+    std::mt19937 random(1234);
+    std::vector<int32_t> keys(500, -1);
+
+    ListModel<EntityId, int32_t> model(CompareInt);
+    for (int32_t pass = 0; pass < 20; pass++)
+    {
+        // Remove, add and change a random set of items.
+        model.BeginUpdate();
+        for (size_t i = 0; i < keys.size(); i++)
+        {
+            const auto id = EntityId::FromUnderlying(static_cast<uint16_t>(i));
+            const auto roll = random() % 10;
+            if (roll == 0)
+            {
+                keys[i] = -1;
+                continue;
+            }
+            if (keys[i] == -1 || roll == 1)
+            {
+                keys[i] = static_cast<int32_t>(random() % 100);
+                model.Add(id, int32_t{ keys[i] });
+            }
+            else
+            {
+                ASSERT_NE(model.Find(id), nullptr);
+                ASSERT_EQ(*model.Find(id), keys[i]);
+                model.Keep(id);
+            }
+        }
+        model.EndUpdate();
+
+        std::vector<int32_t> expected;
+        std::copy_if(keys.begin(), keys.end(), std::back_inserter(expected), [](int32_t key) { return key != -1; });
+        std::sort(expected.begin(), expected.end());
+        ASSERT_EQ(GetKeys(model), expected);
+    }
+
+    model.SetCompare(CompareIntDescending);
+    auto descending = GetKeys(model);
+    ASSERT_TRUE(std::is_sorted(descending.rbegin(), descending.rend()));
+}
+
+TEST(ListModelTest, VisibleRange)
+{
+    ListModel<EntityId, int32_t> model(CompareInt);
+    model.BeginUpdate();
+    for (uint16_t i = 0; i < 100; i++)
+    {
+        model.Add(EntityId::FromUnderlying(i), int32_t{ i });
+    }
+    model.EndUpdate();
+
+    ASSERT_EQ(model.GetVisibleRange(0, 50, 10), (std::pair<size_t, size_t>{ 0, 5 }));
+    ASSERT_EQ(model.GetVisibleRange(15, 36, 10), (std::pair<size_t, size_t>{ 1, 4 }));
+    ASSERT_EQ(model.GetVisibleRange(950, 2000, 10), (std::pair<size_t, size_t>{ 95, 100 }));
+    ASSERT_EQ(model.GetVisibleRange(2000, 2100, 10), (std::pair<size_t, size_t>{ 100, 100 }));
+}
+
+TEST(ListModelTest, FilterKeepsKeys)
+{
+    ListModel<EntityId, int32_t> model(CompareInt);
+    model.BeginUpdate();
+    for (uint16_t i = 0; i < 10; i++)
+    {
+        model.Add(EntityId::FromUnderlying(i), int32_t{ 9 - i });
+    }
+    model.EndUpdate();
+
+    model.Filter([](const auto& item) { return item.Key % 2 == 0; });
+    ASSERT_EQ(GetKeys(model), (std::vector<int32_t>{ 0, 2, 4, 6, 8 }));
+    ASSERT_EQ(model.GetVisibleRange(0, 100, 10), (std::pair<size_t, size_t>{ 0, 5 }));
+
+    // Filtered out items are still listed, so a refresh keeps them without a new key.
+    ASSERT_NE(model.Find(EntityId::FromUnderlying(0)), nullptr);
+    ASSERT_EQ(*model.Find(EntityId::FromUnderlying(0)), 9);
+
+    model.SetCompare(CompareIntDescending);
+    ASSERT_EQ(GetKeys(model), (std::vector<int32_t>{ 8, 6, 4, 2, 0 }));
+
+    model.BeginUpdate();
+    for (uint16_t i = 0; i < 10; i++)
+    {
+        model.Keep(EntityId::FromUnderlying(i));
+    }
+    model.EndUpdate();
+    ASSERT_EQ(model.size(), 10u);
+}
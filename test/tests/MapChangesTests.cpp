@@ -0,0 +1,139 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TestData.h"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <memory>
+#include <openrct2/Context.h>
+#include <openrct2/Game.h>
+#include <openrct2/GameState.h>
+#include <openrct2/OpenRCT2.h>
+#include <openrct2/actions/LandBuyRightsAction.h>
+#include <openrct2/actions/LandSetRightsAction.h>
+#include <openrct2/world/Map.h>
+#include <openrct2/world/MapChanges.h>
+#include <openrct2/world/Surface.h>
+#include <vector>
+
+using namespace OpenRCT2;
+
+TEST(MapChangesTests, NothingIsRecordedWithoutTracking)
+{
+    MapChanges::StopTracking();
+    MapChanges::MarkTile({ 64, 64 });
+
+    std::vector<TileCoordsXY> tiles;
+    ASSERT_TRUE(MapChanges::TakeChangedTiles(tiles));
+    ASSERT_TRUE(tiles.empty());
+}
+
+TEST(MapChangesTests, TakesChangedTilesOnce)
+{
+    std::vector<TileCoordsXY> tiles;
+    MapChanges::StartTracking();
+    ASSERT_FALSE(MapChanges::TakeChangedTiles(tiles));
+    ASSERT_TRUE(MapChanges::TakeChangedTiles(tiles));
+    ASSERT_TRUE(tiles.empty());
+
+    MapChanges::MarkTile({ 3 * 32 + 5, 7 * 32 });
+    MapChanges::MarkTile({ 3 * 32, 7 * 32 + 31 });
+    MapChanges::MarkRegion({ 10 * 32, 20 * 32 }, { 11 * 32, 20 * 32 });
+    MapChanges::MarkTile({ -32, 0 });
+    ASSERT_TRUE(MapChanges::TakeChangedTiles(tiles));
+
+    const std::vector<TileCoordsXY> expected = { { 3, 7 }, { 10, 20 }, { 11, 20 } };
+    ASSERT_EQ(tiles, expected);
+
+    ASSERT_TRUE(MapChanges::TakeChangedTiles(tiles));
+    ASSERT_TRUE(tiles.empty());
+
+    MapChanges::MarkTile({ 0, 0 });
+    MapChanges::MarkAll();
+    ASSERT_FALSE(MapChanges::TakeChangedTiles(tiles));
+    ASSERT_TRUE(tiles.empty());
+    ASSERT_TRUE(MapChanges::TakeChangedTiles(tiles));
+    ASSERT_TRUE(tiles.empty());
+
+    MapChanges::StopTracking();
+}
+
+class MapChangesParkTests : public testing::Test
+{
+protected:
+    static void SetUpTestCase()
+    {
+        gOpenRCT2Headless = true;
+        gOpenRCT2NoGraphics = true;
+        _context = CreateContext();
+        ASSERT_TRUE(_context->Initialise());
+
+        std::string parkPath = TestData::GetParkPath("small_park_with_ferris_wheel.sv6");
+        ASSERT_TRUE(GetContext()->LoadParkFromFile(parkPath));
+        GameLoadInit();
+    }
+
+    static void TearDownTestCase()
+    {
+        MapChanges::StopTracking();
+        _context = nullptr;
+    }
+
+    // Runs the action the way the game does at the start of a tick, then checks that tile is reported as changed.
+    static void ExpectTileChangedBy(GameAction& action, const TileCoordsXY& tile)
+    {
+        std::vector<TileCoordsXY> tiles;
+        ASSERT_TRUE(MapChanges::TakeChangedTiles(tiles));
+
+        ASSERT_EQ(GameActions::Execute(&action).Error, GameActions::Status::Ok);
+        GameActions::ProcessQueue();
+
+        ASSERT_TRUE(MapChanges::TakeChangedTiles(tiles));
+        EXPECT_NE(std::find(tiles.begin(), tiles.end(), tile), tiles.end());
+    }
+
+private:
+    static std::shared_ptr<IContext> _context;
+};
+
+std::shared_ptr<IContext> MapChangesParkTests::_context;
+
+TEST_F(MapChangesParkTests, OwnershipChangesAreReported)
+{
+    auto& gameState = GetGameState();
+    gameState.Cheats.SandboxMode = true;
+    gameState.Cash = 1000000.00_GBP;
+
+    const TileCoordsXY tile{ 2, 2 };
+    const auto loc = tile.ToCoordsXY();
+    auto* surfaceElement = MapGetSurfaceElementAt(loc);
+    ASSERT_NE(surfaceElement, nullptr);
+
+    surfaceElement->SetOwnership(OWNERSHIP_UNOWNED);
+
+    std::vector<TileCoordsXY> tiles;
+    MapChanges::StartTracking();
+    ASSERT_FALSE(MapChanges::TakeChangedTiles(tiles));
+
+    auto setForSaleAction = LandSetRightsAction(loc, LandSetRightSetting::SetOwnershipWithChecks, OWNERSHIP_AVAILABLE);
+    ExpectTileChangedBy(setForSaleAction, tile);
+    EXPECT_EQ(surfaceElement->GetOwnership(), OWNERSHIP_AVAILABLE);
+
+    auto buyAction = LandBuyRightsAction(loc, LandBuyRightSetting::BuyLand);
+    ExpectTileChangedBy(buyAction, tile);
+    EXPECT_EQ(surfaceElement->GetOwnership(), OWNERSHIP_OWNED);
+
+    auto sellAction = LandSetRightsAction(loc, LandSetRightSetting::UnownLand);
+    ExpectTileChangedBy(sellAction, tile);
+    EXPECT_EQ(surfaceElement->GetOwnership() & OWNERSHIP_OWNED, 0);
+
+    MapChanges::StopTracking();
+    gameState.Cheats.SandboxMode = false;
+}
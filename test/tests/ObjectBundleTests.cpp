@@ -0,0 +1,257 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include <memory>
+#include <openrct2/Context.h>
+#include <openrct2/OpenRCT2.h>
+#include <openrct2/core/MemoryStream.h>
+#include <openrct2/core/String.hpp>
+#include <openrct2/drawing/Drawing.h>
+#include <openrct2/localisation/Language.h>
+#include <openrct2/object/Object.h>
+#include <openrct2/object/ObjectBundle.h>
+#include <openrct2/object/ObjectFactory.h>
+#include <openrct2/object/ObjectRepository.h>
+#include <utility>
+#include <vector>
+
+using namespace OpenRCT2;
+
+static ObjectBundleEntry CreateEntry(uint8_t seed)
+{
+    ObjectBundleEntry entry;
+    entry.SourceHash.fill(seed);
+    entry.Properties = { 0xA1, 0x61, 0x61, seed };
+
+    std::vector<uint8_t> pixels(6);
+    for (size_t i = 0; i < pixels.size(); i++)
+    {
+        pixels[i] = static_cast<uint8_t>(seed + i);
+    }
+
+    G1Element images[2]{};
+    images[0].offset = pixels.data();
+    images[0].width = 3;
+    images[0].height = 2;
+    images[0].x_offset = -1;
+    images[0].zoomed_offset = 1;
+    images[1].offset = pixels.data() + 2;
+    images[1].width = 2;
+    images[1].height = 2;
+    entry.SetImages(images, std::size(images), true);
+    return entry;
+}
+
+TEST(ObjectBundleTests, FindsEntriesWithTheSameSourceHash)
+{
+    ObjectBundle bundle({});
+    bundle.Add("a.parkobj", CreateEntry(1));
+
+    ASSERT_NE(bundle.Find("a.parkobj", CreateEntry(1).SourceHash), nullptr);
+    ASSERT_EQ(bundle.Find("a.parkobj", CreateEntry(2).SourceHash), nullptr);
+    ASSERT_EQ(bundle.Find("b.parkobj", CreateEntry(1).SourceHash), nullptr);
+}
+
+TEST(ObjectBundleTests, ReadsWrittenEntries)
+{
+    ObjectBundle bundle({});
+    bundle.Add("a.parkobj", CreateEntry(1));
+    bundle.Add("b.parkobj", CreateEntry(2));
+
+    MemoryStream stream;
+    bundle.WriteEntries(stream);
+    stream.SetPosition(0);
+
+    ObjectBundle readBundle({});
+    readBundle.ReadEntries(stream);
+    ASSERT_EQ(readBundle.GetCount(), 2u);
+
+    const auto expected = CreateEntry(2);
+    const auto* entry = readBundle.Find("b.parkobj", expected.SourceHash);
+    ASSERT_NE(entry, nullptr);
+    ASSERT_EQ(entry->Properties, expected.Properties);
+    ASSERT_TRUE(entry->HasImages);
+    ASSERT_TRUE(entry->UsesFallbackImages);
+    ASSERT_EQ(entry->Images.size(), 2u);
+
+    const auto image = entry->GetImage(1);
+    ASSERT_EQ(image.width, 2);
+    ASSERT_EQ(image.height, 2);
+    ASSERT_EQ(std::vector<uint8_t>(image.offset, image.offset + 4), std::vector<uint8_t>({ 4, 5, 6, 7 }));
+    ASSERT_EQ(entry->GetImage(0).x_offset, -1);
+    ASSERT_EQ(entry->GetImage(0).zoomed_offset, 1);
+}
+
+TEST(ObjectBundleTests, RejectsInvalidData)
+{
+    const std::vector<uint8_t> data = { 1, 2, 3, 4, 5, 6 };
+    MemoryStream stream(data.data(), data.size());
+
+    ObjectBundle bundle({});
+    ASSERT_THROW(bundle.ReadEntries(stream), std::runtime_error);
+    ASSERT_EQ(bundle.GetCount(), 0u);
+}
+
+TEST(ObjectBundleTests, RejectsTruncatedImageData)
+{
+    auto entry = CreateEntry(1);
+    entry.ImageData.resize(entry.ImageData.size() - 1);
+
+    ObjectBundle bundle({});
+    bundle.Add("a.parkobj", std::move(entry));
+
+    MemoryStream stream;
+    bundle.WriteEntries(stream);
+    stream.SetPosition(0);
+
+    ObjectBundle readBundle({});
+    ASSERT_THROW(readBundle.ReadEntries(stream), std::runtime_error);
+    ASSERT_EQ(readBundle.GetCount(), 0u);
+}
+
+TEST(ObjectBundleTests, RejectsRleRowsOutsideImageData)
+{
+    // A single row whose offset points past the end of the data.
+    const std::vector<uint8_t> pixels = { 0x40, 0x00, 0x81, 0x00, 0x01 };
+
+    G1Element image{};
+    image.offset = const_cast<uint8_t*>(pixels.data());
+    image.width = 1;
+    image.height = 1;
+    image.flags = G1_FLAG_RLE_COMPRESSION;
+
+    ObjectBundleEntry entry;
+    entry.HasImages = true;
+    entry.Images.push_back(image);
+    entry.Images.back().offset = nullptr;
+    entry.ImageDataOffsets.push_back(0);
+    entry.ImageData = pixels;
+
+    ObjectBundle bundle({});
+    bundle.Add("a.parkobj", std::move(entry));
+
+    MemoryStream stream;
+    bundle.WriteEntries(stream);
+    stream.SetPosition(0);
+
+    ObjectBundle readBundle({});
+    ASSERT_THROW(readBundle.ReadEntries(stream), std::runtime_error);
+    ASSERT_EQ(readBundle.GetCount(), 0u);
+}
+
+class ObjectBundleObjectTests : public testing::Test
+{
+protected:
+    static void SetUpTestCase()
+    {
+        gOpenRCT2Headless = true;
+        gOpenRCT2NoGraphics = true;
+        _context = CreateContext();
+        ASSERT_TRUE(_context->Initialise());
+    }
+
+    static void TearDownTestCase()
+    {
+        _context = nullptr;
+    }
+
+    // Returns the first .parkobj file of a ride object, or of any object if there is no ride object in one.
+    static const ObjectRepositoryItem* FindParkObj()
+    {
+        auto& objectRepository = GetContext()->GetObjectRepository();
+        const auto* items = objectRepository.GetObjects();
+        const ObjectRepositoryItem* result = nullptr;
+        for (size_t i = 0; i < objectRepository.GetNumObjects(); i++)
+        {
+            if (String::EndsWith(items[i].Path, ".parkobj", true))
+            {
+                if (items[i].Type == ObjectType::Ride)
+                    return &items[i];
+                if (result == nullptr)
+                    result = &items[i];
+            }
+        }
+        return result;
+    }
+
+private:
+    static std::shared_ptr<IContext> _context;
+};
+
+std::shared_ptr<IContext> ObjectBundleObjectTests::_context;
+
+TEST_F(ObjectBundleObjectTests, BundledObjectMatchesParkObj)
+{
+    const auto* item = FindParkObj();
+    if (item == nullptr)
+    {
+        GTEST_SKIP() << "No .parkobj objects are installed.";
+    }
+
+    auto& objectRepository = GetContext()->GetObjectRepository();
+    auto expected = ObjectFactory::CreateObjectFromZipFile(objectRepository, item->Path, true);
+    ASSERT_NE(expected, nullptr);
+
+    // The first read compiles the object into the bundle, the second one reads it from there.
+    ObjectBundle bundle({});
+    std::unique_ptr<Object> actual;
+    {
+        ObjectBundleScope scope(bundle);
+        ASSERT_NE(ObjectFactory::CreateObjectFromZipFile(objectRepository, item->Path, true), nullptr);
+        ASSERT_EQ(bundle.GetCount(), 1u);
+        actual = ObjectFactory::CreateObjectFromZipFile(objectRepository, item->Path, true);
+    }
+    ASSERT_NE(actual, nullptr);
+
+    ASSERT_EQ(actual->GetIdentifier(), expected->GetIdentifier());
+    ASSERT_EQ(actual->GetObjectType(), expected->GetObjectType());
+    ASSERT_EQ(actual->GetVersion(), expected->GetVersion());
+    ASSERT_EQ(actual->GetAuthors(), expected->GetAuthors());
+    ASSERT_TRUE(actual->GetObjectEntry() == expected->GetObjectEntry());
+
+    ObjectRepositoryItem actualItem{};
+    ObjectRepositoryItem expectedItem{};
+    actual->SetRepositoryItem(&actualItem);
+    expected->SetRepositoryItem(&expectedItem);
+    ASSERT_EQ(actualItem.Sources, expectedItem.Sources);
+    ASSERT_EQ(std::memcmp(&actualItem.RideInfo, &expectedItem.RideInfo, sizeof(actualItem.RideInfo)), 0);
+    ASSERT_EQ(actualItem.SceneryGroupInfo.Entries.size(), expectedItem.SceneryGroupInfo.Entries.size());
+    ASSERT_EQ(actualItem.FootpathSurfaceInfo.Flags, expectedItem.FootpathSurfaceInfo.Flags);
+
+    for (int32_t language = 0; language < LANGUAGE_COUNT; language++)
+    {
+        ASSERT_EQ(actual->GetName(language), expected->GetName(language));
+    }
+
+    const auto& actualImages = std::as_const(*actual).GetImageTable();
+    const auto& expectedImages = std::as_const(*expected).GetImageTable();
+    ASSERT_EQ(actualImages.GetCount(), expectedImages.GetCount());
+    for (uint32_t i = 0; i < expectedImages.GetCount(); i++)
+    {
+        const auto& a = actualImages.GetImages()[i];
+        const auto& b = expectedImages.GetImages()[i];
+        ASSERT_EQ(a.width, b.width);
+        ASSERT_EQ(a.height, b.height);
+        ASSERT_EQ(a.x_offset, b.x_offset);
+        ASSERT_EQ(a.y_offset, b.y_offset);
+        ASSERT_EQ(a.flags, b.flags);
+        ASSERT_EQ(a.zoomed_offset, b.zoomed_offset);
+        if (b.offset == nullptr)
+        {
+            ASSERT_EQ(a.offset, nullptr);
+            continue;
+        }
+
+        const auto dataSize = G1CalculateDataSize(&b);
+        ASSERT_EQ(G1CalculateDataSize(&a), dataSize);
+        ASSERT_EQ(std::memcmp(a.offset, b.offset, dataSize), 0);
+    }
+}
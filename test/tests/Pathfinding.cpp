@@ -1,6 +1,8 @@
 #include "TestData.h"
+#include "openrct2/actions/BannerSetStyleAction.h"
 #include "openrct2/core/StringReader.h"
 #include "openrct2/entity/Guest.h"
+#include "openrct2/peep/FootpathGraph.h"
 #include "openrct2/peep/GuestPathfinding.h"
 #include "openrct2/ride/Station.h"
 #include "openrct2/scenario/Scenario.h"
@@ -9,10 +11,12 @@
 #include <memory>
 #include <openrct2/Context.h>
 #include <openrct2/Game.h>
+#include <openrct2/GameState.h>
 #include <openrct2/OpenRCT2.h>
 #include <openrct2/ParkImporter.h>
 #include <openrct2/core/String.hpp>
 #include <openrct2/platform/Platform.h>
+#include <openrct2/world/Banner.h>
 #include <openrct2/world/Footpath.h>
 #include <openrct2/world/Map.h>
 #include <ostream>
@@ -66,7 +70,8 @@ protected:
         return nullptr;
     }
 
-    static bool FindPath(TileCoordsXYZ* pos, const TileCoordsXYZ& goal, int expectedSteps, RideId targetRideID)
+    static bool FindPath(
+        TileCoordsXYZ* pos, const TileCoordsXYZ& goal, int expectedSteps, RideId targetRideID, bool exactSteps = true)
     {
         // Our start position is in tile coordinates, but we need to give the peep spawn
         // position in actual world coords (32 units per tile X/Y, 8 per Z level).
@@ -127,7 +132,11 @@ protected:
         // such a change in the number of steps taken on one of these paths needs to be reviewed. For the negative
         // tests, we will not have reached the goal but we still expect the loop to have run for the total number
         // of steps requested before giving up.
-        EXPECT_EQ(step, expectedSteps);
+        // Otherwise the goal only has to be reached within the expected number of steps.
+        if (exactSteps)
+            EXPECT_EQ(step, expectedSteps);
+        else
+            EXPECT_LE(step, expectedSteps);
 
         return *pos == goal;
     }
@@ -252,3 +261,135 @@ INSTANTIATE_TEST_SUITE_P(
         SimplePathfindingScenario("PathWithFences", { 11, 6, 14 }, 10000),
         SimplePathfindingScenario("PathWithCliff", { 7, 17, 14 }, 10000)),
     SimplePathfindingScenario::ToName);
+
+// The footpath graph takes the shortest route, so it has to reach the goal at least as quickly as the heuristic search.
+class FootpathGraphPathfindingTest : public PathfindingTestBase,
+                                     public ::testing::WithParamInterface<SimplePathfindingScenario>
+{
+public:
+    void SetUp() override
+    {
+        PathfindingTestBase::SetUp();
+        GetGameState().Cheats.FootpathGraphPathfinding = true;
+    }
+
+    void TearDown() override
+    {
+        GetGameState().Cheats.FootpathGraphPathfinding = false;
+    }
+};
+
+TEST_P(FootpathGraphPathfindingTest, CanFindPathFromStartToGoal)
+{
+    const SimplePathfindingScenario& scenario = GetParam();
+
+    ASSERT_PRED_FORMAT1(AssertIsStartPosition, scenario.start);
+    TileCoordsXYZ pos = scenario.start;
+
+    auto ride = FindRideByName(scenario.name);
+    ASSERT_NE(ride, nullptr);
+
+    auto entrancePos = ride->GetStation().Entrance;
+    TileCoordsXYZ goal = TileCoordsXYZ(
+        entrancePos.x - TileDirectionDelta[entrancePos.direction].x,
+        entrancePos.y - TileDirectionDelta[entrancePos.direction].y, entrancePos.z);
+
+    const auto succeeded = FindPath(&pos, goal, scenario.steps, ride->id, false) ? ::testing::AssertionSuccess()
+                                                                                 : ::testing::AssertionFailure()
+            << "Failed to find path from " << scenario.start << " to " << goal << " in " << scenario.steps << " steps; reached "
+            << pos << " before giving up.";
+
+    EXPECT_TRUE(succeeded);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    ForScenario, FootpathGraphPathfindingTest,
+    ::testing::Values(
+        SimplePathfindingScenario("StraightFlat", { 19, 15, 14 }, 24), SimplePathfindingScenario("SBend", { 15, 12, 14 }, 87),
+        SimplePathfindingScenario("UBend", { 17, 9, 14 }, 87), SimplePathfindingScenario("CBend", { 14, 5, 14 }, 164),
+        SimplePathfindingScenario("TwoEqualRoutes", { 9, 13, 14 }, 89),
+        SimplePathfindingScenario("TwoUnequalRoutes", { 3, 13, 14 }, 89),
+        SimplePathfindingScenario("StraightUpBridge", { 12, 15, 14 }, 24),
+        SimplePathfindingScenario("StraightUpSlope", { 14, 15, 14 }, 24),
+        SimplePathfindingScenario("SelfCrossingPath", { 6, 5, 14 }, 211)),
+    SimplePathfindingScenario::ToName);
+
+class FootpathGraphImpossiblePathfindingTest : public FootpathGraphPathfindingTest
+{
+};
+
+TEST_P(FootpathGraphImpossiblePathfindingTest, CannotFindPathFromStartToGoal)
+{
+    const SimplePathfindingScenario& scenario = GetParam();
+    TileCoordsXYZ pos = scenario.start;
+    ASSERT_PRED_FORMAT1(AssertIsStartPosition, scenario.start);
+
+    auto ride = FindRideByName(scenario.name);
+    ASSERT_NE(ride, nullptr);
+
+    auto entrancePos = ride->GetStation().Entrance;
+    TileCoordsXYZ goal = TileCoordsXYZ(
+        entrancePos.x + TileDirectionDelta[entrancePos.direction].x,
+        entrancePos.y + TileDirectionDelta[entrancePos.direction].y, entrancePos.z);
+
+    EXPECT_FALSE(FindPath(&pos, goal, 10000, ride->id));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    ForScenario, FootpathGraphImpossiblePathfindingTest,
+    ::testing::Values(
+        SimplePathfindingScenario("PathWithGap", { 1, 6, 14 }, 10000),
+        SimplePathfindingScenario("PathWithFences", { 11, 6, 14 }, 10000),
+        SimplePathfindingScenario("PathWithCliff", { 7, 17, 14 }, 10000)),
+    SimplePathfindingScenario::ToName);
+
+// The graph caches which edges banners block, so toggling a banner's no entry flag has to rebuild it.
+TEST_F(FootpathGraphPathfindingTest, BannerNoEntryChangesRoute)
+{
+    const TileCoordsXYZ start{ 19, 15, 14 };
+    ASSERT_PRED_FORMAT1(AssertIsStartPosition, start);
+
+    auto ride = FindRideByName("StraightFlat");
+    ASSERT_NE(ride, nullptr);
+
+    auto entrancePos = ride->GetStation().Entrance;
+    TileCoordsXYZ goal = TileCoordsXYZ(
+        entrancePos.x - TileDirectionDelta[entrancePos.direction].x,
+        entrancePos.y - TileDirectionDelta[entrancePos.direction].y, entrancePos.z);
+
+    const auto direction = PathFinding::FootpathGraphChooseDirection(start, goal, false, RideId::GetNull());
+    ASSERT_NE(direction, INVALID_DIRECTION);
+
+    // Put a banner across the edge the route leaves the start tile by.
+    auto* banner = CreateBanner();
+    ASSERT_NE(banner, nullptr);
+    banner->flags = 0;
+    banner->position = start;
+    const auto startLoc = start.ToCoordsXYZ();
+    auto* bannerElement = TileElementInsert<BannerElement>({ startLoc, startLoc.z + (2 * kCoordsZStep) }, 0b0000);
+    ASSERT_NE(bannerElement, nullptr);
+    bannerElement->SetClearanceZ(startLoc.z + kPathClearance);
+    bannerElement->SetPosition(direction);
+    bannerElement->ResetAllowedEdges();
+    bannerElement->SetIndex(banner->id);
+    const auto bannerIndex = banner->id;
+    PathFinding::InvalidateFootpathGraph();
+    EXPECT_EQ(PathFinding::FootpathGraphChooseDirection(start, goal, false, RideId::GetNull()), direction);
+
+    auto noEntryAction = BannerSetStyleAction(BannerSetStyleType::NoEntry, bannerIndex, 1);
+    ASSERT_EQ(GameActions::Execute(&noEntryAction).Error, GameActions::Status::Ok);
+    GameActions::ProcessQueue();
+    EXPECT_NE(PathFinding::FootpathGraphChooseDirection(start, goal, false, RideId::GetNull()), direction);
+
+    auto allowEntryAction = BannerSetStyleAction(BannerSetStyleType::NoEntry, bannerIndex, 0);
+    ASSERT_EQ(GameActions::Execute(&allowEntryAction).Error, GameActions::Status::Ok);
+    GameActions::ProcessQueue();
+    EXPECT_EQ(PathFinding::FootpathGraphChooseDirection(start, goal, false, RideId::GetNull()), direction);
+
+    // Clean up the banner, because we're reusing this loaded context for all tests.
+    auto* bannerTileElement = BannerGetTileElement(bannerIndex);
+    ASSERT_NE(bannerTileElement, nullptr);
+    TileElementRemove(bannerTileElement);
+    DeleteBanner(bannerIndex);
+    PathFinding::InvalidateFootpathGraph();
+}
@@ -195,3 +195,51 @@ TEST_F(PlayTests, CarRideWithOneCarOnlyAcceptsTwoGuests)
         gameStateUpdateLogic();
     }
 }
+
+TEST_F(PlayTests, RideQueueLinksMatchWalkOfQueue)
+{
+    // This test verifies that the links stations and guests keep to join, leave and skip to the front of ride queues
+    // match the queues, while a crowd of guests queues for a ride with a single car.
+    std::string initStateFile = TestData::GetParkPath("small_park_car_ride_one_car.sv6");
+
+    auto context = localStartGame(initStateFile);
+    ASSERT_NE(context.get(), nullptr);
+
+    auto& gameState = GetGameState();
+    RideRebuildQueues();
+
+    // Open park for free but charging for rides
+    execute<ParkSetParameterAction>(ParkParameter::Open);
+    execute<ParkSetEntranceFeeAction>(0);
+    gameState.Park.Flags |= PARK_FLAGS_UNLOCK_ALL_PRICES;
+
+    // Find car ride
+    auto rideManager = GetRideManager();
+    auto it = std::find_if(rideManager.begin(), rideManager.end(), [](auto& ride) { return ride.type == RIDE_TYPE_CAR_RIDE; });
+    ASSERT_NE(it, rideManager.end());
+    Ride& carRide = *it;
+
+    // Open it for free
+    execute<RideSetStatusAction>(carRide.id, RideStatus::Open);
+    execute<RideSetPriceAction>(carRide.id, 0, true);
+
+    // Ignore intensity to stimulate peeps to queue into the ride
+    gameState.Cheats.IgnoreRideIntensity = true;
+
+    for (int i = 0; i < 50; i++)
+    {
+        Park::GenerateGuest();
+    }
+
+    int32_t maxQueueLength = 0;
+    for (int i = 0; i < 5000; i++)
+    {
+        gameStateUpdateLogic();
+        for (const auto& station : carRide.GetStations())
+        {
+            ASSERT_TRUE(carRide.ValidateQueue(carRide.GetStationIndex(&station)));
+        }
+        maxQueueLength = std::max(maxQueueLength, carRide.GetTotalQueueLength());
+    }
+    ASSERT_GT(maxQueueLength, 1);
+}
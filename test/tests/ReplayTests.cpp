@@ -14,15 +14,25 @@
 #include <openrct2/Game.h>
 #include <openrct2/GameState.h>
 #include <openrct2/OpenRCT2.h>
+#include <openrct2/ParkImporter.h>
 #include <openrct2/ReplayManager.h>
+#include <openrct2/actions/CheatSetAction.h>
+#include <openrct2/actions/ParkSetEntranceFeeAction.h>
+#include <openrct2/actions/ParkSetParameterAction.h>
 #include <openrct2/audio/AudioContext.h>
 #include <openrct2/core/File.h>
 #include <openrct2/core/FileScanner.h>
+#include <openrct2/core/FileSystem.hpp>
 #include <openrct2/core/Path.hpp>
 #include <openrct2/core/String.hpp>
+#include <openrct2/entity/EntityRegistry.h>
+#include <openrct2/entity/EntityTweener.h>
+#include <openrct2/object/ObjectManager.h>
 #include <openrct2/platform/Platform.h>
 #include <openrct2/ride/Ride.h>
+#include <openrct2/world/MapAnimation.h>
 #include <string>
+#include <unordered_map>
 
 using namespace OpenRCT2;
 
@@ -97,6 +107,198 @@ TEST_P(ReplayTests, RunReplay)
     ASSERT_FALSE(replayManager->IsPlaybackStateMismatching());
 }
 
+TEST_P(ReplayTests, SeekReplay)
+{
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+
+    auto testData = GetParam();
+    auto replayFile = testData.filePath;
+
+    auto context = CreateContext();
+    bool initialised = context->Initialise();
+    ASSERT_TRUE(initialised);
+
+    IReplayManager* replayManager = context->GetReplayManager();
+    ASSERT_NE(replayManager, nullptr);
+
+    bool startedReplay = replayManager->StartPlayback(replayFile);
+    ASSERT_TRUE(startedReplay);
+
+    ReplayRecordInfo info;
+    ASSERT_TRUE(replayManager->GetCurrentReplayInfo(info));
+    const uint32_t middleTick = info.Ticks / 2;
+
+    // Seeking back has to restore the park, after which playing on must give the same state again.
+    ASSERT_TRUE(replayManager->SeekPlayback(middleTick));
+    const auto checksum = GetAllEntitiesChecksum();
+    ASSERT_TRUE(replayManager->SeekPlayback(middleTick / 2));
+    ASSERT_TRUE(replayManager->SeekPlayback(middleTick));
+    ASSERT_EQ(GetAllEntitiesChecksum().raw, checksum.raw);
+    ASSERT_FALSE(replayManager->IsPlaybackStateMismatching());
+
+    replayManager->StopPlayback();
+}
+
+static void LoadTestPark(IContext& context, const std::string& parkName)
+{
+    auto importer = ParkImporter::CreateS6(context.GetObjectRepository());
+    auto loadResult = importer->LoadSavedGame(TestData::GetParkPath(parkName).c_str(), false);
+    context.GetObjectManager().LoadObjects(loadResult.RequiredObjects);
+    importer->Import(GetGameState());
+
+    ResetEntitySpatialIndices();
+    ResetAllSpriteQuadrantPlacements();
+    LoadPalette();
+    EntityTweener::Get().Reset();
+    MapAnimationAutoCreate();
+    FixInvalidVehicleSpriteSizes();
+    gGameSpeed = 1;
+}
+
+/**
+ * Records a replay of the loaded park in which the park opens, its entrance fee changes and guests are generated at
+ * fixed ticks, plus one more guest at extraGuestTick if it is not zero. Stores the entities checksum of every tick,
+ * counted from the start of the replay.
+ */
+static void RecordTestReplay(
+    IReplayManager& replayManager, const std::string& path, uint32_t numTicks, uint32_t extraGuestTick,
+    std::unordered_map<uint32_t, EntitiesChecksum>& checksums)
+{
+    auto& gameState = GetGameState();
+    ASSERT_TRUE(replayManager.StartRecording(path));
+
+    const auto tickStart = gameState.CurrentTicks;
+    for (uint32_t tick = 1; tick <= numTicks; tick++)
+    {
+        if (tick == 10)
+        {
+            ParkSetParameterAction action(ParkParameter::Open);
+            GameActions::Execute(&action);
+        }
+        if (tick % 75 == 0)
+        {
+            ParkSetEntranceFeeAction action((tick / 75) * 10.00_GBP);
+            GameActions::Execute(&action);
+        }
+        if (tick % 40 == 0 || tick == extraGuestTick)
+        {
+            CheatSetAction action(CheatType::GenerateGuests, 1);
+            GameActions::Execute(&action);
+        }
+
+        gameStateUpdateLogic();
+        checksums[gameState.CurrentTicks - tickStart] = GetAllEntitiesChecksum();
+    }
+    ASSERT_TRUE(replayManager.StopRecording());
+}
+
+TEST(ReplayKeyframeTests, RecordSeekAndVerifyKeyframes)
+{
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+
+    auto context = CreateContext();
+    ASSERT_TRUE(context->Initialise());
+    LoadTestPark(*context, "small_park_with_ferris_wheel.sv6");
+
+    IReplayManager* replayManager = context->GetReplayManager();
+    ASSERT_NE(replayManager, nullptr);
+
+    // Record a replay with a keyframe every 100 ticks, with commands given in between keyframes so that restoring a
+    // keyframe also has to pick the right command to continue from.
+    constexpr uint32_t kKeyframeInterval = 100;
+    constexpr uint32_t kRecordTicks = 550;
+    const auto replayPath = (fs::temp_directory_path() / "openrct2_keyframe_test.parkrep").string();
+    std::unordered_map<uint32_t, EntitiesChecksum> checksums;
+    replayManager->SetKeyframeInterval(kKeyframeInterval);
+    ASSERT_NO_FATAL_FAILURE(RecordTestReplay(*replayManager, replayPath, kRecordTicks, 0, checksums));
+    replayManager->SetKeyframeInterval(4000);
+
+    ASSERT_TRUE(replayManager->StartPlayback(replayPath));
+
+    ReplayRecordInfo info;
+    ASSERT_TRUE(replayManager->GetCurrentReplayInfo(info));
+    ASSERT_EQ(info.Ticks, kRecordTicks);
+
+    const auto keyframeTicks = replayManager->GetKeyframeTicks();
+    ASSERT_GE(keyframeTicks.size(), kRecordTicks / kKeyframeInterval);
+    for (size_t i = 0; i < keyframeTicks.size(); i++)
+    {
+        ASSERT_TRUE(replayManager->VerifyKeyframe(i)) << "keyframe " << i << " at tick " << keyframeTicks[i];
+    }
+
+    // Seek back and forth across the keyframes, each time the park has to match the one that was recorded.
+    for (uint32_t tick : { 420u, 30u, 275u, 199u, 200u, 201u, 510u, 5u, 350u })
+    {
+        ASSERT_TRUE(replayManager->SeekPlayback(tick)) << "tick " << tick;
+        ASSERT_EQ(GetAllEntitiesChecksum().raw, checksums[tick].raw) << "tick " << tick;
+    }
+    ASSERT_FALSE(replayManager->IsPlaybackStateMismatching());
+
+    replayManager->StopPlayback();
+    File::Delete(replayPath);
+}
+
+TEST_P(ReplayTests, BisectIdenticalReplays)
+{
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+
+    auto testData = GetParam();
+    auto replayFile = testData.filePath;
+
+    auto context = CreateContext();
+    bool initialised = context->Initialise();
+    ASSERT_TRUE(initialised);
+
+    IReplayManager* replayManager = context->GetReplayManager();
+    ASSERT_NE(replayManager, nullptr);
+
+    ReplayBisectResult result;
+    ASSERT_TRUE(replayManager->BisectReplays(replayFile, replayFile, result));
+    ASSERT_FALSE(result.Diverged);
+    ASSERT_FALSE(replayManager->IsReplaying());
+}
+
+TEST(ReplayBisectTests, BisectDivergentReplays)
+{
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+
+    auto context = CreateContext();
+    ASSERT_TRUE(context->Initialise());
+
+    IReplayManager* replayManager = context->GetReplayManager();
+    ASSERT_NE(replayManager, nullptr);
+
+    // Record the same park twice, the second time with one more guest generated during the tick 300 of the replay.
+    constexpr uint32_t kRecordTicks = 500;
+    constexpr uint32_t kExtraGuestTick = 300;
+    const auto replayPathA = (fs::temp_directory_path() / "openrct2_bisect_test_a.parkrep").string();
+    const auto replayPathB = (fs::temp_directory_path() / "openrct2_bisect_test_b.parkrep").string();
+    std::unordered_map<uint32_t, EntitiesChecksum> checksumsA;
+    std::unordered_map<uint32_t, EntitiesChecksum> checksumsB;
+    LoadTestPark(*context, "small_park_with_ferris_wheel.sv6");
+    ASSERT_NO_FATAL_FAILURE(RecordTestReplay(*replayManager, replayPathA, kRecordTicks, 0, checksumsA));
+    LoadTestPark(*context, "small_park_with_ferris_wheel.sv6");
+    ASSERT_NO_FATAL_FAILURE(RecordTestReplay(*replayManager, replayPathB, kRecordTicks, kExtraGuestTick, checksumsB));
+
+    // The guest is generated while the tick before runs, so the parks differ from the start of that tick on.
+    ASSERT_EQ(checksumsA[kExtraGuestTick - 1].raw, checksumsB[kExtraGuestTick - 1].raw);
+    ASSERT_NE(checksumsA[kExtraGuestTick].raw, checksumsB[kExtraGuestTick].raw);
+
+    ReplayBisectResult result;
+    ASSERT_TRUE(replayManager->BisectReplays(replayPathA, replayPathB, result));
+    ASSERT_TRUE(result.Diverged);
+    ASSERT_EQ(result.Tick, kExtraGuestTick);
+    ASSERT_FALSE(result.CompareText.empty());
+    ASSERT_FALSE(replayManager->IsReplaying());
+
+    File::Delete(replayPathA);
+    File::Delete(replayPathB);
+}
+
 static void PrintTo(const ReplayTestData& testData, std::ostream* os)
 {
     *os << testData.filePath;
@@ -9,14 +9,17 @@
 
 #include "TestData.h"
 
+#include <cstring>
 #include <gtest/gtest.h>
 #include <memory>
 #include <openrct2/Context.h>
 #include <openrct2/Game.h>
 #include <openrct2/OpenRCT2.h>
 #include <openrct2/ParkImporter.h>
+#include <openrct2/profiling/Metrics.h>
 #include <openrct2/world/Footpath.h>
 #include <openrct2/world/Map.h>
+#include <openrct2/world/TileElementsView.h>
 #include <openrct2/world/tile_element/EntranceElement.h>
 
 using namespace OpenRCT2;
@@ -173,3 +176,128 @@ TEST_F(TileElementWantsFootpathConnection, MapEdge)
     // The tile in the -X direction is a normal tile and should not be marked as an edge
     EXPECT_FALSE(edges & (1 << 2));
 }
+
+class TileElementStorage : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        gOpenRCT2Headless = true;
+        gOpenRCT2NoGraphics = true;
+        _context = CreateContext();
+        ASSERT_TRUE(_context->Initialise());
+        MapInit({ 64, 64 });
+    }
+
+    void TearDown() override
+    {
+        _context.reset();
+    }
+
+private:
+    std::unique_ptr<IContext> _context;
+};
+
+static std::vector<uint8_t> GetBaseHeights(const TileCoordsXY& loc)
+{
+    std::vector<uint8_t> result;
+    for (const auto* element : TileElementsView(loc))
+    {
+        result.push_back(element->BaseHeight);
+    }
+    return result;
+}
+
+TEST_F(TileElementStorage, InsertKeepsHeightOrder)
+{
+    const TileCoordsXY loc{ 5, 5 };
+    TileElementInsert({ loc.ToCoordsXY(), 200 }, 0b1111, TileElementType::SmallScenery);
+    const auto statsBefore = GetTileElementStats();
+
+    // The tile is now at the end of the array, so these grow it in place
+    TileElementInsert({ loc.ToCoordsXY(), 120 }, 0b1111, TileElementType::SmallScenery);
+    TileElementInsert({ loc.ToCoordsXY(), 160 }, 0b1111, TileElementType::SmallScenery);
+    TileElementInsert({ loc.ToCoordsXY(), 240 }, 0b1111, TileElementType::SmallScenery);
+    const auto statsAfter = GetTileElementStats();
+    EXPECT_EQ(statsAfter.Allocated, statsBefore.Allocated + 3);
+    EXPECT_EQ(statsAfter.InUse, statsBefore.InUse + 3);
+
+    EXPECT_EQ(GetBaseHeights(loc), (std::vector<uint8_t>{ 14, 15, 20, 25, 30 }));
+
+    size_t numLast = 0;
+    for (const auto* element : TileElementsView(loc))
+    {
+        numLast += element->IsLastForTile() ? 1 : 0;
+    }
+    EXPECT_EQ(numLast, 1u);
+}
+
+TEST_F(TileElementStorage, IncrementalCompactionKeepsTiles)
+{
+    // Moving every tile to the end of the array leaves a gap behind for each of them
+    for (int32_t y = 0; y < 600; y++)
+    {
+        for (int32_t x = 0; x < 600; x++)
+        {
+            TileElementInsert({ TileCoordsXY(x, y).ToCoordsXY(), 200 }, 0b1111, TileElementType::SmallScenery);
+        }
+    }
+
+    const auto expected = GetReorganisedTileElementsWithoutGhosts();
+    const auto statsBefore = GetTileElementStats();
+    ASSERT_GT(statsBefore.Allocated, statsBefore.InUse);
+
+    MapUpdateTileElementCompaction();
+    EXPECT_GT(GetTileElementStats().CompactionProgress, 0.0);
+
+    for (int32_t i = 0; i < 1000 && GetTileElementStats().CompactionProgress != 0.0; i++)
+    {
+        MapUpdateTileElementCompaction();
+    }
+
+    const auto statsAfter = GetTileElementStats();
+    EXPECT_EQ(statsAfter.CompactionProgress, 0.0);
+    EXPECT_EQ(statsAfter.Allocated, statsAfter.InUse);
+    EXPECT_EQ(statsAfter.InUse, statsBefore.InUse);
+
+    const auto actual = GetReorganisedTileElementsWithoutGhosts();
+    ASSERT_EQ(actual.size(), expected.size());
+    EXPECT_EQ(std::memcmp(actual.data(), expected.data(), actual.size() * sizeof(TileElement)), 0);
+    EXPECT_EQ(GetBaseHeights({ 5, 5 }), (std::vector<uint8_t>{ 14, 25 }));
+}
+
+TEST_F(TileElementStorage, InsertDuringCompactionDoesNotReorganise)
+{
+    for (int32_t y = 0; y < 600; y++)
+    {
+        for (int32_t x = 0; x < 600; x++)
+        {
+            TileElementInsert({ TileCoordsXY(x, y).ToCoordsXY(), 200 }, 0b1111, TileElementType::SmallScenery);
+        }
+    }
+
+    MapUpdateTileElementCompaction();
+    const auto progressBefore = GetTileElementStats().CompactionProgress;
+    ASSERT_GT(progressBefore, 0.0);
+
+    auto& reorganisations = Metrics::GetCounter("map.tile_elements.reorganisations");
+    const auto reorganisationsBefore = reorganisations.GetValue();
+
+    // Moving tiles that have not been compacted yet fills up the old array, until the compaction has to move past them
+    TileCoordsXY lastLoc{};
+    for (int32_t y = 500; y < kMaximumMapSizeTechnical && GetTileElementStats().CompactionProgress == progressBefore; y++)
+    {
+        for (int32_t x = 0; x < kMaximumMapSizeTechnical; x++)
+        {
+            lastLoc = { x, y };
+            TileElementInsert({ lastLoc.ToCoordsXY(), 200 }, 0b1111, TileElementType::SmallScenery);
+            if (GetTileElementStats().CompactionProgress != progressBefore)
+                break;
+        }
+    }
+
+    EXPECT_GT(GetTileElementStats().CompactionProgress, progressBefore);
+    EXPECT_EQ(reorganisations.GetValue(), reorganisationsBefore);
+    EXPECT_EQ(GetBaseHeights(lastLoc), (std::vector<uint8_t>{ 14, 25 }));
+    EXPECT_EQ(GetBaseHeights({ 5, 5 }), (std::vector<uint8_t>{ 14, 25 }));
+}